@@ -0,0 +1,41 @@
+/*
+===============================================================================
+
+  FILE:  entropydecoder.hpp
+
+  CONTENTS:
+
+    The (empty) base class of the old range decoder (see entropymodel.hpp)
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- created for building the range coder into laszip_coder_bench
+
+===============================================================================
+*/
+#ifndef ENTROPY_DECODER_HPP
+#define ENTROPY_DECODER_HPP
+
+#include "entropymodel.hpp"
+#include "bytestreamin.hpp"
+
+class EntropyDecoder
+{
+};
+
+#endif
@@ -0,0 +1,45 @@
+/*
+===============================================================================
+
+  FILE:  entropymodel.hpp
+
+  CONTENTS:
+
+    The few declarations that the old range coder in the 'unused' folder still
+    expects from the entropy coder framework it was once written for. Only the
+    coder benchmark compiles the range coder, so they live here and not in src
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- created for building the range coder into laszip_coder_bench
+
+===============================================================================
+*/
+#ifndef ENTROPY_MODEL_HPP
+#define ENTROPY_MODEL_HPP
+
+#include "mydefs.hpp"
+
+// the range coder only ever hands out pointers to its RangeModel as this type
+
+class EntropyModel;
+
+typedef union U32F32 { U32 u32; F32 f32; } U32F32;
+typedef union U64F64 { U64 u64; F64 f64; } U64F64;
+
+#endif
@@ -0,0 +1,666 @@
+/*
+===============================================================================
+
+  FILE:  laszip_coder_bench.cpp
+
+  CONTENTS:
+
+    Microbenchmark for the entropy coders of LASzip. It runs fixed synthetic
+    symbol distributions and residual traces of real LAS files through the
+    arithmetic coder, its two-pass variant, and the old range coder
+    from the 'unused' folder, checks that every stream decodes to what was
+    encoded, and reports for each combination
+
+      bits/sym   compressed bits per symbol (for static models incl. tables)
+      Msym/s     million symbols encoded resp. decoded per second
+      MB/s       megabytes of raw input per second, where a raw symbol takes
+                 as many bits as its alphabet needs without entropy coding
+
+    The two-pass variant encodes twice (the first pass only counts) and then
+    starts each model from the counted distribution, or leaves it adaptive
+    where that is cheaper, so it only gains in bits/sym. The integer
+    inputs go through the IntegerCompressor and the IntegerCompressorFixed,
+    which only exist for the arithmetic coder.
+
+    Residual traces come from uncompressed LAS files given on the command
+    line (decompress LAZ files with laszip first). From the X, Y, Z, and the
+    intensity of consecutive points it takes the integer residuals and the
+    stream of their bit lengths, which is what the 'k' models of the
+    IntegerCompressor see.
+
+    usage:
+
+      laszip_coder_bench [-n symbols] [-r runs] [file.las ...]
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- the static variant is now the size-only two-pass coder
+    16 October 2026 -- without the rANS coder that LASzip no longer has
+    16 October 2026 -- created to compare the coders with the old range coder
+
+===============================================================================
+*/
+
+#include "laszip.hpp"
+#include "arithmeticencoder.hpp"
+#include "arithmeticdecoder.hpp"
+#include "integercompressor.hpp"
+#include "bytestreamout_array.hpp"
+#include "bytestreamin_array.hpp"
+
+#include "rangeencoder.hpp"
+#include "rangedecoder.hpp"
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// what kind of values an input has
+
+#define BENCH_BITS      0 // bits with one bit model
+#define BENCH_SYMBOLS   1 // symbols with one symbol model
+#define BENCH_RAW       2 // raw bits without modelling
+#define BENCH_INTEGERS  3 // integers with an IntegerCompressor
+
+// the old range coder follows the LASZIP_CODER_* numbers
+
+#define BENCH_CODER_RANGE             LASZIP_CODER_TOTAL_NUMBER_OF
+#define BENCH_CODER_TOTAL_NUMBER_OF   (LASZIP_CODER_TOTAL_NUMBER_OF + 1)
+
+static const char* coder_names[BENCH_CODER_TOTAL_NUMBER_OF] = { "arithmetic", "arithmetic two-pass", "range (unused)" };
+
+struct BenchInput
+{
+  char name[64];
+  U32 kind;
+  U32 symbols;   // size of the alphabet, number of raw bits, or of integer bits
+  BOOL fixed;    // integers with IntegerCompressorFixed
+  U32 raw_bits;  // bits per value without entropy coding
+  U32 number;
+  U32* values;
+  I32* preds;    // predictions for the integers
+};
+
+// fixed seed so that every run codes the same symbols
+
+static U64 bench_random_state = 0x9E3779B97F4A7C15ULL;
+
+static inline U32 bench_random()
+{
+  bench_random_state ^= bench_random_state >> 12;
+  bench_random_state ^= bench_random_state << 25;
+  bench_random_state ^= bench_random_state >> 27;
+  return (U32)((bench_random_state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static inline F64 bench_uniform()
+{
+  return (bench_random() + 0.5) / 4294967296.0;
+}
+
+static U32 bench_bits_needed(U32 n)
+{
+  U32 bits = 0;
+  while (n > 1)
+  {
+    bits++;
+    n = (n + 1) >> 1;
+  }
+  return bits;
+}
+
+static BenchInput* bench_input(const char* name, U32 kind, U32 symbols, U32 number)
+{
+  BenchInput* input = new BenchInput;
+  snprintf(input->name, sizeof(input->name), "%s", name);
+  input->kind = kind;
+  input->symbols = symbols;
+  input->fixed = FALSE;
+  input->raw_bits = (kind == BENCH_BITS ? 1 : ((kind == BENCH_SYMBOLS) ? bench_bits_needed(symbols) : symbols));
+  input->number = number;
+  input->values = new U32[number];
+  input->preds = (kind == BENCH_INTEGERS ? new I32[number] : 0);
+  return input;
+}
+
+static void bench_delete(BenchInput* input)
+{
+  delete [] input->values;
+  if (input->preds) delete [] input->preds;
+  delete input;
+}
+
+// samples symbols from a table of probabilities by inverting its distribution
+
+static void bench_sample(BenchInput* input, const F64* probabilities)
+{
+  U32 i, s;
+  F64* cdf = new F64[input->symbols];
+  F64 sum = 0.0;
+  for (s = 0; s < input->symbols; s++) sum += probabilities[s];
+  F64 acc = 0.0;
+  for (s = 0; s < input->symbols; s++)
+  {
+    acc += probabilities[s] / sum;
+    cdf[s] = acc;
+  }
+  for (i = 0; i < input->number; i++)
+  {
+    F64 u = bench_uniform();
+    U32 lo = 0, hi = input->symbols - 1;
+    while (lo < hi)
+    {
+      U32 mid = (lo + hi) / 2;
+      if (u <= cdf[mid]) hi = mid; else lo = mid + 1;
+    }
+    input->values[i] = lo;
+  }
+  delete [] cdf;
+}
+
+static U32 bench_synthetic(BenchInput** inputs, const U32 number)
+{
+  U32 num_inputs = 0;
+  U32 i, s;
+  F64 probabilities[2048];
+  char name[64];
+
+  // bits that are zero with a probability of 0.5, 0.9, and 0.99
+
+  static const F64 zeros[3] = { 0.5, 0.9, 0.99 };
+  for (i = 0; i < 3; i++)
+  {
+    snprintf(name, sizeof(name), "bits p0=%.2f", zeros[i]);
+    BenchInput* input = bench_input(name, BENCH_BITS, 2, number);
+    probabilities[0] = zeros[i];
+    probabilities[1] = 1.0 - zeros[i];
+    bench_sample(input, probabilities);
+    inputs[num_inputs++] = input;
+  }
+
+  // a skewed alphabet of 4 symbols like the classification of ground points
+
+  BenchInput* input = bench_input("skewed 4", BENCH_SYMBOLS, 4, number);
+  probabilities[0] = 0.70; probabilities[1] = 0.20; probabilities[2] = 0.07; probabilities[3] = 0.03;
+  bench_sample(input, probabilities);
+  inputs[num_inputs++] = input;
+
+  // bytes without any redundancy
+
+  input = bench_input("uniform 256", BENCH_SYMBOLS, 256, number);
+  for (s = 0; s < 256; s++) probabilities[s] = 1.0;
+  bench_sample(input, probabilities);
+  inputs[num_inputs++] = input;
+
+  // bytes that are geometric like the low bits of small residuals
+
+  input = bench_input("geometric 256", BENCH_SYMBOLS, 256, number);
+  for (s = 0; s < 256; s++) probabilities[s] = pow(0.85, (F64)s);
+  bench_sample(input, probabilities);
+  inputs[num_inputs++] = input;
+
+  // the largest alphabet a model supports with a zipf distribution
+
+  input = bench_input("zipf 2048", BENCH_SYMBOLS, 2048, number);
+  for (s = 0; s < 2048; s++) probabilities[s] = 1.0 / pow((F64)(s + 1), 1.1);
+  bench_sample(input, probabilities);
+  inputs[num_inputs++] = input;
+
+  // raw bits like the ones the IntegerCompressor writes for large correctors
+
+  input = bench_input("raw 13 bits", BENCH_RAW, 13, number);
+  for (i = 0; i < number; i++) input->values[i] = bench_random() & 0x1FFF;
+  inputs[num_inputs++] = input;
+
+  // a random walk with laplacian steps through the IntegerCompressor
+
+  for (i = 0; i < 2; i++)
+  {
+    input = bench_input((i ? "walk ic32 fixed" : "walk ic32"), BENCH_INTEGERS, 32, number);
+    input->fixed = i;
+    bench_random_state = 0x9E3779B97F4A7C15ULL;
+    I32 value = 0;
+    for (U32 j = 0; j < number; j++)
+    {
+      F64 u = bench_uniform() - 0.5;
+      I32 step = (I32)floor(-64.0 * log(1.0 - 2.0 * fabs(u)));
+      input->preds[j] = value;
+      value += (u < 0.0 ? -step : step);
+      input->values[j] = (U32)value;
+    }
+    inputs[num_inputs++] = input;
+  }
+
+  return num_inputs;
+}
+
+// residuals of the X, Y, Z, and intensity of consecutive points of a LAS file
+
+static U32 bench_trace(BenchInput** inputs, const char* file_name, const U32 number)
+{
+  FILE* file = fopen(file_name, "rb");
+  if (file == 0)
+  {
+    fprintf(stderr, "ERROR: cannot open '%s'\n", file_name);
+    return 0;
+  }
+
+  U8 header[375];
+  memset(header, 0, sizeof(header));
+  size_t header_size = fread(header, 1, sizeof(header), file);
+  if ((header_size < 227) || (strncmp((const char*)header, "LASF", 4) != 0))
+  {
+    fprintf(stderr, "ERROR: '%s' is not a LAS file\n", file_name);
+    fclose(file);
+    return 0;
+  }
+
+  U32 offset_to_point_data;
+  U8 point_data_format;
+  U16 point_data_record_length;
+  U32 legacy_number_of_point_records;
+  U64 number_of_point_records = 0;
+  memcpy(&offset_to_point_data, header + 96, 4);
+  point_data_format = header[104];
+  memcpy(&point_data_record_length, header + 105, 2);
+  memcpy(&legacy_number_of_point_records, header + 107, 4);
+  if ((header[25] >= 4) && (header_size >= 255))
+  {
+    memcpy(&number_of_point_records, header + 247, 8);
+  }
+  if (number_of_point_records == 0)
+  {
+    number_of_point_records = legacy_number_of_point_records;
+  }
+  if (point_data_format & 0xC0)
+  {
+    fprintf(stderr, "ERROR: '%s' is compressed. decompress it with laszip first\n", file_name);
+    fclose(file);
+    return 0;
+  }
+  if (point_data_record_length < 14)
+  {
+    fprintf(stderr, "ERROR: '%s' has a point record length of only %u\n", file_name, (U32)point_data_record_length);
+    fclose(file);
+    return 0;
+  }
+
+  U32 num_points = (number_of_point_records < number ? (U32)number_of_point_records : number);
+  U8* points = new U8[(size_t)num_points*point_data_record_length];
+  fseek(file, offset_to_point_data, SEEK_SET);
+  num_points = (U32)(fread(points, point_data_record_length, num_points, file));
+  fclose(file);
+  if (num_points < 2)
+  {
+    fprintf(stderr, "ERROR: '%s' has too few points\n", file_name);
+    delete [] points;
+    return 0;
+  }
+
+  const char* base_name = file_name + strlen(file_name);
+  while ((base_name > file_name) && (base_name[-1] != '/') && (base_name[-1] != '\\')) base_name--;
+
+  static const char* field_names[4] = { "x", "y", "z", "intensity" };
+  static const U32 field_offsets[4] = { 0, 4, 8, 12 };
+  static const U32 field_bits[4] = { 32, 32, 32, 16 };
+
+  U32 num_inputs = 0;
+  U32 f, i;
+  char name[64];
+  for (f = 0; f < 4; f++)
+  {
+    // the values and the prediction from the previous point
+
+    I32* values = new I32[num_points];
+    for (i = 0; i < num_points; i++)
+    {
+      const U8* field = points + (size_t)i*point_data_record_length + field_offsets[f];
+      if (field_bits[f] == 32)
+      {
+        memcpy(&values[i], field, 4);
+      }
+      else
+      {
+        U16 value;
+        memcpy(&value, field, 2);
+        values[i] = value;
+      }
+    }
+
+    for (U32 fixed = 0; fixed < 2; fixed++)
+    {
+      snprintf(name, sizeof(name), "%.20s %s ic%u%s", base_name, field_names[f], field_bits[f], (fixed ? " fixed" : ""));
+      BenchInput* input = bench_input(name, BENCH_INTEGERS, field_bits[f], num_points - 1);
+      input->fixed = fixed;
+      for (i = 1; i < num_points; i++)
+      {
+        input->preds[i-1] = values[i-1];
+        input->values[i-1] = (U32)values[i];
+      }
+      inputs[num_inputs++] = input;
+    }
+
+    // the bit lengths of the residuals
+
+    snprintf(name, sizeof(name), "%.20s %s k", base_name, field_names[f]);
+    BenchInput* input = bench_input(name, BENCH_SYMBOLS, 33, num_points - 1);
+    for (i = 1; i < num_points; i++)
+    {
+      I64 residual = (I64)values[i] - (I64)values[i-1];
+      U64 magnitude = (U64)(residual < 0 ? -residual : residual);
+      U32 k = 0;
+      while (magnitude && (k < 32))
+      {
+        k++;
+        magnitude >>= 1;
+      }
+      input->values[i-1] = k;
+    }
+    inputs[num_inputs++] = input;
+
+    delete [] values;
+  }
+
+  delete [] points;
+  return num_inputs;
+}
+
+// encodes and decodes with the models that a coder creates for its own type
+
+template <class Encoder, class BitModel, class SymbolModel>
+static void encode_symbols(Encoder* enc, ByteStreamOutArray* outstream, const BenchInput* input, BOOL two_passes)
+{
+  U32 i, pass;
+  BitModel* bit_model = (input->kind == BENCH_BITS ? enc->createBitModel() : 0);
+  SymbolModel* symbol_model = (input->kind == BENCH_SYMBOLS ? enc->createSymbolModel(input->symbols) : 0);
+
+  // static models need a first pass that only counts (and gets overwritten)
+
+  for (pass = (two_passes ? 0 : 1); pass < 2; pass++)
+  {
+    outstream->seek(0);
+    enc->init(outstream);
+    switch (input->kind)
+    {
+    case BENCH_BITS:
+      enc->initBitModel(bit_model);
+      for (i = 0; i < input->number; i++) enc->encodeBit(bit_model, input->values[i]);
+      break;
+    case BENCH_SYMBOLS:
+      enc->initSymbolModel(symbol_model);
+      for (i = 0; i < input->number; i++) enc->encodeSymbol(symbol_model, input->values[i]);
+      break;
+    case BENCH_RAW:
+      for (i = 0; i < input->number; i++) enc->writeBits(input->symbols, input->values[i]);
+      break;
+    }
+    enc->done();
+  }
+
+  if (bit_model) enc->destroyBitModel(bit_model);
+  if (symbol_model) enc->destroySymbolModel(symbol_model);
+}
+
+template <class Decoder, class BitModel, class SymbolModel>
+static void decode_symbols(Decoder* dec, ByteStreamInArray* instream, const BenchInput* input, U32* values)
+{
+  U32 i;
+  BitModel* bit_model = (input->kind == BENCH_BITS ? dec->createBitModel() : 0);
+  SymbolModel* symbol_model = (input->kind == BENCH_SYMBOLS ? dec->createSymbolModel(input->symbols) : 0);
+
+  dec->init(instream);
+  switch (input->kind)
+  {
+  case BENCH_BITS:
+    dec->initBitModel(bit_model);
+    for (i = 0; i < input->number; i++) values[i] = dec->decodeBit(bit_model);
+    break;
+  case BENCH_SYMBOLS:
+    dec->initSymbolModel(symbol_model);
+    for (i = 0; i < input->number; i++) values[i] = dec->decodeSymbol(symbol_model);
+    break;
+  case BENCH_RAW:
+    for (i = 0; i < input->number; i++) values[i] = dec->readBits(input->symbols);
+    break;
+  }
+  dec->done();
+
+  if (bit_model) dec->destroyBitModel(bit_model);
+  if (symbol_model) dec->destroySymbolModel(symbol_model);
+}
+
+template <class Compressor>
+static void encode_integers(ArithmeticEncoder* enc, ByteStreamOutArray* outstream, const BenchInput* input, Compressor* ic)
+{
+  U32 i, pass;
+  for (pass = (enc->hasStaticModels() ? 0 : 1); pass < 2; pass++)
+  {
+    outstream->seek(0);
+    enc->init(outstream);
+    ic->initCompressor();
+    for (i = 0; i < input->number; i++) ic->compress(input->preds[i], (I32)input->values[i]);
+    enc->done();
+  }
+}
+
+template <class Compressor>
+static void decode_integers(ArithmeticDecoder* dec, ByteStreamInArray* instream, const BenchInput* input, Compressor* ic, U32* values)
+{
+  U32 i;
+  dec->init(instream);
+  ic->initDecompressor();
+  for (i = 0; i < input->number; i++) values[i] = (U32)ic->decompress(input->preds[i]);
+  dec->done();
+}
+
+static void encode_input(U32 coder, ByteStreamOutArray* outstream, const BenchInput* input)
+{
+  if (coder == BENCH_CODER_RANGE)
+  {
+    RangeEncoder enc;
+    encode_symbols<RangeEncoder, EntropyModel, EntropyModel>(&enc, outstream, input, FALSE);
+    return;
+  }
+  ArithmeticEncoder enc((U16)coder);
+  if (input->kind != BENCH_INTEGERS)
+  {
+    encode_symbols<ArithmeticEncoder, ArithmeticBitModel, ArithmeticModel>(&enc, outstream, input, enc.hasStaticModels());
+  }
+  else if (!input->fixed)
+  {
+    IntegerCompressor ic(&enc, input->symbols);
+    encode_integers(&enc, outstream, input, &ic);
+  }
+  else if (input->symbols == 16)
+  {
+    IntegerCompressorFixed<16> ic(&enc);
+    encode_integers(&enc, outstream, input, &ic);
+  }
+  else
+  {
+    IntegerCompressorFixed<32> ic(&enc);
+    encode_integers(&enc, outstream, input, &ic);
+  }
+}
+
+static void decode_input(U32 coder, ByteStreamInArray* instream, const BenchInput* input, U32* values)
+{
+  if (coder == BENCH_CODER_RANGE)
+  {
+    RangeDecoder dec;
+    decode_symbols<RangeDecoder, EntropyModel, EntropyModel>(&dec, instream, input, values);
+    return;
+  }
+  ArithmeticDecoder dec((U16)coder);
+  if (input->kind != BENCH_INTEGERS)
+  {
+    decode_symbols<ArithmeticDecoder, ArithmeticBitModel, ArithmeticModel>(&dec, instream, input, values);
+  }
+  else if (!input->fixed)
+  {
+    IntegerCompressor ic(&dec, input->symbols);
+    decode_integers(&dec, instream, input, &ic, values);
+  }
+  else if (input->symbols == 16)
+  {
+    IntegerCompressorFixed<16> ic(&dec);
+    decode_integers(&dec, instream, input, &ic, values);
+  }
+  else
+  {
+    IntegerCompressorFixed<32> ic(&dec);
+    decode_integers(&dec, instream, input, &ic, values);
+  }
+}
+
+static inline F64 bench_seconds()
+{
+  return std::chrono::duration<F64>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// runs one input through one coder and reports the best of several runs
+
+static BOOL bench_run(U32 coder, const BenchInput* input, const U32 runs)
+{
+  ByteStreamOutArrayLE* outstream = new ByteStreamOutArrayLE((I64)input->number*5 + 65536);
+  U32* values = new U32[input->number];
+  F64 encode_seconds = 1e30;
+  F64 decode_seconds = 1e30;
+  BOOL ok = TRUE;
+  U32 run;
+
+  for (run = 0; run < runs; run++)
+  {
+    F64 start = bench_seconds();
+    encode_input(coder, outstream, input);
+    F64 seconds = bench_seconds() - start;
+    if (seconds < encode_seconds) encode_seconds = seconds;
+  }
+
+  // decoders may look a few bytes past the end of the stream
+
+  I64 num_bytes = outstream->getCurr();
+  outstream->putBytes((const U8*)"\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0", 16);
+  ByteStreamInArrayLE* instream = new ByteStreamInArrayLE(outstream->getData(), outstream->getCurr());
+
+  for (run = 0; run < runs; run++)
+  {
+    memset(values, 0, sizeof(U32)*input->number);
+    instream->seek(0);
+    F64 start = bench_seconds();
+    decode_input(coder, instream, input, values);
+    F64 seconds = bench_seconds() - start;
+    if (seconds < decode_seconds) decode_seconds = seconds;
+    if (memcmp(values, input->values, sizeof(U32)*input->number) != 0)
+    {
+      ok = FALSE;
+    }
+  }
+
+  F64 symbols = (F64)input->number;
+  F64 raw_bytes = symbols * input->raw_bits / 8.0;
+  fprintf(stdout, "%-34s %-18s %8.3f %10.1f %10.1f %10.1f %10.1f%s\n", input->name, coder_names[coder],
+    8.0 * num_bytes / symbols,
+    symbols / encode_seconds / 1e6, symbols / decode_seconds / 1e6,
+    raw_bytes / encode_seconds / 1e6, raw_bytes / decode_seconds / 1e6,
+    (ok ? "" : "  FAILED"));
+  fflush(stdout);
+
+  delete instream;
+  delete outstream;
+  delete [] values;
+  return ok;
+}
+
+static void usage()
+{
+  fprintf(stderr, "usage:\n");
+  fprintf(stderr, "laszip_coder_bench\n");
+  fprintf(stderr, "laszip_coder_bench -n 1000000 -r 5\n");
+  fprintf(stderr, "laszip_coder_bench -n 200000 lidar1.las lidar2.las\n");
+  fprintf(stderr, "  -n  number of symbols per input (default 1000000)\n");
+  fprintf(stderr, "  -r  runs of which the fastest is reported (default 5)\n");
+  fprintf(stderr, "  LAS files add traces of their residuals (decompress LAZ files first)\n");
+}
+
+int main(int argc, char* argv[])
+{
+  U32 number = 1000000;
+  U32 runs = 5;
+  U32 num_files = 0;
+  const char** file_names = new const char*[argc];
+  int i;
+
+  for (i = 1; i < argc; i++)
+  {
+    if ((strcmp(argv[i], "-n") == 0) && ((i+1) < argc))
+    {
+      number = (U32)atoi(argv[++i]);
+    }
+    else if ((strcmp(argv[i], "-r") == 0) && ((i+1) < argc))
+    {
+      runs = (U32)atoi(argv[++i]);
+    }
+    else if (argv[i][0] == '-')
+    {
+      usage();
+      delete [] file_names;
+      return 1;
+    }
+    else
+    {
+      file_names[num_files++] = argv[i];
+    }
+  }
+  if (number < 1) number = 1;
+  if (runs < 1) runs = 1;
+
+  BenchInput** inputs = new BenchInput*[16 + 12*num_files];
+  U32 num_inputs = bench_synthetic(inputs, number);
+  for (U32 f = 0; f < num_files; f++)
+  {
+    num_inputs += bench_trace(inputs + num_inputs, file_names[f], number);
+  }
+
+  fprintf(stdout, "%u symbols per synthetic input, fastest of %u runs\n\n", number, runs);
+  fprintf(stdout, "%-34s %-18s %8s %10s %10s %10s %10s\n", "input", "coder", "bits/sym", "enc Msym/s", "dec Msym/s", "enc MB/s", "dec MB/s");
+
+  BOOL ok = TRUE;
+  for (U32 n = 0; n < num_inputs; n++)
+  {
+    for (U32 coder = 0; coder < BENCH_CODER_TOTAL_NUMBER_OF; coder++)
+    {
+      // the IntegerCompressor needs an ArithmeticEncoder or ArithmeticDecoder
+      if ((coder == BENCH_CODER_RANGE) && (inputs[n]->kind == BENCH_INTEGERS)) continue;
+      if (!bench_run(coder, inputs[n], runs)) ok = FALSE;
+    }
+    bench_delete(inputs[n]);
+  }
+
+  delete [] inputs;
+  delete [] file_names;
+
+  if (!ok)
+  {
+    fprintf(stderr, "ERROR: some inputs did not decode to what was encoded\n");
+    return 1;
+  }
+  return 0;
+}
@@ -719,6 +719,69 @@ laszip_set_chunk_size
   return 1;
 };
 
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_set_coder_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_U16                 coder
+);
+laszip_set_coder_def laszip_set_coder_ptr = 0;
+LASZIP_API laszip_I32
+laszip_set_coder
+(
+    laszip_POINTER                     pointer
+    , const laszip_U16                 coder
+)
+{
+  if (laszip_set_coder_ptr)
+  {
+    return (*laszip_set_coder_ptr)(pointer, coder);
+  }
+  return 1;
+};
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_request_bitpacked_compression_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_BOOL                request
+);
+laszip_request_bitpacked_compression_def laszip_request_bitpacked_compression_ptr = 0;
+LASZIP_API laszip_I32
+laszip_request_bitpacked_compression
+(
+    laszip_POINTER                     pointer
+    , const laszip_BOOL                request
+)
+{
+  if (laszip_request_bitpacked_compression_ptr)
+  {
+    return (*laszip_request_bitpacked_compression_ptr)(pointer, request);
+  }
+  return 1;
+};
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_request_attribute_compression_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_BOOL                request
+);
+laszip_request_attribute_compression_def laszip_request_attribute_compression_ptr = 0;
+LASZIP_API laszip_I32
+laszip_request_attribute_compression
+(
+    laszip_POINTER                     pointer
+    , const laszip_BOOL                request
+)
+{
+  if (laszip_request_attribute_compression_ptr)
+  {
+    return (*laszip_request_attribute_compression_ptr)(pointer, request);
+  }
+  return 1;
+};
+
 /*---------------------------------------------------------------------------*/
 typedef laszip_I32 (*laszip_open_writer_def)
 (
@@ -860,6 +923,149 @@ laszip_decompress_selective
   return 1;
 };
 
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_decompress_selective_attribute_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_I32                 index
+);
+laszip_decompress_selective_attribute_def laszip_decompress_selective_attribute_ptr = 0;
+LASZIP_API laszip_I32
+laszip_decompress_selective_attribute
+(
+    laszip_POINTER                     pointer
+    , const laszip_I32                 index
+)
+{
+  if (laszip_decompress_selective_attribute_ptr)
+  {
+    return (*laszip_decompress_selective_attribute_ptr)(pointer, index);
+  }
+  return 1;
+};
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_decompress_selective_attribute_by_name_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_CHAR*               name
+);
+laszip_decompress_selective_attribute_by_name_def laszip_decompress_selective_attribute_by_name_ptr = 0;
+LASZIP_API laszip_I32
+laszip_decompress_selective_attribute_by_name
+(
+    laszip_POINTER                     pointer
+    , const laszip_CHAR*               name
+)
+{
+  if (laszip_decompress_selective_attribute_by_name_ptr)
+  {
+    return (*laszip_decompress_selective_attribute_by_name_ptr)(pointer, name);
+  }
+  return 1;
+};
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_set_number_of_threads_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 number_of_threads
+);
+laszip_set_number_of_threads_def laszip_set_number_of_threads_ptr = 0;
+LASZIP_API laszip_I32
+laszip_set_number_of_threads
+(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 number_of_threads
+)
+{
+  if (laszip_set_number_of_threads_ptr)
+  {
+    return (*laszip_set_number_of_threads_ptr)(pointer, number_of_threads);
+  }
+  return 1;
+};
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_decompress_layers_in_parallel_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_BOOL                in_parallel
+);
+laszip_decompress_layers_in_parallel_def laszip_decompress_layers_in_parallel_ptr = 0;
+LASZIP_API laszip_I32
+laszip_decompress_layers_in_parallel(
+    laszip_POINTER                     pointer
+    , const laszip_BOOL                in_parallel
+)
+{
+  if (laszip_decompress_layers_in_parallel_ptr)
+  {
+    return (*laszip_decompress_layers_in_parallel_ptr)(pointer, in_parallel);
+  }
+  return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_request_memory_mapping_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_BOOL                request
+);
+laszip_request_memory_mapping_def laszip_request_memory_mapping_ptr = 0;
+LASZIP_API laszip_I32
+laszip_request_memory_mapping(
+    laszip_POINTER                     pointer
+    , const laszip_BOOL                request
+)
+{
+  if (laszip_request_memory_mapping_ptr)
+  {
+    return (*laszip_request_memory_mapping_ptr)(pointer, request);
+  }
+  return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_set_seek_checkpoints_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 interval
+);
+laszip_set_seek_checkpoints_def laszip_set_seek_checkpoints_ptr = 0;
+LASZIP_API laszip_I32
+laszip_set_seek_checkpoints(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 interval
+)
+{
+  if (laszip_set_seek_checkpoints_ptr)
+  {
+    return (*laszip_set_seek_checkpoints_ptr)(pointer, interval);
+  }
+  return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_set_chunk_cache_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_U64                 max_bytes
+);
+laszip_set_chunk_cache_def laszip_set_chunk_cache_ptr = 0;
+LASZIP_API laszip_I32
+laszip_set_chunk_cache(
+    laszip_POINTER                     pointer
+    , const laszip_U64                 max_bytes
+)
+{
+  if (laszip_set_chunk_cache_ptr)
+  {
+    return (*laszip_set_chunk_cache_ptr)(pointer, max_bytes);
+  }
+  return 1;
+}
+
 /*---------------------------------------------------------------------------*/
 typedef laszip_I32 (*laszip_open_reader_def)
 (
@@ -973,6 +1179,195 @@ laszip_read_point(
   return 1;
 }
 
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_decompress_selective_on_demand_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 decompress_selective
+);
+laszip_decompress_selective_on_demand_def laszip_decompress_selective_on_demand_ptr = 0;
+LASZIP_API laszip_I32
+laszip_decompress_selective_on_demand
+(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 decompress_selective
+)
+{
+  if (laszip_decompress_selective_on_demand_ptr)
+  {
+    return (*laszip_decompress_selective_on_demand_ptr)(pointer, decompress_selective);
+  }
+  return 1;
+};
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_read_points_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 count
+    , laszip_point_struct*             points
+    , laszip_U32*                      read
+);
+laszip_read_points_def laszip_read_points_ptr = 0;
+LASZIP_API laszip_I32
+laszip_read_points(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 count
+    , laszip_point_struct*             points
+    , laszip_U32*                      read
+)
+{
+  if (laszip_read_points_ptr)
+  {
+    return (*laszip_read_points_ptr)(pointer, count, points, read);
+  }
+  return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_read_packed_points_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 count
+    , laszip_U8*                       records
+    , laszip_U32*                      read
+);
+laszip_read_packed_points_def laszip_read_packed_points_ptr = 0;
+LASZIP_API laszip_I32
+laszip_read_packed_points(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 count
+    , laszip_U8*                       records
+    , laszip_U32*                      read
+)
+{
+  if (laszip_read_packed_points_ptr)
+  {
+    return (*laszip_read_packed_points_ptr)(pointer, count, records, read);
+  }
+  return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_read_columns_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 count
+    , const laszip_columns_struct*     columns
+    , laszip_U32*                      read
+);
+laszip_read_columns_def laszip_read_columns_ptr = 0;
+LASZIP_API laszip_I32
+laszip_read_columns(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 count
+    , const laszip_columns_struct*     columns
+    , laszip_U32*                      read
+)
+{
+  if (laszip_read_columns_ptr)
+  {
+    return (*laszip_read_columns_ptr)(pointer, count, columns, read);
+  }
+  return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_get_chunk_count_def)
+(
+    laszip_POINTER                     pointer
+    , laszip_U32*                      count
+);
+laszip_get_chunk_count_def laszip_get_chunk_count_ptr = 0;
+LASZIP_API laszip_I32
+laszip_get_chunk_count(
+    laszip_POINTER                     pointer
+    , laszip_U32*                      count
+)
+{
+  if (laszip_get_chunk_count_ptr)
+  {
+    return (*laszip_get_chunk_count_ptr)(pointer, count);
+  }
+  return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_get_chunk_info_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 index
+    , laszip_I64*                      first_point
+    , laszip_U32*                      num_points
+    , laszip_I64*                      byte_offset
+    , laszip_I64*                      byte_size
+);
+laszip_get_chunk_info_def laszip_get_chunk_info_ptr = 0;
+LASZIP_API laszip_I32
+laszip_get_chunk_info(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 index
+    , laszip_I64*                      first_point
+    , laszip_U32*                      num_points
+    , laszip_I64*                      byte_offset
+    , laszip_I64*                      byte_size
+)
+{
+  if (laszip_get_chunk_info_ptr)
+  {
+    return (*laszip_get_chunk_info_ptr)(pointer, index, first_point, num_points, byte_offset, byte_size);
+  }
+  return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_get_chunk_infos_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 index
+    , const laszip_U32                 count
+    , laszip_chunk_struct*             chunks
+);
+laszip_get_chunk_infos_def laszip_get_chunk_infos_ptr = 0;
+LASZIP_API laszip_I32
+laszip_get_chunk_infos(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 index
+    , const laszip_U32                 count
+    , laszip_chunk_struct*             chunks
+)
+{
+  if (laszip_get_chunk_infos_ptr)
+  {
+    return (*laszip_get_chunk_infos_ptr)(pointer, index, count, chunks);
+  }
+  return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_get_chunk_cache_stats_def)
+(
+    laszip_POINTER                     pointer
+    , laszip_U64*                      hits
+    , laszip_U64*                      misses
+    , laszip_U64*                      bytes
+);
+laszip_get_chunk_cache_stats_def laszip_get_chunk_cache_stats_ptr = 0;
+LASZIP_API laszip_I32
+laszip_get_chunk_cache_stats(
+    laszip_POINTER                     pointer
+    , laszip_U64*                      hits
+    , laszip_U64*                      misses
+    , laszip_U64*                      bytes
+)
+{
+  if (laszip_get_chunk_cache_stats_ptr)
+  {
+    return (*laszip_get_chunk_cache_stats_ptr)(pointer, hits, misses, bytes);
+  }
+  return 1;
+}
+
 /*---------------------------------------------------------------------------*/
 typedef laszip_I32 (*laszip_read_inside_point_def)
 (
@@ -1190,6 +1585,21 @@ laszip_I32 laszip_load_dll()
      FreeLibrary(laszip_HINSTANCE);
      return 1;
   }
+  laszip_set_coder_ptr = (laszip_set_coder_def)GetProcAddress(laszip_HINSTANCE, "laszip_set_coder");
+  if (laszip_set_coder_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_request_bitpacked_compression_ptr = (laszip_request_bitpacked_compression_def)GetProcAddress(laszip_HINSTANCE, "laszip_request_bitpacked_compression");
+  if (laszip_request_bitpacked_compression_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_request_attribute_compression_ptr = (laszip_request_attribute_compression_def)GetProcAddress(laszip_HINSTANCE, "laszip_request_attribute_compression");
+  if (laszip_request_attribute_compression_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
   laszip_open_writer_ptr = (laszip_open_writer_def)GetProcAddress(laszip_HINSTANCE, "laszip_open_writer");
   if (laszip_open_writer_ptr == NULL) {
      FreeLibrary(laszip_HINSTANCE);
@@ -1225,6 +1635,41 @@ laszip_I32 laszip_load_dll()
      FreeLibrary(laszip_HINSTANCE);
      return 1;
   }
+  laszip_decompress_selective_attribute_ptr = (laszip_decompress_selective_attribute_def)GetProcAddress(laszip_HINSTANCE, "laszip_decompress_selective_attribute");
+  if (laszip_decompress_selective_attribute_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_decompress_selective_attribute_by_name_ptr = (laszip_decompress_selective_attribute_by_name_def)GetProcAddress(laszip_HINSTANCE, "laszip_decompress_selective_attribute_by_name");
+  if (laszip_decompress_selective_attribute_by_name_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_set_number_of_threads_ptr = (laszip_set_number_of_threads_def)GetProcAddress(laszip_HINSTANCE, "laszip_set_number_of_threads");
+  if (laszip_set_number_of_threads_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_decompress_layers_in_parallel_ptr = (laszip_decompress_layers_in_parallel_def)GetProcAddress(laszip_HINSTANCE, "laszip_decompress_layers_in_parallel");
+  if (laszip_decompress_layers_in_parallel_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_request_memory_mapping_ptr = (laszip_request_memory_mapping_def)GetProcAddress(laszip_HINSTANCE, "laszip_request_memory_mapping");
+  if (laszip_request_memory_mapping_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_set_seek_checkpoints_ptr = (laszip_set_seek_checkpoints_def)GetProcAddress(laszip_HINSTANCE, "laszip_set_seek_checkpoints");
+  if (laszip_set_seek_checkpoints_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_set_chunk_cache_ptr = (laszip_set_chunk_cache_def)GetProcAddress(laszip_HINSTANCE, "laszip_set_chunk_cache");
+  if (laszip_set_chunk_cache_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
   laszip_open_reader_ptr = (laszip_open_reader_def)GetProcAddress(laszip_HINSTANCE, "laszip_open_reader");
   if (laszip_open_reader_ptr == NULL) {
      FreeLibrary(laszip_HINSTANCE);
@@ -1250,6 +1695,46 @@ laszip_I32 laszip_load_dll()
      FreeLibrary(laszip_HINSTANCE);
      return 1;
   }
+  laszip_decompress_selective_on_demand_ptr = (laszip_decompress_selective_on_demand_def)GetProcAddress(laszip_HINSTANCE, "laszip_decompress_selective_on_demand");
+  if (laszip_decompress_selective_on_demand_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_read_points_ptr = (laszip_read_points_def)GetProcAddress(laszip_HINSTANCE, "laszip_read_points");
+  if (laszip_read_points_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_read_packed_points_ptr = (laszip_read_packed_points_def)GetProcAddress(laszip_HINSTANCE, "laszip_read_packed_points");
+  if (laszip_read_packed_points_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_read_columns_ptr = (laszip_read_columns_def)GetProcAddress(laszip_HINSTANCE, "laszip_read_columns");
+  if (laszip_read_columns_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_get_chunk_count_ptr = (laszip_get_chunk_count_def)GetProcAddress(laszip_HINSTANCE, "laszip_get_chunk_count");
+  if (laszip_get_chunk_count_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_get_chunk_info_ptr = (laszip_get_chunk_info_def)GetProcAddress(laszip_HINSTANCE, "laszip_get_chunk_info");
+  if (laszip_get_chunk_info_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_get_chunk_infos_ptr = (laszip_get_chunk_infos_def)GetProcAddress(laszip_HINSTANCE, "laszip_get_chunk_infos");
+  if (laszip_get_chunk_infos_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_get_chunk_cache_stats_ptr = (laszip_get_chunk_cache_stats_def)GetProcAddress(laszip_HINSTANCE, "laszip_get_chunk_cache_stats");
+  if (laszip_get_chunk_cache_stats_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
   laszip_read_inside_point_ptr = (laszip_read_inside_point_def)GetProcAddress(laszip_HINSTANCE, "laszip_read_inside_point");
   if (laszip_read_inside_point_ptr == NULL) {
      FreeLibrary(laszip_HINSTANCE);
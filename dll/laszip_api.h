@@ -24,6 +24,24 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- 'laszip_decompress_selective_on_demand()' adds layers while reading a chunk
+    16 October 2026 -- 'laszip_decompress_selective_attribute[_by_name]()' for any extra bytes
+    16 October 2026 -- 'laszip_request_attribute_compression()' documents its decoding speed
+    16 October 2026 -- laszip_CODER_ARITHMETIC_STATIC is the size-only laszip_CODER_ARITHMETIC_TWO_PASS
+    16 October 2026 -- dropped laszip_CODER_RANS and laszip_CODER_RANS_STATIC that decoded no faster
+    16 October 2026 -- laszip_CODER_ARITHMETIC_STATIC and laszip_CODER_RANS_STATIC for archival
+    16 October 2026 -- 'laszip_request_attribute_compression()' codes typed extra bytes by value
+    16 October 2026 -- 'laszip_request_bitpacked_compression()' for hot storage near memcpy speed
+    16 October 2026 -- 'laszip_set_coder()' lets the writer use the faster decoding rANS coder
+    16 October 2026 -- 'laszip_set_chunk_cache()' keeps recently decoded chunks in memory
+    16 October 2026 -- 'laszip_read_columns()' decodes points into separate column arrays
+    16 October 2026 -- 'laszip_read_points()' and 'laszip_read_packed_points()' for batch reading
+    16 October 2026 -- 'laszip_get_chunk_count()' and 'laszip_get_chunk_info[s]()' expose the chunk table
+    16 October 2026 -- 'laszip_set_seek_checkpoints()' for faster random access within chunks
+    16 October 2026 -- 'laszip_request_memory_mapping()' reads the file via mmap instead of stdio
+    16 October 2026 -- 'laszip_decompress_layers_in_parallel()' for interactive reads of LAS 1.4 points
+    16 October 2026 -- 'laszip_set_number_of_threads()' also compresses chunks in parallel
+    16 October 2026 -- 'laszip_set_number_of_threads()' decompresses chunks in parallel
     22 August 2017 -- Add version info.
     4 August 2017 -- 'laszip_set_point_type_and_size()' as minimal setup for ostream writer
     3 August 2017 -- new 'laszip_create_laszip_vlr()' gets VLR as C++ std::vector
@@ -221,6 +239,50 @@ typedef struct laszip_point
 
 } laszip_point_struct;
 
+// caller-provided column arrays for laszip_read_columns() (NULL columns are skipped)
+typedef struct laszip_columns
+{
+  laszip_I32* X;
+  laszip_I32* Y;
+  laszip_I32* Z;
+
+  // coordinates with scale factor and offset of the header applied
+  laszip_F64* x;
+  laszip_F64* y;
+  laszip_F64* z;
+
+  laszip_U16* intensity;
+  // for point types 6 and higher (also when read in compatibility mode) the next
+  // four hold the extended attributes and 'scan_angle' is 'extended_scan_angle'
+  // in steps of 0.006 degree. otherwise 'scan_angle' is 'scan_angle_rank' in degree
+  laszip_U8* return_number;
+  laszip_U8* number_of_returns;
+  laszip_U8* classification;
+  laszip_I16* scan_angle;
+  laszip_U8* user_data;
+  laszip_U16* point_source_ID;
+
+  laszip_F64* gps_time;
+
+  laszip_U16* R;
+  laszip_U16* G;
+  laszip_U16* B;
+  laszip_U16* NIR;
+
+  // 'num_extra_bytes' per point
+  laszip_U8* extra_bytes;
+
+} laszip_columns_struct;
+
+// one entry of the chunk table for laszip_get_chunk_infos()
+typedef struct laszip_chunk
+{
+  laszip_I64 first_point;
+  laszip_U32 num_points;
+  laszip_I64 byte_offset;             // from the start of the file
+  laszip_I64 byte_size;
+} laszip_chunk_struct;
+
 typedef void(*laszip_message_handler)(
   enum LAS_MESSAGE_TYPE                type
   , const char*                        msg
@@ -255,6 +317,13 @@ typedef void(*laszip_message_handler)(
 #define laszip_DECOMPRESS_SELECTIVE_BYTE7              0x00800000
 #define laszip_DECOMPRESS_SELECTIVE_EXTRA_BYTES        0xFFFF0000
 
+/*---------------------------------------------------------------------------*/
+/*------ DLL constants for choosing the entropy coder of the writer ---------*/
+/*---------------------------------------------------------------------------*/
+
+#define laszip_CODER_ARITHMETIC                        0
+#define laszip_CODER_ARITHMETIC_TWO_PASS               1
+
 /*---------------------------------------------------------------------------*/
 /*---------------- DLL functions to manage the LASzip DLL -------------------*/
 /*---------------------------------------------------------------------------*/
@@ -493,6 +562,36 @@ laszip_set_chunk_size(
     , const laszip_U32                 chunk_size
 );
 
+/*---------------------------------------------------------------------------*/
+// laszip_CODER_ARITHMETIC_TWO_PASS encodes each chunk twice and starts the
+// models from the distributions of the first pass (or leaves them adaptive
+// where that is cheaper). it makes files 1 to 18 percent smaller but writing
+// takes twice as long and reading is not faster. it needs chunked compression
+LASZIP_API laszip_I32
+laszip_set_coder(
+    laszip_POINTER                     pointer
+    , const laszip_U16                 coder
+);
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_request_bitpacked_compression(
+    laszip_POINTER                     pointer
+    , const laszip_BOOL                request
+);
+
+/*---------------------------------------------------------------------------*/
+// the extra bytes of new LAS 1.4 points that are described by attributes are
+// compressed value by value instead of byte by byte (only for native LAS 1.4
+// compression). this makes files smaller and each attribute decompresses as
+// fast or faster on its own, but decompressing many attributes together can
+// be 5 to 10 percent slower than byte by byte
+LASZIP_API laszip_I32
+laszip_request_attribute_compression(
+    laszip_POINTER                     pointer
+    , const laszip_BOOL                request
+);
+
 /*---------------------------------------------------------------------------*/
 LASZIP_API laszip_I32
 laszip_open_writer(
@@ -539,6 +638,61 @@ laszip_decompress_selective(
     , const laszip_U32                 decompress_selective
 );
 
+/*---------------------------------------------------------------------------*/
+// only the extra bytes of the requested attributes of new LAS 1.4 points are
+// decompressed (instead of those selected by the BYTE flags of
+// 'laszip_decompress_selective()'). the requests add up and are resolved with
+// the "extra bytes" VLR in 'laszip_open_reader()'
+LASZIP_API laszip_I32
+laszip_decompress_selective_attribute(
+    laszip_POINTER                     pointer
+    , const laszip_I32                 index
+);
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_decompress_selective_attribute_by_name(
+    laszip_POINTER                     pointer
+    , const laszip_CHAR*               name
+);
+
+/*---------------------------------------------------------------------------*/
+// chunks are (de)compressed by up to this many threads. more threads than
+// cores (or than 8) are not used. 0 or 1 reads and writes without threads
+LASZIP_API laszip_I32
+laszip_set_number_of_threads(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 number_of_threads
+);
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_decompress_layers_in_parallel(
+    laszip_POINTER                     pointer
+    , const laszip_BOOL                in_parallel
+);
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_request_memory_mapping(
+    laszip_POINTER                     pointer
+    , const laszip_BOOL                request
+);
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_set_seek_checkpoints(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 interval
+);
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_set_chunk_cache(
+    laszip_POINTER                     pointer
+    , const laszip_U64                 max_bytes
+);
+
 /*---------------------------------------------------------------------------*/
 LASZIP_API laszip_I32
 laszip_open_reader(
@@ -579,6 +733,80 @@ laszip_read_point(
     laszip_POINTER                     pointer
 );
 
+/*---------------------------------------------------------------------------*/
+// also decompresses these layers of new LAS 1.4 points (see 'laszip_decompress_selective()')
+// for the rest of the current chunk. the point read last is decompressed again with them
+LASZIP_API laszip_I32
+laszip_decompress_selective_on_demand(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 decompress_selective
+);
+
+/*---------------------------------------------------------------------------*/
+// the 'extra_bytes' of each laszip_point_struct must be NULL or hold 'num_extra_bytes'
+LASZIP_API laszip_I32
+laszip_read_points(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 count
+    , laszip_point_struct*             points
+    , laszip_U32*                      read
+);
+
+/*---------------------------------------------------------------------------*/
+// each record has 'point_data_record_length' bytes as stored in a LAS file
+LASZIP_API laszip_I32
+laszip_read_packed_points(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 count
+    , laszip_U8*                       records
+    , laszip_U32*                      read
+);
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_read_columns(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 count
+    , const laszip_columns_struct*     columns
+    , laszip_U32*                      read
+);
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_get_chunk_count(
+    laszip_POINTER                     pointer
+    , laszip_U32*                      count
+);
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_get_chunk_info(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 index
+    , laszip_I64*                      first_point
+    , laszip_U32*                      num_points
+    , laszip_I64*                      byte_offset
+    , laszip_I64*                      byte_size
+);
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_get_chunk_infos(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 index
+    , const laszip_U32                 count
+    , laszip_chunk_struct*             chunks
+);
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_get_chunk_cache_stats(
+    laszip_POINTER                     pointer
+    , laszip_U64*                      hits
+    , laszip_U64*                      misses
+    , laszip_U64*                      bytes
+);
+
 /*---------------------------------------------------------------------------*/
 LASZIP_API laszip_I32
 laszip_read_inside_point(
@@ -95,68 +95,314 @@
 
 #include "arithmeticdecoder.hpp"
 
+#include <stdlib.h>
 #include <string.h>
 #include <cassert>
 
 #include "arithmeticmodel.hpp"
 
-ArithmeticDecoder::ArithmeticDecoder()
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define ARITHMETICDECODER_SSE2
+#include <emmintrin.h>
+#endif
+
+ArithmeticDecoder::ArithmeticDecoder(const U16 coder)
 {
   instream = 0;
+  status = 0;
+  arena = new ArithmeticModelArena();
+  static_models = (coder == LASZIP_CODER_ARITHMETIC_TWO_PASS);
+  static_values = 0;
+  static_num_values = 0;
+  static_alloc_values = 0;
+  static_next = 0;
   length = 0;
   value = 0;
+  windowed = FALSE;
+  window_start = 0;
+  window_curr = 0;
+  window_end = 0;
 }
 
 BOOL ArithmeticDecoder::init(ByteStreamIn* instream, BOOL really_init)
 {
   if (instream == 0) return FALSE;
   this->instream = instream;
+  U32 num_bytes;
+  windowed = (instream->getWindow(num_bytes) != 0);
+  window_start = 0;
+  window_curr = 0;
+  window_end = 0;
   length = AC__MaxLength;
   if (really_init)
   {
-    value = (instream->getByte() << 24);
-    value |= (instream->getByte() << 16);
-    value |= (instream->getByte() << 8);
-    value |= (instream->getByte());
+    if (static_models) static_init();
+    value = (getByte() << 24);
+    value |= (getByte() << 16);
+    value |= (getByte() << 8);
+    value |= (getByte());
   }
   return TRUE;
 }
 
 void ArithmeticDecoder::done()
 {
+  if (instream) skipWindow();
   instream = 0;
 }
 
+U32 ArithmeticDecoder::refillWindow()
+{
+  if (windowed)
+  {
+    skipWindow();
+    U32 num_bytes;
+    const U8* bytes = instream->getWindow(num_bytes);
+    if (num_bytes)
+    {
+      window_start = bytes;
+      window_curr = bytes + 1;
+      window_end = bytes + num_bytes;
+      return bytes[0];
+    }
+  }
+  if (windowed && status)
+  {
+    reportError(EOF);
+    return 0;
+  }
+  return instream->getByte(); // no window (or end-of-stream which throws)
+}
+
+void ArithmeticDecoder::reportError(I32 error)
+{
+  if (status == 0) throw error;
+  if (*status == 0) *status = error;
+}
+
+void ArithmeticDecoder::skipWindow()
+{
+  if (window_start)
+  {
+    instream->skipWindow((U32)(window_curr - window_start));
+    window_start = 0;
+    window_curr = 0;
+    window_end = 0;
+  }
+}
+
 ArithmeticBitModel* ArithmeticDecoder::createBitModel()
 {
-  ArithmeticBitModel* m = new ArithmeticBitModel();
+  ArithmeticBitModel* m = arena->createBitModel();
   return m;
 }
 
 void ArithmeticDecoder::initBitModel(ArithmeticBitModel* m)
 {
   m->init();
+  if (static_models)
+  {
+    // static_update() on first use
+    m->bits_until_update = 1;
+    m->update_cycle = 0;
+  }
 }
 
 void ArithmeticDecoder::destroyBitModel(ArithmeticBitModel* m)
 {
-  delete m;
+  arena->destroyBitModel(m);
 }
 
 ArithmeticModel* ArithmeticDecoder::createSymbolModel(U32 n)
 {
-  ArithmeticModel* m = new ArithmeticModel(n, FALSE);
+  ArithmeticModel* m = arena->createSymbolModel(n, FALSE);
   return m;
 }
 
 void ArithmeticDecoder::initSymbolModel(ArithmeticModel* m, U32 *table)
 {
-  m->init(table);
+  if (table) m->init(table); else arena->initSymbolModel(m);
+  if (static_models)
+  {
+    // static_update() on first use
+    m->symbols_until_update = 1;
+    m->update_cycle = 0;
+  }
 }
 
 void ArithmeticDecoder::destroySymbolModel(ArithmeticModel* m)
 {
-  delete m;
+  arena->destroySymbolModel(m);
+}
+
+BOOL ArithmeticDecoder::saveState(ByteStreamOut* stream) const
+{
+  if (instream == 0) return FALSE;
+  // the position of the next byte that will be read from the instream
+  I64 position = instream->tell() + (window_curr - window_start);
+  if (!stream->putBytes((const U8*)&value, sizeof(U32))) return FALSE;
+  if (!stream->putBytes((const U8*)&length, sizeof(U32))) return FALSE;
+  if (static_models)
+  {
+    // the distributions themselves stay those read by init() for the chunk
+    if (!stream->putBytes((const U8*)&static_next, sizeof(U32))) return FALSE;
+  }
+  return stream->putBytes((const U8*)&position, sizeof(I64));
+}
+
+BOOL ArithmeticDecoder::loadState(ByteStreamIn* stream)
+{
+  if (instream == 0) return FALSE;
+  I64 position;
+  stream->getBytes((U8*)&value, sizeof(U32));
+  stream->getBytes((U8*)&length, sizeof(U32));
+  if (static_models)
+  {
+    stream->getBytes((U8*)&static_next, sizeof(U32));
+    if (static_next > static_num_values) return FALSE;
+  }
+  stream->getBytes((U8*)&position, sizeof(I64));
+  // forget the window without moving the instream past it
+  window_start = 0;
+  window_curr = 0;
+  window_end = 0;
+  return instream->seek(position);
+}
+
+void ArithmeticDecoder::saveBitModel(ByteStreamOut* stream, const ArithmeticBitModel* m) const
+{
+  assert(m);
+  stream->putBytes((const U8*)&m->update_cycle, sizeof(U32));
+  stream->putBytes((const U8*)&m->bits_until_update, sizeof(U32));
+  stream->putBytes((const U8*)&m->bit_0_prob, sizeof(U32));
+  stream->putBytes((const U8*)&m->bit_0_count, sizeof(U32));
+  stream->putBytes((const U8*)&m->bit_count, sizeof(U32));
+}
+
+void ArithmeticDecoder::loadBitModel(ByteStreamIn* stream, ArithmeticBitModel* m)
+{
+  assert(m);
+  stream->getBytes((U8*)&m->update_cycle, sizeof(U32));
+  stream->getBytes((U8*)&m->bits_until_update, sizeof(U32));
+  stream->getBytes((U8*)&m->bit_0_prob, sizeof(U32));
+  stream->getBytes((U8*)&m->bit_0_count, sizeof(U32));
+  stream->getBytes((U8*)&m->bit_count, sizeof(U32));
+}
+
+// counts and distribution increments are mostly small so they are stored with
+// seven bits per byte and the high bit telling whether more bytes follow
+
+static void putCompactU32(ByteStreamOut* stream, U32 value)
+{
+  while (value >= 0x80)
+  {
+    stream->putByte((U8)(value | 0x80));
+    value >>= 7;
+  }
+  stream->putByte((U8)value);
+}
+
+static U32 getCompactU32(ByteStreamIn* stream)
+{
+  U32 value = 0;
+  U32 shift = 0;
+  U8 byte;
+  do
+  {
+    byte = stream->getByte();
+    value |= ((U32)(byte & 0x7F) << shift);
+    shift += 7;
+  } while ((byte & 0x80) && (shift < 35));
+  return value;
+}
+
+// models that were not created (0), that did not decode a symbol since their
+// init() (1) or that did (2). only the latter need their counts and their
+// distribution stored as the decoder table can be derived from the latter
+
+void ArithmeticDecoder::saveSymbolModel(ByteStreamOut* stream, const ArithmeticModel* m) const
+{
+  if (m == 0)
+  {
+    stream->putByte(0);
+  }
+  else if ((m->distribution == 0) || ((m->update_cycle == ((m->symbols + 6) >> 1)) && (m->symbols_until_update == m->update_cycle)))
+  {
+    stream->putByte(1);
+    stream->putBytes((const U8*)&m->symbols, sizeof(U32));
+  }
+  else
+  {
+    stream->putByte(2);
+    stream->putBytes((const U8*)&m->symbols, sizeof(U32));
+    putCompactU32(stream, m->total_count);
+    putCompactU32(stream, m->update_cycle);
+    putCompactU32(stream, m->symbols_until_update);
+    U32 k;
+    for (k = 0; k < m->symbols; k++)
+    {
+      putCompactU32(stream, m->symbol_count[k]);
+    }
+    for (k = 0; k < m->symbols; k++)
+    {
+      putCompactU32(stream, m->distribution[k] - (k ? m->distribution[k-1] : 0));
+    }
+  }
+}
+
+void ArithmeticDecoder::loadSymbolModel(ByteStreamIn* stream, ArithmeticModel*& m)
+{
+  U8 state = stream->getByte();
+  if (state == 0)
+  {
+    // will be created and initialized on first use
+    if (m) destroySymbolModel(m);
+    m = 0;
+    return;
+  }
+  U32 symbols;
+  stream->getBytes((U8*)&symbols, sizeof(U32));
+  if (m == 0) m = createSymbolModel(symbols);
+  initSymbolModel(m);
+  if (state == 2)
+  {
+    m->total_count = getCompactU32(stream);
+    m->update_cycle = getCompactU32(stream);
+    m->symbols_until_update = getCompactU32(stream);
+    U32 k;
+    for (k = 0; k < m->symbols; k++)
+    {
+      m->symbol_count[k] = getCompactU32(stream);
+    }
+    for (k = 0; k < m->symbols; k++)
+    {
+      m->distribution[k] = getCompactU32(stream) + (k ? m->distribution[k-1] : 0);
+    }
+    // same as in ArithmeticModel::update()
+    if (m->decoder_table)
+    {
+      U32 s = 0;
+      for (k = 0; k < m->symbols; k++)
+      {
+        U32 w = m->distribution[k] >> m->table_shift;
+        while (s < w) m->decoder_table[++s] = k - 1;
+      }
+      m->decoder_table[0] = 0;
+      while (s <= m->table_size) m->decoder_table[++s] = m->symbols - 1;
+    }
+  }
+}
+
+// with static models the first update() freezes the model
+
+inline void ArithmeticDecoder::update(ArithmeticModel* m)
+{
+  if (static_models && (m->update_cycle == 0)) static_update(m); else m->update();
+}
+
+inline void ArithmeticDecoder::update(ArithmeticBitModel* m)
+{
+  if (static_models && (m->update_cycle == 0)) static_update(m); else m->update();
 }
 
 U32 ArithmeticDecoder::decodeBit(ArithmeticBitModel* m)
@@ -176,58 +422,81 @@ U32 ArithmeticDecoder::decodeBit(ArithmeticBitModel* m)
   }
 
   if (length < AC__MinLength) renorm_dec_interval();        // renormalization
-  if (--m->bits_until_update == 0) m->update();       // periodic model update
+  if (--m->bits_until_update == 0) update(m);         // periodic model update
 
   return sym;                                         // return data bit value
 }
 
-U32 ArithmeticDecoder::decodeSymbol(ArithmeticModel* m)
+inline U32 ArithmeticDecoder::findSymbol(const ArithmeticModel* m, U32 dv)
 {
-  U32 n, sym, x, y = length;
+  U32 n, sym;
+
+  // the symbol is the number of cumulative frequencies that are at most
+  // dv (minus one) which is found without branching on them
 
   if (m->decoder_table) {             // use table look-up for faster decoding
 
-    unsigned dv = value / (length >>= DM__LengthShift);
     unsigned t = dv >> m->table_shift;
 
     sym = m->decoder_table[t];      // initial decision based on table look-up
     n = m->decoder_table[t+1] + 1;
 
-    while (n > sym + 1) {                      // finish with bisection search
+    while (n > sym + 8) {                      // narrow with bisection search
       U32 k = (sym + n) >> 1;
       if (m->distribution[k] > dv) n = k; else sym = k;
     }
-                                                           // compute products
-    x = m->distribution[sym] * length;
-    if (sym != m->last_symbol) y = m->distribution[sym+1] * length;
+
+    for (U32 k = sym + 1; k < n; k++) {                 // finish by counting
+      sym += (m->distribution[k] <= dv);
+    }
   }
 
-  else {                                  // decode using only multiplications
-
-    x = sym = 0;
-    length >>= DM__LengthShift;
-    U32 k = (n = m->symbols) >> 1;
-                                                // decode via bisection search
-    do {
-      U32 z = length * m->distribution[k];
-      if (z > value) {
-        n = k;
-        y = z;                                             // value is smaller
-      }
-      else {
-        sym = k;
-        x = z;                                     // value is larger or equal
-      }
-    } while ((k = (sym + n) >> 1) != sym);
+  else {                             // small alphabet: count over all symbols
+
+#ifdef ARITHMETICDECODER_SSE2
+    // frequencies are below 2^16 so signed compares are fine and the (masked)
+    // lanes past the last symbol still read the model's symbol_count array
+    __m128i d = _mm_set1_epi32((int)dv + 1);
+    __m128i s = _mm_set1_epi32((int)m->symbols);
+    __m128i k = _mm_setr_epi32(0, 1, 2, 3);
+    __m128i c = _mm_setzero_si128();
+    for (n = 0; n < m->symbols; n += 4) {
+      __m128i f = _mm_loadu_si128((const __m128i*)(m->distribution + n));
+      c = _mm_sub_epi32(c, _mm_and_si128(_mm_cmpgt_epi32(d, f), _mm_cmpgt_epi32(s, k)));
+      k = _mm_add_epi32(k, _mm_set1_epi32(4));
+    }
+    c = _mm_add_epi32(c, _mm_shuffle_epi32(c, 0x4E));
+    c = _mm_add_epi32(c, _mm_shuffle_epi32(c, 0xB1));
+    sym = (U32)_mm_cvtsi128_si32(c) - 1;
+#else
+    sym = 0;
+    for (n = 1; n < m->symbols; n++) {
+      sym += (m->distribution[n] <= dv);
+    }
+#endif
   }
 
+  return sym;
+}
+
+U32 ArithmeticDecoder::decodeSymbol(ArithmeticModel* m)
+{
+  U32 sym, x, y = length;
+
+  unsigned dv = value / (length >>= DM__LengthShift);
+
+  sym = findSymbol(m, dv);
+                                                           // compute products
+  x = m->distribution[sym] * length;
+  if (sym != m->last_symbol) y = m->distribution[sym+1] * length;
+
   value -= x;                                               // update interval
   length = y - x;
 
   if (length < AC__MinLength) renorm_dec_interval();        // renormalization
 
   ++m->symbol_count[sym];
-  if (--m->symbols_until_update == 0) m->update();    // periodic model update
+  if (--m->symbols_until_update == 0) update(m);      // periodic model update
 
   assert(sym < m->symbols);
 
@@ -243,7 +512,8 @@ U32 ArithmeticDecoder::readBit()
 
   if (sym >= 2)
   {
-    throw 4711;
+    reportError(4711);
+    return 0;
   }
 
   return sym;
@@ -268,7 +538,8 @@ U32 ArithmeticDecoder::readBits(U32 bits)
 
   if (sym >= (1u<<bits))
   {
-    throw 4711;
+    reportError(4711);
+    return 0;
   }
 
   return sym;
@@ -283,7 +554,8 @@ U8 ArithmeticDecoder::readByte()
 
   if (sym >= (1u<<8))
   {
-    throw 4711;
+    reportError(4711);
+    return 0;
   }
 
   return (U8)sym;
@@ -298,7 +570,8 @@ U16 ArithmeticDecoder::readShort()
 
   if (sym >= (1u<<16))
   {
-    throw 4711;
+    reportError(4711);
+    return 0;
   }
 
   return (U16)sym;
@@ -334,11 +607,158 @@ F64 ArithmeticDecoder::readDouble() /* danger in float reinterpretation */
 
 ArithmeticDecoder::~ArithmeticDecoder()
 {
+  delete arena;
+  if (static_values) free(static_values);
 }
 
 inline void ArithmeticDecoder::renorm_dec_interval()
 {
-  do {                                          // read least-significant byte
-    value = (value << 8) | instream->getByte();
-  } while ((length <<= 8) < AC__MinLength);        // length multiplied by 256
+  do {                 // shift both first so that an EOF leaves them consistent
+    length <<= 8;                                  // length multiplied by 256
+    value <<= 8;
+    value |= getByte();                         // read least-significant byte
+  } while (length < AC__MinLength);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Static models whose distributions precede the data of a chunk             -
+// -> see ArithmeticEncoder::static_done() for the format. models are        -
+//    frozen with the next distribution on their first use or left adaptive  -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void ArithmeticDecoder::static_update(ArithmeticModel* m)
+{
+  if ((static_next < static_num_values) && (static_values[static_next] == 0))
+  {
+    m->thaw();
+    static_next += 1;
+    return;
+  }
+  if ((static_next + m->symbols >= static_num_values) || (static_values[static_next] != m->symbols))
+  {
+    reportError(4711);
+    return;
+  }
+  m->freeze(static_values + static_next + 1);
+  static_next += 1 + m->symbols;
+}
+
+void ArithmeticDecoder::static_update(ArithmeticBitModel* m)
+{
+  if ((static_next < static_num_values) && (static_values[static_next] == 0))
+  {
+    m->thaw();
+    static_next += 1;
+    return;
+  }
+  if ((static_next + 1 >= static_num_values) || (static_values[static_next] != 1))
+  {
+    reportError(4711);
+    return;
+  }
+  m->freeze(static_values[static_next + 1]);
+  static_next += 2;
+}
+
+U32 ArithmeticDecoder::static_compact()
+{
+  U32 value = 0;
+  U32 shift = 0;
+  U32 byte;
+  do
+  {
+    byte = getByte();
+    value |= ((byte & 0x7F) << shift);
+    shift += 7;
+  } while ((byte & 0x80) && (shift < 35));
+  return value;
+}
+
+void ArithmeticDecoder::static_value(U32 value)
+{
+  if (static_num_values == static_alloc_values)
+  {
+    U32 alloc = (static_alloc_values ? 2 * static_alloc_values : 4096);
+    U32* values = (U32*)realloc(static_values, sizeof(U32)*alloc);
+    if (values == 0)
+    {
+      reportError(4711);
+      return;
+    }
+    static_values = values;
+    static_alloc_values = alloc;
+  }
+  static_values[static_num_values++] = value;
+}
+
+void ArithmeticDecoder::static_init()
+{
+  U32 i, k;
+  U32 num_models = static_compact();
+
+  static_num_values = 0;
+  static_next = 0;
+
+  for (i = 0; i < num_models; i++)
+  {
+    U32 symbols = static_compact();
+    if (symbols == 0)
+    {
+      static_value(0);
+    }
+    else if (symbols == 1)
+    {
+      U32 bit_0_prob = static_compact();
+      if ((bit_0_prob == 0) || (bit_0_prob >= BM__MaxCount))
+      {
+        reportError(4711);
+        return;
+      }
+      static_value(1);
+      static_value(bit_0_prob);
+    }
+    else
+    {
+      if ((symbols < 2) || (symbols > (1 << 11)))
+      {
+        reportError(4711);
+        return;
+      }
+      U32 total = 0;
+      static_value(symbols);
+      for (k = 0; k < symbols; )
+      {
+        U32 count = static_compact();
+        if (count == 0)
+        {
+          U32 run = static_compact() + 1;
+          if (run > symbols - k)
+          {
+            reportError(4711);
+            return;
+          }
+          k += run;
+          while (run--) static_value(0);
+        }
+        else
+        {
+          if (count > DM__MaxCount)
+          {
+            reportError(4711);
+            return;
+          }
+          total += count;
+          static_value(count);
+          k++;
+        }
+      }
+      if ((total == 0) || (total > DM__MaxCount))
+      {
+        reportError(4711);
+        return;
+      }
+    }
+  }
 }
@@ -25,6 +25,17 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- no longer decodes rANS (LASZIP_CODER_RANS), which was not faster
+    16 October 2026 -- decodes rANS with a RANSdecoder that create() picks for the coder
+    16 October 2026 -- optionally reports errors through a status instead of throwing
+    16 October 2026 -- restores symbol models without a table from a pristine copy
+    16 October 2026 -- allocates its models from an ArithmeticModelArena
+    16 October 2026 -- static models are quantized and may stay adaptive
+    16 October 2026 -- reads the distributions of static models (LASZIP_CODER_*_STATIC) per chunk
+    16 October 2026 -- can decode with two interleaved rANS states (LASZIP_CODER_RANS) instead
+    16 October 2026 -- decodeSymbol() counts instead of bisecting (with SSE2 for small alphabets)
+    16 October 2026 -- save and load the decoding state and models for checkpoints
+    16 October 2026 -- read bytes from the window of the ByteStreamIn when it has one
     22 August 2016 -- can be used as init dummy by "native LAS 1.4 compressor"
     13 November 2014 -- integrity check in readBits(), readByte(), readShort()
      6 September 2014 -- removed the (unused) inheritance from EntropyDecoder
@@ -38,19 +49,28 @@
 #define ARITHMETIC_DECODER_HPP
 
 #include "mydefs.hpp"
+#include "laszip.hpp"
 #include "bytestreamin.hpp"
+#include "bytestreamout.hpp"
 
 class ArithmeticModel;
 class ArithmeticBitModel;
+class ArithmeticModelArena;
 
 class ArithmeticDecoder
 {
 public:
 
 /* Constructor & Destructor                                  */
-  ArithmeticDecoder();
+  ArithmeticDecoder(const U16 coder=LASZIP_CODER_ARITHMETIC);
   ~ArithmeticDecoder();
 
+/* Which LASZIP_CODER_* decodes the modelled symbols         */
+  U16 getCoder() const { return (static_models ? LASZIP_CODER_ARITHMETIC_TWO_PASS : LASZIP_CODER_ARITHMETIC); };
+
+/* Whether models are static (frozen per chunk)              */
+  BOOL hasStaticModels() const { return static_models; };
+
 /* Manage decoding                                           */
   BOOL init(ByteStreamIn* instream, BOOL really_init = TRUE);
   void done();
@@ -95,15 +115,71 @@ public:
 /* Decode a double without modelling                         */
   F64 readDouble();
 
+/* Save and load decoding state (instream must be seekable)  */
+  BOOL saveState(ByteStreamOut* stream) const;
+  BOOL loadState(ByteStreamIn* stream);
+
+/* Save and load the state of entropy models                 */
+  void saveBitModel(ByteStreamOut* stream, const ArithmeticBitModel* model) const;
+  void loadBitModel(ByteStreamIn* stream, ArithmeticBitModel* model);
+  void saveSymbolModel(ByteStreamOut* stream, const ArithmeticModel* model) const;
+  void loadSymbolModel(ByteStreamIn* stream, ArithmeticModel*& model);
+
 /* Only read from instream if ArithmeticDecoder is dummy     */
   ByteStreamIn* getByteStreamIn() const { return instream; };
 
+/* Report errors through status instead of throwing them     */
+  void setStatus(I32* status) { this->status = status; };
+  I32* getStatus() const { return status; };
+  void reportError(I32 error);
+
 private:
 
   ByteStreamIn* instream;
 
+  // with a status the decoder never throws. it keeps the first error there
+  // and decodes zeros past the end of a windowed instream. instreams that
+  // have no window still throw EOF in getByte()
+
+  I32* status;
+
+  // where the models of this decoder and their tables are allocated
+  ArithmeticModelArena* arena;
+
   void renorm_dec_interval();
   U32 value, length;
+
+  static inline U32 findSymbol(const ArithmeticModel* model, U32 dv);
+
+  // with static models init() reads the distributions that the models of
+  // the chunk get frozen with (or a zero for those that stay adaptive) in
+  // the order in which they are first used
+
+  BOOL static_models;
+  U32* static_values;
+  U32 static_num_values;
+  U32 static_alloc_values;
+  U32 static_next;
+
+  inline void update(ArithmeticModel* model);
+  inline void update(ArithmeticBitModel* model);
+  void static_update(ArithmeticModel* model);
+  void static_update(ArithmeticBitModel* model);
+  U32 static_compact();
+  void static_value(U32 value);
+  void static_init();
+
+  // bytes of the instream that are read without a virtual call. init()
+  // forgets the window and done() moves the instream past what was read
+
+  BOOL windowed;
+  const U8* window_start;
+  const U8* window_curr;
+  const U8* window_end;
+
+  inline U32 getByte() { return (window_curr < window_end ? *window_curr++ : refillWindow()); };
+  U32 refillWindow();
+  void skipWindow();
 };
 
 #endif
@@ -96,15 +96,18 @@
 #include "arithmeticencoder.hpp"
 
 #include <string.h>
+#include <math.h>
 #include <cassert>
 
 #include <stdio.h>
 
 #include "arithmeticmodel.hpp"
 
-ArithmeticEncoder::ArithmeticEncoder()
+ArithmeticEncoder::ArithmeticEncoder(const U16 coder)
 {
   outstream = 0;
+  arena = new ArithmeticModelArena();
+  static_models = (coder == LASZIP_CODER_ARITHMETIC_TWO_PASS);
   base = 0;
   endbyte = 0; 
   length = 0;
@@ -112,11 +115,27 @@ ArithmeticEncoder::ArithmeticEncoder()
 
   outbuffer = (U8*)malloc(sizeof(U8)*2*AC_BUFFER_SIZE);
   endbuffer = outbuffer + 2 * AC_BUFFER_SIZE;
+
+  static_coding = FALSE;
+  static_used = 0;
+  static_num_used = 0;
+  static_alloc_used = 0;
+  static_values = 0;
+  static_num_values = 0;
+  static_alloc_values = 0;
+  static_next = 0;
+  static_header = 0;
+  static_header_size = 0;
+  static_alloc_header = 0;
 }
 
 ArithmeticEncoder::~ArithmeticEncoder()
 {
   free(outbuffer);
+  delete arena;
+  if (static_used) free(static_used);
+  if (static_values) free(static_values);
+  if (static_header) free(static_header);
 }
 
 BOOL ArithmeticEncoder::init(ByteStreamOut* outstream)
@@ -127,6 +146,19 @@ BOOL ArithmeticEncoder::init(ByteStreamOut* outstream)
   length = AC__MaxLength;
   outbyte = outbuffer;
   endbyte = endbuffer;
+  if (static_models)
+  {
+    if (static_coding)
+    {
+      // the distributions counted in the first pass go ahead of the second
+      if (!outstream->putBytes(static_header, static_header_size)) return FALSE;
+      static_next = 0;
+    }
+    else
+    {
+      static_num_used = 0;
+    }
+  }
   return TRUE;
 }
 
@@ -134,6 +166,18 @@ void ArithmeticEncoder::done()
 {
   if (outstream == 0) return;
 
+  if (static_models)
+  {
+    static_coding = !static_coding;
+    if (static_coding)
+    {
+      // the first pass only counted and its output gets discarded
+      static_done();
+      outstream = 0;
+      return;
+    }
+  }
+
   U32 init_base = base;                 // done encoding: set final data bytes
   BOOL another_byte = TRUE;
 
@@ -168,34 +212,59 @@ void ArithmeticEncoder::done()
 
 ArithmeticBitModel* ArithmeticEncoder::createBitModel()
 {
-  ArithmeticBitModel* m = new ArithmeticBitModel();
+  ArithmeticBitModel* m = arena->createBitModel();
   return m;
 }
 
 void ArithmeticEncoder::initBitModel(ArithmeticBitModel* m)
 {
   m->init();
+  if (static_models)
+  {
+    // static_update() on first use
+    m->bits_until_update = 1;
+    m->update_cycle = 0;
+  }
 }
 
 void ArithmeticEncoder::destroyBitModel(ArithmeticBitModel* m)
 {
-  delete m;
+  arena->destroyBitModel(m);
 }
 
 ArithmeticModel* ArithmeticEncoder::createSymbolModel(U32 n)
 {
-  ArithmeticModel* m = new ArithmeticModel(n, true);
+  ArithmeticModel* m = arena->createSymbolModel(n, true);
   return m;
 }
 
 void ArithmeticEncoder::initSymbolModel(ArithmeticModel* m, U32* table)
 {
-  m->init(table);
+  if (table) m->init(table); else arena->initSymbolModel(m);
+  if (static_models)
+  {
+    // static_update() on first use
+    m->symbols_until_update = 1;
+    m->update_cycle = 0;
+  }
 }
 
 void ArithmeticEncoder::destroySymbolModel(ArithmeticModel* m)
 {
-  delete m;
+  arena->destroySymbolModel(m);
+}
+
+// with static models the first update() freezes the model or leaves it
+// adaptive (or starts counting). until then its update cycle is zero
+
+inline void ArithmeticEncoder::update(ArithmeticModel* m)
+{
+  if (static_models && (m->update_cycle == 0)) static_update(m); else m->update();
+}
+
+inline void ArithmeticEncoder::update(ArithmeticBitModel* m)
+{
+  if (static_models && (m->update_cycle == 0)) static_update(m); else m->update();
 }
 
 void ArithmeticEncoder::encodeBit(ArithmeticBitModel* m, U32 sym)
@@ -216,7 +285,7 @@ void ArithmeticEncoder::encodeBit(ArithmeticBitModel* m, U32 sym)
   }
 
   if (length < AC__MinLength) renorm_enc_interval();        // renormalization
-  if (--m->bits_until_update == 0) m->update();       // periodic model update
+  if (--m->bits_until_update == 0) update(m);         // periodic model update
 }
 
 void ArithmeticEncoder::encodeSymbol(ArithmeticModel* m, U32 sym)
@@ -240,7 +309,7 @@ void ArithmeticEncoder::encodeSymbol(ArithmeticModel* m, U32 sym)
   if (length < AC__MinLength) renorm_enc_interval();        // renormalization
 
   ++m->symbol_count[sym];
-  if (--m->symbols_until_update == 0) m->update();    // periodic model update
+  if (--m->symbols_until_update == 0) update(m);      // periodic model update
 }
 
 void ArithmeticEncoder::writeBit(U32 sym)
@@ -358,3 +427,317 @@ inline void ArithmeticEncoder::manage_outbuffer()
   assert(endbyte > outbyte);
   assert(outbyte < endbuffer);    
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Static models that are encoded twice per chunk                            -
+// -> the first pass counts, the second pass writes the distributions of    -
+//    all models in the order of their first use and freezes the models     -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void ArithmeticEncoder::static_update(ArithmeticModel* m)
+{
+  if (static_coding)
+  {
+    assert(static_next < static_num_values);
+    if (static_values[static_next] == 0)
+    {
+      m->thaw();
+      static_next += 1;
+      return;
+    }
+    assert(static_values[static_next] == m->symbols);
+    m->freeze(static_values + static_next + 1);
+    static_next += 1 + m->symbols;
+  }
+  else
+  {
+    // count from now on (a model that is initialized again in the same chunk
+    // starts counting again and static_done() leaves its earlier uses adaptive)
+    StaticModel* s = static_use();
+    s->symbol_model = m;
+    s->bit_model = 0;
+    memset(m->symbol_count, 0, sizeof(U32)*m->symbols);
+    m->symbols_until_update = U32_MAX;
+  }
+}
+
+void ArithmeticEncoder::static_update(ArithmeticBitModel* m)
+{
+  if (static_coding)
+  {
+    assert(static_next < static_num_values);
+    if (static_values[static_next] == 0)
+    {
+      m->thaw();
+      static_next += 1;
+      return;
+    }
+    assert(static_values[static_next] == 1);
+    m->freeze(static_values[static_next + 1]);
+    static_next += 2;
+  }
+  else
+  {
+    StaticModel* s = static_use();
+    s->symbol_model = 0;
+    s->bit_model = m;
+    m->bit_0_count = 0;
+    m->bits_until_update = U32_MAX;
+  }
+}
+
+ArithmeticEncoder::StaticModel* ArithmeticEncoder::static_use()
+{
+  if (static_num_used == static_alloc_used)
+  {
+    U32 alloc = (static_alloc_used ? 2 * static_alloc_used : 256);
+    StaticModel* used = (StaticModel*)realloc(static_used, sizeof(StaticModel)*alloc);
+    if (used == 0)
+    {
+      throw 4711;
+    }
+    static_used = used;
+    static_alloc_used = alloc;
+  }
+  return static_used + static_num_used++;
+}
+
+void ArithmeticEncoder::static_value(U32 value)
+{
+  if (static_num_values == static_alloc_values)
+  {
+    U32 alloc = (static_alloc_values ? 2 * static_alloc_values : 4096);
+    U32* values = (U32*)realloc(static_values, sizeof(U32)*alloc);
+    if (values == 0)
+    {
+      throw 4711;
+    }
+    static_values = values;
+    static_alloc_values = alloc;
+  }
+  static_values[static_num_values++] = value;
+}
+
+void ArithmeticEncoder::static_byte(U8 byte)
+{
+  if (static_header_size == static_alloc_header)
+  {
+    U32 alloc = (static_alloc_header ? 2 * static_alloc_header : 4096);
+    U8* header = (U8*)realloc(static_header, alloc);
+    if (header == 0)
+    {
+      throw 4711;
+    }
+    static_header = header;
+    static_alloc_header = alloc;
+  }
+  static_header[static_header_size++] = byte;
+}
+
+// seven bits per byte with the high bit telling whether more bytes follow
+
+void ArithmeticEncoder::static_compact(U32 value)
+{
+  while (value >= 0x80)
+  {
+    static_byte((U8)(value | 0x80));
+    value >>= 7;
+  }
+  static_byte((U8)value);
+}
+
+// the header is the number of models followed for each of them by a zero if
+// the model stays adaptive, by a one and the zero probability of a bit model,
+// or by the number of symbols and the frequencies of a symbol model, where
+// runs of zero frequencies are a zero and the run length minus one. a model
+// is frozen only when this is estimated to take fewer bits than leaving it
+// adaptive, which costs the entropy of its n counts plus what it takes to
+// learn them (about half of log2(n) bits per symbol)
+
+static U32 static_compact_size(U32 value)
+{
+  U32 size = 1;
+  while (value >= 0x80)
+  {
+    value >>= 7;
+    size++;
+  }
+  return size;
+}
+
+static F64 static_adaptive_bits(const F64 entropy, const U32 n, const U32 symbols)
+{
+  F64 learn = 0.5 * (symbols - 1) * log2(n + 1.0);
+  F64 most = n * log2((F64)symbols);
+  return 8 + entropy + (learn < most ? learn : most);
+}
+
+// the frequency of a count when n counts are quantized to about 'total'. no
+// count becomes zero and with n at most 'total' none changes
+
+static inline U32 static_quantize(const U32 count, const U32 n, const U32 total)
+{
+  if ((count == 0) || (n <= total)) return count;
+  U32 freq = (U32)(((U64)count * total + (n >> 1)) / n);
+  return (freq ? freq : 1);
+}
+
+void ArithmeticEncoder::static_done()
+{
+  U32 i;
+
+  // a model that was initialized again in the chunk only has the counts of
+  // its last use. an update cycle of one marks models already seen backwards
+  for (i = static_num_used; i > 0; i--)
+  {
+    StaticModel* s = static_used + i - 1;
+    U32* update_cycle = (s->bit_model ? &s->bit_model->update_cycle : &s->symbol_model->update_cycle);
+    s->counted = (*update_cycle == 0);
+    *update_cycle = 1;
+  }
+
+  static_num_values = 0;
+  static_header_size = 0;
+  static_compact(static_num_used);
+
+  for (i = 0; i < static_num_used; i++)
+  {
+    if (static_used[i].bit_model)
+    {
+      static_done(static_used[i].bit_model, static_used[i].counted);
+      static_used[i].bit_model->update_cycle = 0;
+    }
+    else
+    {
+      static_done(static_used[i].symbol_model, static_used[i].counted);
+      static_used[i].symbol_model->update_cycle = 0;
+    }
+  }
+}
+
+void ArithmeticEncoder::static_done(ArithmeticBitModel* m, BOOL counted)
+{
+  U32 n = (counted ? U32_MAX - m->bits_until_update : 0);
+  if (n)
+  {
+    U32 n0 = m->bit_0_count;
+    U32 n1 = n - n0;
+    U32 bit_0_prob = (U32)(((U64)n0 * BM__MaxCount + (n >> 1)) / n);
+    if (bit_0_prob == 0) bit_0_prob = 1;
+    else if (bit_0_prob >= BM__MaxCount) bit_0_prob = BM__MaxCount - 1;
+
+    F64 entropy = 0;
+    if (n0) entropy += n0 * log2((F64)n / n0);
+    if (n1) entropy += n1 * log2((F64)n / n1);
+    F64 bits = 8.0 * (1 + static_compact_size(bit_0_prob));
+    bits += n0 * log2((F64)BM__MaxCount / bit_0_prob);
+    bits += n1 * log2((F64)BM__MaxCount / (BM__MaxCount - bit_0_prob));
+
+    if (bits < static_adaptive_bits(entropy, n, 2))
+    {
+      static_value(1);
+      static_value(bit_0_prob);
+      static_compact(1);
+      static_compact(bit_0_prob);
+      return;
+    }
+  }
+  static_value(0);
+  static_compact(0);
+}
+
+void ArithmeticEncoder::static_done(ArithmeticModel* m, BOOL counted)
+{
+  U32 k, n = 0;
+  if (counted)
+  {
+    for (k = 0; k < m->symbols; k++) n += m->symbol_count[k];
+  }
+  if (n == 0)
+  {
+    static_value(0);
+    static_compact(0);
+    return;
+  }
+
+  F64 entropy = 0;
+  for (k = 0; k < m->symbols; k++)
+  {
+    if (m->symbol_count[k]) entropy += m->symbol_count[k] * log2((F64)n / m->symbol_count[k]);
+  }
+
+  // quantized to totals from 2^4 up to 2^14 or the counts themselves (when
+  // they sum to at most DM__MaxCount), whichever is cheapest with its header
+  F64 best_bits = static_adaptive_bits(entropy, n, m->symbols);
+  U32 best_total = 0;
+  U32 total;
+  for (total = (1 << 4); total <= DM__MaxCount; total <<= 1)
+  {
+    if ((total == DM__MaxCount) && (n > total)) break;
+    U32 sum = 0;
+    U32 bytes = static_compact_size(m->symbols);
+    U32 zeros = 0;
+    F64 weighted = 0;
+    for (k = 0; k < m->symbols; k++)
+    {
+      U32 freq = static_quantize(m->symbol_count[k], n, total);
+      if (freq)
+      {
+        if (zeros) bytes += 1 + static_compact_size(zeros - 1);
+        zeros = 0;
+        bytes += static_compact_size(freq);
+        weighted += m->symbol_count[k] * log2((F64)freq);
+        sum += freq;
+      }
+      else
+      {
+        zeros++;
+      }
+    }
+    if (zeros) bytes += 1 + static_compact_size(zeros - 1);
+    F64 bits = 8.0 * bytes + n * log2((F64)sum) - weighted;
+    if (bits < best_bits)
+    {
+      best_bits = bits;
+      best_total = total;
+    }
+    if (n <= total) break;
+  }
+
+  if (best_total == 0)
+  {
+    static_value(0);
+    static_compact(0);
+    return;
+  }
+
+  U32 zeros = 0;
+  static_value(m->symbols);
+  static_compact(m->symbols);
+  for (k = 0; k < m->symbols; k++)
+  {
+    U32 freq = static_quantize(m->symbol_count[k], n, best_total);
+    static_value(freq);
+    if (freq)
+    {
+      if (zeros)
+      {
+        static_compact(0);
+        static_compact(zeros - 1);
+      }
+      zeros = 0;
+      static_compact(freq);
+    }
+    else
+    {
+      zeros++;
+    }
+  }
+  if (zeros)
+  {
+    static_compact(0);
+    static_compact(zeros - 1);
+  }
+}
@@ -25,6 +25,13 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- no longer encodes rANS (LASZIP_CODER_RANS), which was not faster to decode
+    16 October 2026 -- counts the buffered rANS symbols with size_t
+    16 October 2026 -- restores symbol models without a table from a pristine copy
+    16 October 2026 -- allocates its models from an ArithmeticModelArena
+    16 October 2026 -- static models are quantized and stay adaptive where that is cheaper
+    16 October 2026 -- encodes each chunk twice with static models (LASZIP_CODER_*_STATIC)
+    16 October 2026 -- can encode with two interleaved rANS states (LASZIP_CODER_RANS) instead
      1 July 2016 -- can be used as init dummy by "native LAS 1.4 compressor"
      6 September 2014 -- removed the (unused) inheritance from EntropyEncoder
     10 January 2011 -- licensing change for LGPL release and liblas integration
@@ -37,19 +44,27 @@
 #define ARITHMETIC_ENCODER_HPP
 
 #include "mydefs.hpp"
+#include "laszip.hpp"
 #include "bytestreamout.hpp"
 
 class ArithmeticModel;
 class ArithmeticBitModel;
+class ArithmeticModelArena;
 
 class ArithmeticEncoder
 {
 public:
 
 /* Constructor & Destructor                                  */
-  ArithmeticEncoder();
+  ArithmeticEncoder(const U16 coder=LASZIP_CODER_ARITHMETIC);
   ~ArithmeticEncoder();
 
+/* Which LASZIP_CODER_* encodes the modelled symbols         */
+  U16 getCoder() const { return (static_models ? LASZIP_CODER_ARITHMETIC_TWO_PASS : LASZIP_CODER_ARITHMETIC); };
+
+/* Whether each chunk must be encoded twice (static models)  */
+  BOOL hasStaticModels() const { return static_models; };
+
 /* Manage encoding                                           */
   BOOL init(ByteStreamOut* outstream);
   void done();
@@ -101,6 +116,9 @@ private:
 
   ByteStreamOut* outstream;
 
+  // where the models of this encoder and their tables are allocated
+  ArithmeticModelArena* arena;
+
   void propagate_carry();
   void renorm_enc_interval();
   void manage_outbuffer();
@@ -109,6 +127,47 @@ private:
   U8* outbyte;
   U8* endbyte;
   U32 base, length;
+
+  // with static models every chunk is encoded twice. the first pass counts
+  // the symbols of each model from its first use on and done() turns these
+  // counts into distributions. the second pass starts by writing them with
+  // init() and freezes each model with the next one on its first use (or
+  // leaves it adaptive when that was estimated to take fewer bits)
+
+  BOOL static_models;
+  BOOL static_coding;
+
+  struct StaticModel
+  {
+    ArithmeticModel* symbol_model;
+    ArithmeticBitModel* bit_model;
+    BOOL counted;
+  };
+
+  StaticModel* static_used;
+  U32 static_num_used;
+  U32 static_alloc_used;
+
+  U32* static_values;
+  U32 static_num_values;
+  U32 static_alloc_values;
+  U32 static_next;
+
+  U8* static_header;
+  U32 static_header_size;
+  U32 static_alloc_header;
+
+  inline void update(ArithmeticModel* model);
+  inline void update(ArithmeticBitModel* model);
+  void static_update(ArithmeticModel* model);
+  void static_update(ArithmeticBitModel* model);
+  StaticModel* static_use();
+  void static_value(U32 value);
+  void static_byte(U8 byte);
+  void static_compact(U32 value);
+  void static_done();
+  void static_done(ArithmeticModel* model, BOOL counted);
+  void static_done(ArithmeticBitModel* model, BOOL counted);
 };
 
 #endif
@@ -69,10 +69,14 @@
 
 #include "arithmeticmodel.hpp"
 
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
-ArithmeticModel::ArithmeticModel(U32 symbols, BOOL compress)
+#include <new>
+
+ArithmeticModel::ArithmeticModel(U32 symbols, BOOL compress, U32* tables)
 {
   this->symbols = symbols;
   this->compress = compress;
@@ -85,42 +89,65 @@ ArithmeticModel::ArithmeticModel(U32 symbols, BOOL compress)
   table_size = 0;
   total_count = 0;
   update_cycle = 0;
+  in_arena = (tables != 0);
+  if (tables) layout(tables);
 }
 
 ArithmeticModel::~ArithmeticModel()
 {
-  if (distribution) delete [] distribution;
+  if (distribution && !in_arena) delete [] distribution;
+}
+
+U32 ArithmeticModel::table_words(U32 symbols, BOOL compress)
+{
+  if ( (symbols < 2) || (symbols > (1 << 11)) )
+  {
+    return 0; // invalid number of symbols
+  }
+  if ((!compress) && (symbols > 16))
+  {
+    U32 table_bits = 3;
+    while (symbols > (1U << (table_bits + 2))) ++table_bits;
+    return 2*symbols + (1 << table_bits) + 2;
+  }
+  return 2*symbols;
+}
+
+I32 ArithmeticModel::layout(U32* tables)
+{
+  if ( (symbols < 2) || (symbols > (1 << 11)) )
+  {
+    return -1; // invalid number of symbols
+  }
+  last_symbol = symbols - 1;
+  if ((!compress) && (symbols > 16))
+  {
+    U32 table_bits = 3;
+    while (symbols > (1U << (table_bits + 2))) ++table_bits;
+    table_size  = 1 << table_bits;
+    table_shift = DM__LengthShift - table_bits;
+    distribution = (tables ? tables : new U32[2*symbols+table_size+2]);
+    decoder_table = distribution + 2 * symbols;
+  }
+  else // small alphabet: no table needed
+  {                                  
+    decoder_table = 0;
+    table_size = table_shift = 0;
+    distribution = (tables ? tables : new U32[2*symbols]);
+  }
+  if (distribution == 0)
+  {
+    return -1; // "cannot allocate model memory");
+  }
+  symbol_count = distribution + symbols;
+  return 0;
 }
 
 I32 ArithmeticModel::init(U32* table)
 {
   if (distribution == 0)
   {
-    if ( (symbols < 2) || (symbols > (1 << 11)) )
-    {
-      return -1; // invalid number of symbols
-    }
-    last_symbol = symbols - 1;
-    if ((!compress) && (symbols > 16))
-    {
-      U32 table_bits = 3;
-      while (symbols > (1U << (table_bits + 2))) ++table_bits;
-      table_size  = 1 << table_bits;
-      table_shift = DM__LengthShift - table_bits;
-      distribution = new U32[2*symbols+table_size+2];
-      decoder_table = distribution + 2 * symbols;
-    }
-    else // small alphabet: no table needed
-    {                                  
-      decoder_table = 0;
-      table_size = table_shift = 0;
-      distribution = new U32[2*symbols];
-    }
-    if (distribution == 0)
-    {
-      return -1; // "cannot allocate model memory");
-    }
-    symbol_count = distribution + symbols;
+    if (layout(0)) return -1;
   }
 
   total_count = 0;
@@ -136,6 +163,22 @@ I32 ArithmeticModel::init(U32* table)
   return 0;
 }
 
+I32 ArithmeticModel::restore(const ArithmeticModel* pristine)
+{
+  assert((symbols == pristine->symbols) && (compress == pristine->compress));
+  if (distribution == 0)
+  {
+    if (layout(0)) return -1;
+  }
+
+  memcpy(distribution, pristine->distribution, sizeof(U32)*table_words(symbols, compress));
+  total_count = pristine->total_count;
+  update_cycle = pristine->update_cycle;
+  symbols_until_update = pristine->symbols_until_update;
+
+  return 0;
+}
+
 void ArithmeticModel::update()
 {
   // halve counts when a threshold is reached
@@ -148,6 +191,17 @@ void ArithmeticModel::update()
     }
   }
   
+  distribute();
+
+  // set frequency of model updates
+  update_cycle = (5 * update_cycle) >> 2;
+  U32 max_cycle = (symbols + 6) << 3;
+  if (update_cycle > max_cycle) update_cycle = max_cycle;
+  symbols_until_update = update_cycle;
+}
+
+void ArithmeticModel::distribute()
+{
   // compute cumulative distribution, decoder table
   U32 k, sum = 0, s = 0;
   U32 scale = 0x80000000U / total_count;
@@ -172,12 +226,27 @@ void ArithmeticModel::update()
     decoder_table[0] = 0;
     while (s <= table_size) decoder_table[++s] = symbols - 1;
   }
-  
-  // set frequency of model updates
-  update_cycle = (5 * update_cycle) >> 2;
-  U32 max_cycle = (symbols + 6) << 3;
-  if (update_cycle > max_cycle) update_cycle = max_cycle;
-  symbols_until_update = update_cycle;
+}
+
+void ArithmeticModel::freeze(const U32* counts)
+{
+  // static distribution from counts that sum to at most DM__MaxCount
+  total_count = 0;
+  for (U32 k = 0; k < symbols; k++)
+  {
+    total_count += (symbol_count[k] = counts[k]);
+  }
+  distribute();
+
+  // no more model updates (a chunk has fewer symbols)
+  symbols_until_update = update_cycle = U32_MAX;
+}
+
+void ArithmeticModel::thaw()
+{
+  // adaptive as after init() and the one symbol since
+  update_cycle = (symbols + 6) >> 1;
+  symbols_until_update = update_cycle - 1;
 }
 
 ArithmeticBitModel::ArithmeticBitModel()
@@ -218,3 +287,183 @@ void ArithmeticBitModel::update()
   if (update_cycle > 64) update_cycle = 64;
   bits_until_update = update_cycle;
 }
+
+void ArithmeticBitModel::freeze(const U32 bit_0_prob)
+{
+  // static probability of a zero bit in (0, BM__MaxCount)
+  this->bit_0_prob = bit_0_prob;
+
+  // no more model updates (a chunk has fewer bits)
+  bits_until_update = update_cycle = U32_MAX;
+}
+
+void ArithmeticBitModel::thaw()
+{
+  // adaptive as after init() and the one bit since
+  update_cycle = 4;
+  bits_until_update = update_cycle - 1;
+}
+
+// models and their tables are placed at multiples of 8 bytes in blocks that
+// are allocated when needed (starting at 1 KB and doubling up to 4 KB) and
+// only freed by the destructor. a model larger than half a block (such as one
+// with 256 symbols) that does not fit gets an exact block of its own so that
+// no tail is cut off that nothing else fits into. what is left of a block and
+// destroyed models are reused first-fit
+
+#define ARENA_FIRST_BLOCK_SIZE 1024
+#define ARENA_MAX_BLOCK_SIZE 4096
+#define ARENA_ALIGN(size) (((size) + 7) & ~((size_t)7))
+
+ArithmeticModelArena::ArithmeticModelArena()
+{
+  blocks = 0;
+  num_blocks = 0;
+  alloc_blocks = 0;
+  block_next = 0;
+  block_end = 0;
+  block_size = ARENA_FIRST_BLOCK_SIZE;
+  released = 0;
+  pristine = 0;
+  num_pristine = 0;
+}
+
+ArithmeticModelArena::~ArithmeticModelArena()
+{
+  U32 i;
+  for (i = 0; i < num_blocks; i++)
+  {
+    free(blocks[i]);
+  }
+  if (blocks) free(blocks);
+  if (pristine) free(pristine);
+}
+
+void* ArithmeticModelArena::allocate(size_t size)
+{
+  Released** r;
+  for (r = &released; *r; r = &((*r)->next))
+  {
+    if ((*r)->size >= size)
+    {
+      Released* region = *r;
+      *r = region->next;
+      if ((region->size - size) >= sizeof(Released))
+      {
+        release((U8*)region + size, region->size - size);
+      }
+      return region;
+    }
+  }
+  if ((size_t)(block_end - block_next) < size)
+  {
+    if (num_blocks == alloc_blocks)
+    {
+      U32 alloc = (alloc_blocks ? 2 * alloc_blocks : 16);
+      U8** b = (U8**)realloc(blocks, sizeof(U8*)*alloc);
+      if (b == 0) throw std::bad_alloc();
+      blocks = b;
+      alloc_blocks = alloc;
+    }
+    if (size > ARENA_MAX_BLOCK_SIZE/2)
+    {
+      // the current block stays for the smaller models
+      U8* block = (U8*)malloc(size);
+      if (block == 0) throw std::bad_alloc();
+      blocks[num_blocks++] = block;
+      return block;
+    }
+    if ((size_t)(block_end - block_next) >= sizeof(Released))
+    {
+      release(block_next, block_end - block_next);
+    }
+    size_t num_bytes = (size > block_size ? size : block_size);
+    U8* block = (U8*)malloc(num_bytes);
+    if (block == 0) throw std::bad_alloc();
+    blocks[num_blocks++] = block;
+    block_next = block;
+    block_end = block + num_bytes;
+    if (block_size < ARENA_MAX_BLOCK_SIZE) block_size *= 2;
+  }
+  void* memory = block_next;
+  block_next += size;
+  return memory;
+}
+
+void ArithmeticModelArena::release(void* memory, size_t size)
+{
+  Released* r = (Released*)memory;
+  r->next = released;
+  r->size = size;
+  released = r;
+}
+
+ArithmeticModel* ArithmeticModelArena::createSymbolModel(U32 symbols, BOOL compress)
+{
+  U32 words = ArithmeticModel::table_words(symbols, compress);
+  if (words == 0)
+  {
+    // init() will fail just the same as without an arena
+    return new ArithmeticModel(symbols, compress);
+  }
+  size_t size = ARENA_ALIGN(sizeof(ArithmeticModel));
+  U8* memory = (U8*)allocate(size + ARENA_ALIGN(sizeof(U32)*words));
+  return new (memory) ArithmeticModel(symbols, compress, (U32*)(memory + size));
+}
+
+// resets happen for every model at the start of every chunk. computing the
+// same distribution and decoder table again and again is what makes small
+// chunks expensive, so the first model with a certain number of symbols is
+// initialized once more into a pristine copy that all later ones restore
+
+void ArithmeticModelArena::initSymbolModel(ArithmeticModel* m)
+{
+  U32 i;
+  for (i = 0; i < num_pristine; i++)
+  {
+    if ((pristine[i]->symbols == m->symbols) && (pristine[i]->compress == m->compress))
+    {
+      m->restore(pristine[i]);
+      return;
+    }
+  }
+  if (!m->in_arena)
+  {
+    // init() will fail just the same as without an arena
+    m->init();
+    return;
+  }
+  ArithmeticModel* p = createSymbolModel(m->symbols, m->compress);
+  p->init();
+  ArithmeticModel** a = (ArithmeticModel**)realloc(pristine, sizeof(ArithmeticModel*)*(num_pristine+1));
+  if (a == 0) throw std::bad_alloc();
+  pristine = a;
+  pristine[num_pristine++] = p;
+  m->restore(p);
+}
+
+void ArithmeticModelArena::destroySymbolModel(ArithmeticModel* m)
+{
+  if (m->in_arena)
+  {
+    size_t size = ARENA_ALIGN(sizeof(ArithmeticModel)) + ARENA_ALIGN(sizeof(U32)*ArithmeticModel::table_words(m->symbols, m->compress));
+    m->~ArithmeticModel();
+    release(m, size);
+  }
+  else
+  {
+    delete m;
+  }
+}
+
+ArithmeticBitModel* ArithmeticModelArena::createBitModel()
+{
+  void* memory = allocate(ARENA_ALIGN(sizeof(ArithmeticBitModel)));
+  return new (memory) ArithmeticBitModel();
+}
+
+void ArithmeticModelArena::destroyBitModel(ArithmeticBitModel* m)
+{
+  m->~ArithmeticBitModel();
+  release(m, ARENA_ALIGN(sizeof(ArithmeticBitModel)));
+}
@@ -25,6 +25,11 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- models that a static chunk leaves adaptive can thaw
+    16 October 2026 -- chunk resets copy the tables of a pristine model instead of computing them
+    16 October 2026 -- ArithmeticModelArena places models and their tables next to each other
+    16 October 2026 -- models can be frozen with a static distribution
+    16 October 2026 -- constants for the interleaved rANS coder
     11 April 2019 -- 1024 AC_BUFFER_SIZE to 4096 for propagate_carry() overflow
     10 January 2011 -- licensing change for LGPL release and liblas integration
     8 December 2010 -- unified framework for all entropy coders
@@ -58,19 +63,32 @@ const U32 DM__MaxCount    = 1 << DM__LengthShift;  // for adaptive models
 class ArithmeticModel
 {
 public:
-  ArithmeticModel(U32 symbols, BOOL compress);
+  ArithmeticModel(U32 symbols, BOOL compress, U32* tables=0);
   ~ArithmeticModel();
 
   I32 init(U32* table=0);
 
+  // same as init() without a table but copies the tables and counters of a
+  // model with as many symbols that already was initialized that way
+  I32 restore(const ArithmeticModel* pristine);
+
+  // how many U32 the tables need (zero for an invalid number of symbols)
+  static U32 table_words(U32 symbols, BOOL compress);
+
 private:
+  I32 layout(U32* tables);
   void update();
+  void distribute();
+  void freeze(const U32* counts);
+  void thaw();
   U32 * distribution, * symbol_count, * decoder_table;
   U32 total_count, update_cycle, symbols_until_update;
   U32 symbols, last_symbol, table_size, table_shift;
   BOOL compress;
+  BOOL in_arena;
   friend class ArithmeticEncoder;
   friend class ArithmeticDecoder;
+  friend class ArithmeticModelArena;
 };
 
 class ArithmeticBitModel
@@ -83,10 +101,56 @@ public:
 
 private:
   void update();
+  void freeze(const U32 bit_0_prob);
+  void thaw();
   U32 update_cycle, bits_until_update;
   U32 bit_0_prob, bit_0_count, bit_count;
   friend class ArithmeticEncoder;
   friend class ArithmeticDecoder;
 };
 
+// hands out the models of one encoder or decoder together with their tables
+// from shared blocks so that they lie next to each other in memory and are
+// all freed at once when the arena is deleted
+
+class ArithmeticModelArena
+{
+public:
+  ArithmeticModelArena();
+  ~ArithmeticModelArena();
+
+  ArithmeticModel* createSymbolModel(U32 symbols, BOOL compress);
+  void initSymbolModel(ArithmeticModel* model);
+  void destroySymbolModel(ArithmeticModel* model);
+
+  ArithmeticBitModel* createBitModel();
+  void destroyBitModel(ArithmeticBitModel* model);
+
+private:
+  void* allocate(size_t size);
+  void release(void* memory, size_t size);
+
+  U8** blocks;
+  U32 num_blocks;
+  U32 alloc_blocks;
+  U8* block_next;
+  U8* block_end;
+  size_t block_size;
+
+  // tails of blocks and destroyed models whose memory is handed out again
+
+  struct Released
+  {
+    Released* next;
+    size_t size;
+  };
+
+  Released* released;
+
+  // one initialized model per number of symbols that is restored from
+
+  ArithmeticModel** pristine;
+  U32 num_pristine;
+};
+
 #endif
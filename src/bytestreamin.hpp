@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- optional window of bytes that decoders read without virtual calls
      2 January 2013 -- new functions for reading a stream of groups of bits  
      1 October 2011 -- added 64 bit file support in MSVC 6.0 at McCafe at Hbf Linz
     10 January 2011 -- licensing change for LGPL release and liblas integration
@@ -78,6 +79,10 @@ public:
   virtual BOOL seek(const I64 position) = 0;
 /* seek to the end of the file                               */
   virtual BOOL seekEnd(const I64 distance=0) = 0;
+/* get window of bytes at current position (0 if no window) */
+  virtual const U8* getWindow(U32& num_bytes) { num_bytes = 0; return 0; };
+/* move current position past bytes read from the window     */
+  virtual void skipWindow(const U32 num_bytes) {};
 /* seek to the end of the file                               */
   virtual BOOL skipBytes(const U32 num_bytes) { I64 curr = tell(); return seek(curr + num_bytes); };
 /* constructor                                               */
@@ -22,6 +22,7 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- the remaining bytes are a window that decoders read directly
     23 June 2016 -- alternative init option for "native LAS 1.4 compressor"
     19 July 2015 -- moved from LASlib to LASzip for "compatibility mode" in DLL
      9 April 2012 -- created after cooking Zuccini/Onion/Potatoe dinner for Mara
@@ -55,6 +56,10 @@ public:
   BOOL seek(const I64 position);
 /* seek to the end of the stream                             */
   BOOL seekEnd(const I64 distance=0);
+/* get window of bytes at current position                   */
+  const U8* getWindow(U32& num_bytes);
+/* move current position past bytes read from the window     */
+  void skipWindow(const U32 num_bytes);
 /* destructor                                                */
   ~ByteStreamInArray(){};
 protected:
@@ -185,6 +190,17 @@ inline BOOL ByteStreamInArray::seekEnd(const I64 distance)
   return FALSE;
 }
 
+inline const U8* ByteStreamInArray::getWindow(U32& num_bytes)
+{
+  num_bytes = ((size - curr) < (I64)U32_MAX ? (U32)(size - curr) : U32_MAX);
+  return data + curr;
+}
+
+inline void ByteStreamInArray::skipWindow(const U32 num_bytes)
+{
+  curr += num_bytes;
+}
+
 inline ByteStreamInArrayLE::ByteStreamInArrayLE() : ByteStreamInArray()
 {
 }
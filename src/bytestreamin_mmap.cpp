@@ -0,0 +1,113 @@
+/*
+===============================================================================
+
+  FILE:  bytestreamin_mmap.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include "bytestreamin_mmap.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// how far ahead of a seek the pages are requested from the OS
+#define MMAP_WILLNEED_WINDOW 4194304
+
+ByteStreamInMmap::ByteStreamInMmap(FILE* file) : ByteStreamInArray()
+{
+  view = 0;
+  mapping = 0;
+  if (file == 0) return;
+#ifdef _WIN32
+  HANDLE handle = (HANDLE)_get_osfhandle(_fileno(file));
+  if (handle == INVALID_HANDLE_VALUE) return;
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(handle, &file_size) || (file_size.QuadPart <= 0)) return;
+  if ((sizeof(SIZE_T) < 8) && (file_size.QuadPart > (LONGLONG)0x7FFFFFFF)) return;
+  mapping = CreateFileMapping(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping == NULL)
+  {
+    mapping = 0;
+    return;
+  }
+  view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (view == NULL)
+  {
+    CloseHandle(mapping);
+    mapping = 0;
+    view = 0;
+    return;
+  }
+  init((const U8*)view, (I64)file_size.QuadPart);
+#else
+  int fd = fileno(file);
+  if (fd < 0) return;
+  struct stat st;
+  if ((fstat(fd, &st) != 0) || !S_ISREG(st.st_mode) || (st.st_size <= 0)) return;
+  if ((sizeof(size_t) < 8) && ((I64)st.st_size > (I64)0x7FFFFFFF)) return;
+  void* v = mmap(0, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (v == MAP_FAILED) return;
+  // the points are mostly read front to back so let the OS read ahead aggressively
+  madvise(v, (size_t)st.st_size, MADV_SEQUENTIAL);
+  view = v;
+  init((const U8*)view, (I64)st.st_size);
+#endif
+}
+
+BOOL ByteStreamInMmap::seek(const I64 position)
+{
+  if (!ByteStreamInArray::seek(position)) return FALSE;
+#ifndef _WIN32
+  // after a seek (e.g. to the chunk table or to the next spatially indexed
+  // interval) ask for the pages at the new position before we fault on them
+  if (view)
+  {
+    static const I64 page_size = (I64)sysconf(_SC_PAGESIZE);
+    I64 start = position - (position % page_size);
+    I64 length = size - start;
+    if (length > MMAP_WILLNEED_WINDOW) length = MMAP_WILLNEED_WINDOW;
+    if (length > 0) madvise((U8*)view + start, (size_t)length, MADV_WILLNEED);
+  }
+#endif
+  return TRUE;
+}
+
+ByteStreamInMmap::~ByteStreamInMmap()
+{
+#ifdef _WIN32
+  if (view) UnmapViewOfFile(view);
+  if (mapping) CloseHandle(mapping);
+#else
+  if (view) munmap(view, (size_t)size);
+#endif
+}
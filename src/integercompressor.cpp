@@ -317,6 +317,44 @@ void IntegerCompressor::initDecompressor()
 #endif
 }
 
+void IntegerCompressor::saveDecompressor(ByteStreamOut* stream) const
+{
+  U32 i;
+
+  assert(dec && mBits);
+
+  for (i = 0; i < contexts; i++)
+  {
+    dec->saveSymbolModel(stream, mBits[i]);
+  }
+#ifndef COMPRESS_ONLY_K
+  dec->saveBitModel(stream, (ArithmeticBitModel*)mCorrector[0]);
+  for (i = 1; i <= corr_bits; i++)
+  {
+    dec->saveSymbolModel(stream, mCorrector[i]);
+  }
+#endif
+}
+
+void IntegerCompressor::loadDecompressor(ByteStreamIn* stream)
+{
+  U32 i;
+
+  assert(dec && mBits);
+
+  for (i = 0; i < contexts; i++)
+  {
+    dec->loadSymbolModel(stream, mBits[i]);
+  }
+#ifndef COMPRESS_ONLY_K
+  dec->loadBitModel(stream, (ArithmeticBitModel*)mCorrector[0]);
+  for (i = 1; i <= corr_bits; i++)
+  {
+    dec->loadSymbolModel(stream, mCorrector[i]);
+  }
+#endif
+}
+
 I32 IntegerCompressor::decompress(I32 pred, U32 context)
 {
   assert(dec);
@@ -36,6 +36,8 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- IntegerCompressorFixed for a number of bits known at compile time
+    16 October 2026 -- save and load the state of the decompressor for checkpoints
      6 September 2014 -- removed inheritance of EntropyEncoder and EntropyDecoder
     10 January 2011 -- licensing change for LGPL release and liblas integration
     10 December 2010 -- unified for all entropy coders at Baeckerei Schaefer
@@ -51,6 +53,8 @@
 #include "arithmeticencoder.hpp"
 #include "arithmeticdecoder.hpp"
 
+#include <assert.h>
+
 class IntegerCompressor
 {
 public:
@@ -68,10 +72,14 @@ public:
   void initDecompressor();
   I32 decompress(I32 iPred, U32 context=0);
 
+  // Save and load the state of an initialized Decompressor
+  void saveDecompressor(ByteStreamOut* stream) const;
+  void loadDecompressor(ByteStreamIn* stream);
+
   // Get the k corrector bits from the last compress/decompress call
   U32 getK() const {return k;};
 
-private:
+protected:
   void writeCorrector(I32 c, ArithmeticModel* model);
   I32 readCorrector(ArithmeticModel* model);
 
@@ -100,4 +108,123 @@ private:
 #endif
 };
 
+// the same compressor for a number of bits (and of compressed high bits) that
+// is known at compile time. the range of the corrector and the split into
+// compressed and raw bits become constants and compress() and decompress()
+// are inlined into the item coders. the compressed data is identical
+
+template <U32 BITS, U32 BITS_HIGH = 8>
+class IntegerCompressorFixed : public IntegerCompressor
+{
+public:
+
+  IntegerCompressorFixed(ArithmeticEncoder* enc, U32 contexts=1) : IntegerCompressor(enc, BITS, contexts, BITS_HIGH) {};
+  IntegerCompressorFixed(ArithmeticDecoder* dec, U32 contexts=1) : IntegerCompressor(dec, BITS, contexts, BITS_HIGH) {};
+
+  inline void compress(I32 pred, I32 real, U32 context=0);
+  inline I32 decompress(I32 pred, U32 context=0);
+
+private:
+  static const U32 CORR_RANGE = ((BITS && (BITS < 32)) ? (1u << BITS) : 0);
+  static const I32 CORR_MIN = (CORR_RANGE ? -((I32)(CORR_RANGE/2)) : I32_MIN);
+  static const I32 CORR_MAX = (CORR_RANGE ? (I32)(CORR_RANGE/2) - 1 : I32_MAX);
+};
+
+template <U32 BITS, U32 BITS_HIGH>
+inline void IntegerCompressorFixed<BITS, BITS_HIGH>::compress(I32 pred, I32 real, U32 context)
+{
+#ifdef COMPRESS_ONLY_K
+  IntegerCompressor::compress(pred, real, context);
+#else
+  assert(enc);
+  // the corrector will be within the interval [ - (corr_range - 1)  ...  + (corr_range - 1) ]
+  I32 c = real - pred;
+  // we fold the corrector into the interval [ corr_min  ...  corr_max ]
+  if (CORR_RANGE)
+  {
+    if (c < CORR_MIN) c += CORR_RANGE;
+    else if (c > CORR_MAX) c -= CORR_RANGE;
+  }
+  // find the tighest interval [ - (2^k - 1)  ...  + (2^k) ] that contains c
+  U32 c1 = (c <= 0 ? -c : c-1);
+  k = 0;
+  while (c1)
+  {
+    c1 = c1 >> 1;
+    k = k + 1;
+  }
+  enc->encodeSymbol(mBits[context], k);
+  if (k) // then c is either smaller than 0 or bigger than 1
+  {
+    if (k < 32)
+    {
+      // translate the corrector c into the k-bit interval [ 0 ... 2^k - 1 ]
+      if (c < 0) c += ((1<<k) - 1);
+      else c -= 1;
+      if (k <= BITS_HIGH) // for small k we code the interval in one step
+      {
+        enc->encodeSymbol(mCorrector[k], c);
+      }
+      else // for larger k the higher bits with the range coder and the lower k1 bits raw
+      {
+        U32 k1 = k-BITS_HIGH;
+        enc->encodeSymbol(mCorrector[k], c >> k1);
+        enc->writeBits(k1, c & ((1<<k1) - 1));
+      }
+    }
+  }
+  else // then c is 0 or 1
+  {
+    enc->encodeBit((ArithmeticBitModel*)mCorrector[0], c);
+  }
+#endif
+}
+
+template <U32 BITS, U32 BITS_HIGH>
+inline I32 IntegerCompressorFixed<BITS, BITS_HIGH>::decompress(I32 pred, U32 context)
+{
+#ifdef COMPRESS_ONLY_K
+  return IntegerCompressor::decompress(pred, context);
+#else
+  assert(dec);
+  I32 c;
+  // decode within which interval the corrector is falling
+  k = dec->decodeSymbol(mBits[context]);
+  if (k) // then c is either smaller than 0 or bigger than 1
+  {
+    if (k < 32)
+    {
+      if (k <= BITS_HIGH) // for small k we can do this in one step
+      {
+        c = dec->decodeSymbol(mCorrector[k]);
+      }
+      else // for larger k the higher bits with the range coder and the lower k1 bits raw
+      {
+        U32 k1 = k-BITS_HIGH;
+        c = dec->decodeSymbol(mCorrector[k]);
+        c = (c << k1) | dec->readBits(k1);
+      }
+      // translate c back into its correct interval
+      if (c >= (1<<(k-1))) c += 1;
+      else c -= ((1<<k) - 1);
+    }
+    else
+    {
+      c = CORR_MIN;
+    }
+  }
+  else // then c is either 0 or 1
+  {
+    c = dec->decodeBit((ArithmeticBitModel*)mCorrector[0]);
+  }
+  I32 real = pred + c;
+  if (CORR_RANGE)
+  {
+    if (real < 0) real += CORR_RANGE;
+    else if ((U32)(real) >= CORR_RANGE) real -= CORR_RANGE;
+  }
+  return real;
+#endif
+}
+
 #endif
@@ -24,6 +24,9 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- layered readers can decompress more layers from one chunk to the next
+    16 October 2026 -- optional saving and loading of the state for seek checkpoints
+    16 October 2026 -- layered readers learn the number of points in the chunk
     28 August 2017 -- moving 'context' from global development hack to interface  
     23 August 2016 -- layering of items for selective decompression in LAS 1.4 
     10 January 2011 -- licensing change for LGPL release and liblas integration
@@ -37,6 +40,7 @@
 #include "mydefs.hpp"
 
 class ByteStreamIn;
+class ByteStreamOut;
 
 class LASreadItem
 {
@@ -68,7 +72,14 @@ class LASreadItemCompressed : public LASreadItem
 {
 public:
   virtual BOOL chunk_sizes() { return FALSE; };
+  virtual void set_chunk_count(const U32 count) {};
   virtual BOOL init(const U8* item, U32& context)=0;
+  // optional: save and load the state between two points of a chunk
+  virtual BOOL save_state(ByteStreamOut* stream) { return FALSE; };
+  virtual BOOL load_state(ByteStreamIn* stream) { return FALSE; };
+  // optional: also decompress these layers (in addition to those selected when
+  // the reader was created) starting with the next init(). zero undoes this
+  virtual void request_layers(const U32 decompress_selective) {};
 
   virtual ~LASreadItemCompressed(){};
 };
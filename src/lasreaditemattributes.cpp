@@ -0,0 +1,634 @@
+/*
+===============================================================================
+
+  FILE:  lasreaditemattributes.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include "lasreaditemattributes.hpp"
+#include "bytestreamout.hpp"
+
+#include <assert.h>
+#include <string.h>
+
+LASreadItemAttributes::LASreadItemAttributes(ArithmeticDecoder* dec, U32 number, const U32 decompress_selective, const U32 num_selective_bytes, const BOOL* selective_bytes)
+{
+  /* not used as a decoder. just gives access to instream and reports errors */
+
+  assert(dec);
+  this->dec = dec;
+
+  /* must be more than one byte */
+
+  assert(number);
+  this->number = number;
+
+  /* the layout comes with the first chunk. there is at most one layer per byte */
+
+  num_layers = 0;
+  layers = new LASattributeLayer[number];
+
+  num_values = 0;
+  values = new LASattributeValue[number];
+
+  num_changed_values = 0;
+  changed_values = new U32[number];
+
+  /* zero instream and decoder pointer arrays */
+
+  instream_layers = 0;
+
+  dec_layers = 0;
+
+  /* create and init num_bytes and booleans arrays */
+
+  num_bytes_layers = new U32[number];
+
+  changed_layers = new BOOL[number];
+
+  requested_layers = new BOOL[number];
+
+  selected_bytes = new BOOL[number];
+
+  requested_bytes = new BOOL[number];
+
+  U32 i;
+  for (i = 0; i < number; i++)
+  {
+    num_bytes_layers[i] = 0;
+
+    changed_layers[i] = FALSE;
+
+    requested_layers[i] = TRUE;
+
+    if (selective_bytes) // the requested bytes override the BYTE flags of decompress_selective
+    {
+      selected_bytes[i] = ((i < num_selective_bytes) && selective_bytes[i]);
+    }
+    else if (i > 15) // the BYTE flags only select among the first 16 extra bytes
+    {
+      selected_bytes[i] = TRUE;
+    }
+    else
+    {
+      selected_bytes[i] = (decompress_selective & (LASZIP_DECOMPRESS_SELECTIVE_BYTE0 << i) ? TRUE : FALSE);
+    }
+
+    requested_bytes[i] = selected_bytes[i];
+  }
+
+  /* init the bytes buffer to zero */
+
+  bytes = 0;
+  num_bytes_allocated = 0;
+
+  /* mark the four scanner channel contexts as uninitialized */
+
+  U32 c;
+  for (c = 0; c < 4; c++)
+  {
+    contexts[c].m_bytes = 0;
+  }
+  current_context = 0;
+}
+
+LASreadItemAttributes::~LASreadItemAttributes()
+{
+  /* destroy all initialized scanner channel contexts */
+
+  U32 c, i, b;
+  for (c = 0; c < 4; c++)
+  {
+    if (contexts[c].m_bytes)
+    {
+      for (i = 0; i < num_values; i++)
+      {
+        if (contexts[c].m_bytes[i]) dec_layers[values[i].layer]->destroySymbolModel(contexts[c].m_bytes[i]);
+        for (b = 0; b < 16; b++)
+        {
+          if (contexts[c].m_diff_bytes[16*i+b]) dec_layers[values[i].layer]->destroySymbolModel(contexts[c].m_diff_bytes[16*i+b]);
+        }
+        if (contexts[c].ic_values[i]) delete contexts[c].ic_values[i];
+        if (contexts[c].m_no_data[i]) dec_layers[values[i].layer]->destroyBitModel(contexts[c].m_no_data[i]);
+      }
+      delete [] contexts[c].m_bytes;
+      delete [] contexts[c].m_diff_bytes;
+      delete [] contexts[c].ic_values;
+      delete [] contexts[c].m_no_data;
+      delete [] contexts[c].last_item;
+    }
+  }
+
+  /* destroy all instream and decoder arrays */
+
+  if (instream_layers)
+  {
+    for (i = 0; i < num_layers; i++)
+    {
+      if (instream_layers[i])
+      {
+        delete instream_layers[i];
+        delete dec_layers[i];
+      }
+    }
+
+    delete [] instream_layers;
+    delete [] dec_layers;
+  }
+
+  /* destroy all other arrays */
+
+  delete [] num_bytes_layers;
+  delete [] changed_layers;
+  delete [] requested_layers;
+  delete [] selected_bytes;
+  delete [] requested_bytes;
+  delete [] changed_values;
+  delete [] values;
+  delete [] layers;
+
+  if (bytes) delete [] bytes;
+}
+
+inline BOOL LASreadItemAttributes::createAndInitModelsAndDecompressors(U32 context, const U8* item)
+{
+  U32 i, b;
+
+  /* should only be called when context is unused */
+
+  assert(contexts[context].unused);
+
+  /* first create all entropy models, integer decompressors and last items (if needed) */
+
+  if (contexts[context].m_bytes == 0)
+  {
+    contexts[context].m_bytes = new ArithmeticModel*[num_values];
+    contexts[context].m_diff_bytes = new ArithmeticModel*[16*num_values];
+    contexts[context].ic_values = new IntegerCompressor*[num_values];
+    contexts[context].m_no_data = new ArithmeticBitModel*[num_values];
+    for (i = 0; i < num_values; i++)
+    {
+      ArithmeticDecoder* dec_layer = dec_layers[values[i].layer];
+      contexts[context].m_bytes[i] = 0;
+      for (b = 0; b < 16; b++)
+      {
+        contexts[context].m_diff_bytes[16*i+b] = 0;
+      }
+      contexts[context].ic_values[i] = 0;
+      contexts[context].m_no_data[i] = 0;
+      switch (values[i].kind)
+      {
+      case LASZIP_ATTRIBUTE_BYTE:
+        contexts[context].m_bytes[i] = dec_layer->createSymbolModel(256);
+        break;
+      case LASZIP_ATTRIBUTE_INT16:
+        contexts[context].ic_values[i] = new IntegerCompressor(dec_layer, 16);
+        break;
+      case LASZIP_ATTRIBUTE_INT32:
+        contexts[context].ic_values[i] = new IntegerCompressor(dec_layer, 32);
+        break;
+      default:
+        // the number of significant bytes of the difference and the bytes
+        contexts[context].m_bytes[i] = dec_layer->createSymbolModel(laszip_attribute_kind_size(values[i].kind) + 1);
+        for (b = 0; b < 2*laszip_attribute_kind_size(values[i].kind); b++)
+        {
+          contexts[context].m_diff_bytes[16*i+b] = dec_layer->createSymbolModel(256);
+        }
+        break;
+      }
+      if (values[i].has_no_data)
+      {
+        contexts[context].m_no_data[i] = dec_layer->createBitModel();
+      }
+    }
+
+    /* create last item */
+    contexts[context].last_item = new U8[number];
+  }
+
+  /* then init entropy models and integer decompressors */
+
+  for (i = 0; i < num_values; i++)
+  {
+    ArithmeticDecoder* dec_layer = dec_layers[values[i].layer];
+    if (contexts[context].m_bytes[i]) dec_layer->initSymbolModel(contexts[context].m_bytes[i]);
+    for (b = 0; b < 16; b++)
+    {
+      if (contexts[context].m_diff_bytes[16*i+b]) dec_layer->initSymbolModel(contexts[context].m_diff_bytes[16*i+b]);
+    }
+    if (contexts[context].ic_values[i]) contexts[context].ic_values[i]->initDecompressor();
+    if (contexts[context].m_no_data[i]) dec_layer->initBitModel(contexts[context].m_no_data[i]);
+  }
+
+  /* init current context from item */
+
+  memcpy(contexts[context].last_item, item, number);
+
+  contexts[context].unused = FALSE;
+
+  return TRUE;
+}
+
+BOOL LASreadItemAttributes::chunk_sizes()
+{
+  U32 i, count;
+  U8 layout[4];
+  LASattributeLayer layer;
+
+  /* for layered compression 'dec' only hands over the stream */
+
+  ByteStreamIn* instream = dec->getByteStreamIn();
+
+  /* read the layout and the bytes per layer */
+
+  instream->get32bitsLE((U8*)&count);
+  if ((count == 0) || (count > number) || (num_layers && (count != num_layers)))
+  {
+    dec->reportError(4711);
+    return FALSE;
+  }
+  for (i = 0; i < count; i++)
+  {
+    instream->getBytes(layout, 4);
+    layer.kind = layout[0];
+    layer.count = layout[1];
+    layer.has_no_data = (layout[2] ? TRUE : FALSE);
+    layer.no_data = 0;
+    if (layer.has_no_data)
+    {
+      instream->get64bitsLE((U8*)&(layer.no_data));
+    }
+    instream->get32bitsLE((U8*)&(num_bytes_layers[i]));
+    if (num_layers == 0)
+    {
+      layers[i] = layer;
+    }
+    else if ((layers[i].kind != layer.kind) || (layers[i].count != layer.count) || (layers[i].has_no_data != layer.has_no_data) || (layers[i].no_data != layer.no_data))
+    {
+      dec->reportError(4711);
+      return FALSE;
+    }
+  }
+
+  /* the first chunk sets the layout */
+
+  if (num_layers == 0)
+  {
+    num_values = laszip_attribute_values(count, layers, number, values);
+    if (num_values == 0)
+    {
+      dec->reportError(4711);
+      return FALSE;
+    }
+    num_layers = count;
+
+    select_layers();
+  }
+
+  return TRUE;
+}
+
+BOOL LASreadItemAttributes::init(const U8* item, U32& context)
+{
+  U32 i;
+
+  /* without a layout there is nothing to decode */
+
+  if (num_values == 0) return FALSE;
+
+  /* for layered compression 'dec' only hands over the stream */
+
+  ByteStreamIn* instream = dec->getByteStreamIn();
+
+  /* on the first init create instreams and decoders */
+
+  if (instream_layers == 0)
+  {
+    /* create instream pointer array */
+
+    instream_layers = new ByteStreamInArray*[num_layers];
+
+    /* create instreams */
+
+    if (IS_LITTLE_ENDIAN())
+    {
+      for (i = 0; i < num_layers; i++)
+      {
+        instream_layers[i] = new ByteStreamInArrayLE();
+      }
+    }
+    else
+    {
+      for (i = 0; i < num_layers; i++)
+      {
+        instream_layers[i] = new ByteStreamInArrayBE();
+      }
+    }
+
+    /* create decoder pointer array */
+
+    dec_layers = new ArithmeticDecoder*[num_layers];
+
+    /* create layer decoders */
+
+    for (i = 0; i < num_layers; i++)
+    {
+      dec_layers[i] = new ArithmeticDecoder(dec->getCoder());
+      dec_layers[i]->setStatus(dec->getStatus());
+    }
+  }
+
+  /* how many bytes do we need to read */
+
+  U32 num_bytes = 0;
+
+  for (i = 0; i < num_layers; i++)
+  {
+    if (requested_layers[i]) num_bytes += num_bytes_layers[i];
+  }
+
+  /* make sure the buffer is sufficiently large */
+
+  if (num_bytes > num_bytes_allocated)
+  {
+    if (bytes) delete [] bytes;
+    bytes = new U8[num_bytes];
+    if (bytes == 0) return FALSE;
+    num_bytes_allocated = num_bytes;
+  }
+
+  /* load the requested bytes and init the corresponding instreams an decoders */
+
+  num_bytes = 0;
+  for (i = 0; i < num_layers; i++)
+  {
+    if (requested_layers[i])
+    {
+      if (num_bytes_layers[i])
+      {
+        instream->getBytes(&(bytes[num_bytes]), num_bytes_layers[i]);
+        instream_layers[i]->init(&(bytes[num_bytes]), num_bytes_layers[i]);
+        dec_layers[i]->init(instream_layers[i]);
+        num_bytes += num_bytes_layers[i];
+        changed_layers[i] = TRUE;
+      }
+      else
+      {
+        dec_layers[i]->init(0, 0);
+        changed_layers[i] = FALSE;
+      }
+    }
+    else
+    {
+      if (num_bytes_layers[i])
+      {
+        instream->skipBytes(num_bytes_layers[i]);
+      }
+      changed_layers[i] = FALSE;
+    }
+  }
+
+  /* only the values of changed layers need to be decoded */
+
+  num_changed_values = 0;
+  for (i = 0; i < num_values; i++)
+  {
+    if (changed_layers[values[i].layer]) changed_values[num_changed_values++] = i;
+  }
+
+  /* mark the four scanner channel contexts as unused */
+
+  U32 c;
+  for (c = 0; c < 4; c++)
+  {
+    contexts[c].unused = TRUE;
+  }
+
+  /* set scanner channel as current context */
+
+  current_context = context; // all other items use context set by POINT14 reader
+
+  /* create and init models and decompressors */
+
+  createAndInitModelsAndDecompressors(current_context, item);
+
+  return TRUE;
+}
+
+void LASreadItemAttributes::read(U8* item, U32& context)
+{
+  // get last
+
+  U8* last_item = contexts[current_context].last_item;
+
+  // check for context switch
+
+  if (current_context != context)
+  {
+    current_context = context; // all other items use context set by POINT14 reader
+    if (contexts[current_context].unused)
+    {
+      createAndInitModelsAndDecompressors(current_context, (U8*)last_item);
+    }
+    last_item = contexts[current_context].last_item;
+  }
+
+  // the values of unchanged layers are those of the last item
+
+  memcpy(item, last_item, number);
+
+  // decompress the values of changed layers
+
+  U32 j;
+  for (j = 0; j < num_changed_values; j++)
+  {
+    const U32 i = changed_values[j];
+    switch (values[i].kind)
+    {
+    case LASZIP_ATTRIBUTE_BYTE:
+      {
+        const U32 offset = values[i].offset;
+        I32 diff = last_item[offset] + dec_layers[values[i].layer]->decodeSymbol(contexts[current_context].m_bytes[i]);
+        item[offset] = U8_FOLD(diff);
+        last_item[offset] = item[offset];
+      }
+      break;
+    case LASZIP_ATTRIBUTE_INT16:
+      read_value(i, item, last_item, 2);
+      break;
+    case LASZIP_ATTRIBUTE_INT32:
+    case LASZIP_ATTRIBUTE_FLOAT32:
+      read_value(i, item, last_item, 4);
+      break;
+    default:
+      read_value(i, item, last_item, 8);
+      break;
+    }
+  }
+}
+
+inline void LASreadItemAttributes::read_value(const U32 i, U8* item, U8* last_item, const U32 size)
+{
+  const LASattributeValue* value = &values[i];
+  LAScontextATTRIBUTES* current = &contexts[current_context];
+  ArithmeticDecoder* dec_layer = dec_layers[value->layer];
+  if (value->has_no_data && dec_layer->decodeBit(current->m_no_data[i]))
+  {
+    // no_data values do not become the prediction
+    laszip_attribute_set(item + value->offset, size, value->no_data);
+    return;
+  }
+  U64 pred = laszip_attribute_get(last_item + value->offset, size);
+  U64 real;
+  if (current->ic_values[i])
+  {
+    real = (U32)current->ic_values[i]->decompress((I32)(U32)pred);
+  }
+  else
+  {
+    U64 zigzag = 0;
+    U32 b, n = dec_layer->decodeSymbol(current->m_bytes[i]);
+    for (b = 0; b < n; b++)
+    {
+      zigzag |= ((U64)dec_layer->decodeSymbol(current->m_diff_bytes[16*i+2*b+(b+1 == n)])) << (8*b);
+    }
+    real = laszip_attribute_unorder(value->kind, laszip_attribute_order(value->kind, pred) + laszip_attribute_unzigzag(zigzag));
+  }
+  laszip_attribute_set(item + value->offset, size, real);
+  laszip_attribute_set(last_item + value->offset, size, real);
+}
+
+void LASreadItemAttributes::request_layers(const U32 decompress_selective)
+{
+  U32 i;
+  for (i = 0; i < number; i++)
+  {
+    requested_bytes[i] = (selected_bytes[i] || ((i < 16) && (decompress_selective & (LASZIP_DECOMPRESS_SELECTIVE_BYTE0 << i))));
+  }
+  select_layers();
+}
+
+// a layer is requested if one of its bytes is
+
+void LASreadItemAttributes::select_layers()
+{
+  U32 i, b;
+  for (i = 0; i < num_layers; i++)
+  {
+    requested_layers[i] = FALSE;
+  }
+  for (i = 0; i < num_values; i++)
+  {
+    for (b = values[i].offset; b < values[i].offset + laszip_attribute_kind_size(values[i].kind); b++)
+    {
+      if (requested_bytes[b])
+      {
+        requested_layers[values[i].layer] = TRUE;
+      }
+    }
+  }
+}
+
+BOOL LASreadItemAttributes::save_state(ByteStreamOut* stream)
+{
+  U32 c, i, b;
+
+  /* save the contexts that are in use */
+
+  stream->putBytes((const U8*)&current_context, sizeof(U32));
+  for (c = 0; c < 4; c++)
+  {
+    stream->putByte(contexts[c].unused ? 1 : 0);
+    if (contexts[c].unused) continue;
+    stream->putBytes(contexts[c].last_item, number);
+    for (i = 0; i < num_values; i++)
+    {
+      ArithmeticDecoder* dec_layer = dec_layers[values[i].layer];
+      if (contexts[c].m_bytes[i]) dec_layer->saveSymbolModel(stream, contexts[c].m_bytes[i]);
+      for (b = 0; b < 16; b++)
+      {
+        if (contexts[c].m_diff_bytes[16*i+b]) dec_layer->saveSymbolModel(stream, contexts[c].m_diff_bytes[16*i+b]);
+      }
+      if (contexts[c].ic_values[i]) contexts[c].ic_values[i]->saveDecompressor(stream);
+      if (contexts[c].m_no_data[i]) dec_layer->saveBitModel(stream, contexts[c].m_no_data[i]);
+    }
+  }
+
+  /* save where the decoders are in their layers */
+
+  for (i = 0; i < num_layers; i++)
+  {
+    if (changed_layers[i]) dec_layers[i]->saveState(stream);
+  }
+
+  return TRUE;
+}
+
+BOOL LASreadItemAttributes::load_state(ByteStreamIn* stream)
+{
+  U32 c, i, b;
+  U8* last_item = new U8[number];
+
+  /* load the contexts that are in use */
+
+  stream->getBytes((U8*)&current_context, sizeof(U32));
+  for (c = 0; c < 4; c++)
+  {
+    if (stream->getByte())
+    {
+      contexts[c].unused = TRUE;
+      continue;
+    }
+    stream->getBytes(last_item, number);
+    if (contexts[c].unused)
+    {
+      createAndInitModelsAndDecompressors(c, last_item);
+    }
+    memcpy(contexts[c].last_item, last_item, number);
+    for (i = 0; i < num_values; i++)
+    {
+      ArithmeticDecoder* dec_layer = dec_layers[values[i].layer];
+      if (contexts[c].m_bytes[i]) dec_layer->loadSymbolModel(stream, contexts[c].m_bytes[i]);
+      for (b = 0; b < 16; b++)
+      {
+        if (contexts[c].m_diff_bytes[16*i+b]) dec_layer->loadSymbolModel(stream, contexts[c].m_diff_bytes[16*i+b]);
+      }
+      if (contexts[c].ic_values[i]) contexts[c].ic_values[i]->loadDecompressor(stream);
+      if (contexts[c].m_no_data[i]) dec_layer->loadBitModel(stream, contexts[c].m_no_data[i]);
+    }
+  }
+  delete [] last_item;
+
+  /* move the decoders to where they were in their layers */
+
+  for (i = 0; i < num_layers; i++)
+  {
+    if (changed_layers[i] && !dec_layers[i]->loadState(stream)) return FALSE;
+  }
+
+  return TRUE;
+}
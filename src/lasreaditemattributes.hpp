@@ -0,0 +1,102 @@
+/*
+===============================================================================
+
+  FILE:  lasreaditemattributes.hpp
+
+  CONTENTS:
+
+    Reads the extra bytes of LAS 1.4 points attribute by attribute with a
+    layer per attribute (see laszip_common_attributes.hpp)
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- more layers can be requested from one chunk to the next
+    16 October 2026 -- selective decompression of the attributes of any of the extra bytes
+    16 October 2026 -- created to code typed extra bytes with whole values
+
+===============================================================================
+*/
+#ifndef LAS_READ_ITEM_ATTRIBUTES_HPP
+#define LAS_READ_ITEM_ATTRIBUTES_HPP
+
+#include "lasreaditem.hpp"
+#include "arithmeticdecoder.hpp"
+#include "integercompressor.hpp"
+#include "bytestreamin_array.hpp"
+
+#include "laszip_common_attributes.hpp"
+#include "laszip_decompress_selective_v3.hpp"
+
+class LASreadItemAttributes : public LASreadItemCompressed
+{
+public:
+
+  LASreadItemAttributes(ArithmeticDecoder* dec, U32 number, const U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL, const U32 num_selective_bytes=0, const BOOL* selective_bytes=0);
+
+  BOOL chunk_sizes();
+  BOOL init(const U8* item, U32& context); // context is only read
+  void read(U8* item, U32& context);       // context is only read
+  BOOL save_state(ByteStreamOut* stream);
+  BOOL load_state(ByteStreamIn* stream);
+  void request_layers(const U32 decompress_selective);
+
+  ~LASreadItemAttributes();
+
+private:
+
+  /* not used as a decoder. just gives access to instream and reports errors */
+
+  ArithmeticDecoder* dec;
+
+  U32 number;
+  BOOL* selected_bytes;
+  BOOL* requested_bytes;
+
+  /* the layout of the first chunk (all others must have the same) */
+
+  U32 num_layers;
+  LASattributeLayer* layers;
+
+  U32 num_values;
+  LASattributeValue* values;
+
+  ByteStreamInArray** instream_layers;
+
+  ArithmeticDecoder** dec_layers;
+
+  U32* num_bytes_layers;
+
+  BOOL* changed_layers;
+
+  U32 num_changed_values;
+  U32* changed_values;
+
+  BOOL* requested_layers;
+
+  U8* bytes;
+  U32 num_bytes_allocated;
+
+  U32 current_context;
+  LAScontextATTRIBUTES contexts[4];
+
+  BOOL createAndInitModelsAndDecompressors(U32 context, const U8* item);
+  void select_layers();
+  void read_value(const U32 i, U8* item, U8* last_item, const U32 size);
+};
+
+#endif
@@ -0,0 +1,366 @@
+/*
+===============================================================================
+
+  FILE:  lasreaditembitpacked.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include "lasreaditembitpacked.hpp"
+#include "bytestreamin.hpp"
+#include "bytestreamout.hpp"
+
+#include <assert.h>
+#include <string.h>
+
+typedef struct LASpoint14
+{
+  I32 X;
+  I32 Y;
+  I32 Z;
+  U16 intensity;
+  U8 legacy_return_number : 3;
+  U8 legacy_number_of_returns : 3;
+  U8 scan_direction_flag : 1;
+  U8 edge_of_flight_line : 1;
+  U8 legacy_classification : 5;
+  U8 legacy_flags : 3;
+  I8 legacy_scan_angle_rank;
+  U8 user_data;
+  U16 point_source_ID;
+
+  // LAS 1.4 only
+  I16 scan_angle;
+  U8 legacy_point_type : 2;
+  U8 scanner_channel : 2;
+  U8 classification_flags : 4;
+  U8 classification;
+  U8 return_number : 4;
+  U8 number_of_returns : 4;
+
+  // LASlib internal use only
+  U8 deleted_flag;
+
+  // for 8 byte alignment of the GPS time
+  U8 dummy[2];
+
+  // compressed LASzip 1.4 points only
+  BOOL gps_time_change;
+
+  F64 gps_time;
+  U16 rgb[4];
+//  LASwavepacket wavepacket;
+} LASpoint14;
+
+// sets the legacy fields that are not stored the same way the other readers do
+
+static inline void laszip_bitpacked_legacy(LASpoint14* point)
+{
+  U32 r = point->return_number;
+  U32 n = point->number_of_returns;
+  if (n > 7)
+  {
+    if (r > 6)
+    {
+      r = (r >= n ? 7 : 6);
+    }
+    n = 7;
+  }
+  point->legacy_return_number = r;
+  point->legacy_number_of_returns = n;
+  point->legacy_classification = (point->classification < 32 ? point->classification : 0);
+  point->legacy_flags = (point->classification_flags & 0x07);
+  point->legacy_scan_angle_rank = I8_CLAMP(I16_QUANTIZE(0.006f*point->scan_angle));
+}
+
+// unpacks 'number' values of 'bits' bits from a little-endian bit stream. there
+// are no branches per value so that the compiler can vectorize the loops. the
+// stream must be followed by LASZIP_BITPACKED_PADDING readable bytes
+
+static inline void laszip_bitpacked_unpack(U64* values, const U8* bytes, const U32 number, const U32 bits)
+{
+  U32 i;
+  if (bits == 0)
+  {
+    for (i = 0; i < number; i++) values[i] = 0;
+  }
+  else if (bits <= 56)
+  {
+    const U64 mask = (((U64)1) << bits) - 1;
+    for (i = 0; i < number; i++)
+    {
+      U32 p = i*bits;
+      values[i] = (laszip_bitpacked_load64(bytes + (p >> 3)) >> (p & 7)) & mask;
+    }
+  }
+  else
+  {
+    // values that may straddle nine bytes
+    const U64 mask = (bits == 64 ? (U64)-1 : (((U64)1) << bits) - 1);
+    for (i = 0; i < number; i++)
+    {
+      U32 p = i*bits;
+      U64 low = laszip_bitpacked_load64(bytes + (p >> 3)) >> (p & 7);
+      U64 high = (((U64)bytes[(p >> 3) + 8]) << 1) << (63 - (p & 7));
+      values[i] = (low | high) & mask;
+    }
+  }
+}
+
+LASreadItemBitpacked::LASreadItemBitpacked(ArithmeticDecoder* dec, const LASitem& item)
+{
+  /* not used as a decoder. just gives access to instream and reports errors */
+
+  assert(dec);
+  this->dec = dec;
+
+  /* which fields the item has */
+
+  fields = new LASbitpackedField[item.size];
+  num_fields = laszip_bitpacked_fields(item, fields);
+  record_size = laszip_bitpacked_record_size(fields, num_fields);
+  legacy_point14 = (item.type == LASitem::POINT14);
+
+  bytes = 0;
+  num_bytes = 0;
+  num_bytes_allocated = 0;
+
+  items = 0;
+  num_items = 0;
+  num_items_allocated = 0;
+  current = 0;
+}
+
+LASreadItemBitpacked::~LASreadItemBitpacked()
+{
+  delete [] fields;
+  if (bytes) delete [] bytes;
+  if (items) delete [] items;
+}
+
+BOOL LASreadItemBitpacked::chunk_sizes()
+{
+  /* for bit-packed compression 'dec' only hands over the stream */
+
+  ByteStreamIn* instream = dec->getByteStreamIn();
+
+  /* read number of packed bytes */
+
+  instream->get32bitsLE(((U8*)&num_bytes));
+
+  return TRUE;
+}
+
+void LASreadItemBitpacked::set_chunk_count(const U32 count)
+{
+  /* the first item of the chunk is stored raw */
+
+  num_items = (count ? count - 1 : 0);
+}
+
+const U8* LASreadItemBitpacked::unpack_field(const LASbitpackedField* field, const U8* item, const U8* packed, const U8* end)
+{
+  U64 values[LASZIP_BITPACKED_BLOCK_SIZE];
+  const U32 width = field->width;
+  const U64 mask = laszip_bitpacked_mask(width);
+  U64 last = laszip_bitpacked_get(item + field->offset, width) & field->keep;
+  U8* record = items + field->offset;
+  U32 i, start, number;
+
+  for (start = 0; start < num_items; start += LASZIP_BITPACKED_BLOCK_SIZE)
+  {
+    number = num_items - start;
+    if (number > LASZIP_BITPACKED_BLOCK_SIZE) number = LASZIP_BITPACKED_BLOCK_SIZE;
+
+    // header byte and base
+
+    if ((U32)(end - packed) < 1 + width)
+    {
+      dec->reportError(4711);
+      return end;
+    }
+    U32 bits = packed[0] & LASZIP_BITPACKED_BITS;
+    BOOL delta = (packed[0] & LASZIP_BITPACKED_DELTA);
+    if (bits > 8*width)
+    {
+      dec->reportError(4711);
+      return end;
+    }
+    U64 base = 0;
+    for (i = 0; i < width; i++)
+    {
+      base |= ((U64)packed[1+i]) << (8*i);
+    }
+    packed += 1 + width;
+
+    // the bit-packed values
+
+    U32 block_bytes = (number*bits + 7) / 8;
+    if ((U32)(end - packed) < block_bytes)
+    {
+      dec->reportError(4711);
+      return end;
+    }
+    laszip_bitpacked_unpack(values, packed, number, bits);
+    packed += block_bytes;
+
+    if (delta)
+    {
+      for (i = 0; i < number; i++)
+      {
+        U64 zigzag = values[i] + base;
+        I64 diff = ((I64)(zigzag >> 1)) ^ (-(I64)(zigzag & 1));
+        last = (last + (U64)diff) & mask;
+        values[i] = last;
+      }
+    }
+    else
+    {
+      for (i = 0; i < number; i++)
+      {
+        values[i] += base;
+      }
+      last = values[number-1];
+    }
+
+    // store into the records in the native byte order of the item
+
+    switch (width)
+    {
+    case 1:
+      for (i = 0; i < number; i++)
+      {
+        record[i*record_size] = (U8)values[i];
+      }
+      break;
+    case 2:
+      for (i = 0; i < number; i++)
+      {
+        U16 value = (U16)values[i];
+        memcpy(record + i*record_size, &value, 2);
+      }
+      break;
+    case 4:
+      for (i = 0; i < number; i++)
+      {
+        U32 value = (U32)values[i];
+        memcpy(record + i*record_size, &value, 4);
+      }
+      break;
+    default:
+      for (i = 0; i < number; i++)
+      {
+        memcpy(record + i*record_size, &values[i], 8);
+      }
+      break;
+    }
+    record += (size_t)number*record_size;
+  }
+
+  return packed;
+}
+
+BOOL LASreadItemBitpacked::init(const U8* item, U32& context)
+{
+  U32 i;
+
+  /* for bit-packed compression 'dec' only hands over the stream */
+
+  ByteStreamIn* instream = dec->getByteStreamIn();
+
+  /* make sure the buffers are sufficiently large */
+
+  if ((num_bytes + LASZIP_BITPACKED_PADDING) > num_bytes_allocated)
+  {
+    if (bytes) delete [] bytes;
+    // a corrupt size may not be allocatable
+    bytes = 0;
+    num_bytes_allocated = 0;
+    bytes = new U8[num_bytes + LASZIP_BITPACKED_PADDING];
+    if (bytes == 0) return FALSE;
+    num_bytes_allocated = num_bytes + LASZIP_BITPACKED_PADDING;
+  }
+  if (num_items > num_items_allocated)
+  {
+    if (items) delete [] items;
+    items = 0;
+    num_items_allocated = 0;
+    items = new U8[(size_t)num_items*record_size];
+    if (items == 0) return FALSE;
+    // bytes that are not covered by any field stay zero
+    memset(items, 0, (size_t)num_items*record_size);
+    num_items_allocated = num_items;
+  }
+
+  /* load the packed bytes and unpack all items of the chunk */
+
+  instream->getBytes(bytes, num_bytes);
+  memset(bytes + num_bytes, 0, LASZIP_BITPACKED_PADDING);
+
+  const U8* next = bytes;
+  for (i = 0; i < num_fields; i++)
+  {
+    next = unpack_field(&fields[i], item, next, bytes + num_bytes);
+  }
+
+  /* derive the legacy fields of LAS 1.4 points from the extended ones */
+
+  if (legacy_point14)
+  {
+    for (i = 0; i < num_items; i++)
+    {
+      laszip_bitpacked_legacy((LASpoint14*)(items + (size_t)i*record_size));
+    }
+  }
+
+  current = 0;
+  return TRUE;
+}
+
+void LASreadItemBitpacked::read(U8* item, U32& context)
+{
+  if (current >= num_items)
+  {
+    dec->reportError(4711);
+    return;
+  }
+  memcpy(item, items + (size_t)current*record_size, record_size);
+  current++;
+}
+
+BOOL LASreadItemBitpacked::save_state(ByteStreamOut* stream)
+{
+  /* all items of the chunk are unpacked. only the position is needed */
+
+  stream->putBytes((const U8*)&current, sizeof(U32));
+  return TRUE;
+}
+
+BOOL LASreadItemBitpacked::load_state(ByteStreamIn* stream)
+{
+  stream->getBytes((U8*)&current, sizeof(U32));
+  return TRUE;
+}
@@ -0,0 +1,87 @@
+/*
+===============================================================================
+
+  FILE:  lasreaditembitpacked.hpp
+
+  CONTENTS:
+
+    Reads any item from per-field blocks of frame-of-reference bit-packed values
+    by unpacking the entire chunk at once (see laszip_common_bitpacked.hpp)
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- derives the legacy fields of POINT14 items from the extended ones
+    16 October 2026 -- reports corrupt blocks through the status of the decoder
+    16 October 2026 -- created for the bit-packed compressor of the hot storage tier
+
+===============================================================================
+*/
+#ifndef LAS_READ_ITEM_BITPACKED_HPP
+#define LAS_READ_ITEM_BITPACKED_HPP
+
+#include "lasreaditem.hpp"
+#include "arithmeticdecoder.hpp"
+
+#include "laszip_common_bitpacked.hpp"
+
+class LASreadItemBitpacked : public LASreadItemCompressed
+{
+public:
+
+  LASreadItemBitpacked(ArithmeticDecoder* dec, const LASitem& item);
+
+  BOOL chunk_sizes();
+  void set_chunk_count(const U32 count);
+  BOOL init(const U8* item, U32& context);
+  void read(U8* item, U32& context);
+  BOOL save_state(ByteStreamOut* stream);
+  BOOL load_state(ByteStreamIn* stream);
+
+  ~LASreadItemBitpacked();
+
+private:
+
+  const U8* unpack_field(const LASbitpackedField* field, const U8* item, const U8* packed, const U8* end);
+
+  /* not used as a decoder. just gives access to instream and reports errors */
+
+  ArithmeticDecoder* dec;
+
+  U32 num_fields;
+  LASbitpackedField* fields;
+  U32 record_size;
+
+  // whether the items are POINT14 whose legacy fields are not stored
+
+  BOOL legacy_point14;
+
+  // the packed bytes of the current chunk
+
+  U8* bytes;
+  U32 num_bytes;
+  U32 num_bytes_allocated;
+
+  // the unpacked items of the current chunk (without the first one)
+
+  U8* items;
+  U32 num_items;
+  U32 num_items_allocated;
+  U32 current;
+};
+
+#endif
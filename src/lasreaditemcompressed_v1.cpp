@@ -540,6 +540,48 @@ inline void LASreadItemCompressed_WAVEPACKET13_v1::read(U8* item, U32& context)
 ===============================================================================
 */
 
+BOOL LASreadItemCompressed_WAVEPACKET13_v1::save_state(ByteStreamOut* stream)
+{
+  /* save state */
+  stream->putBytes(last_item, 28);
+  stream->putBytes((const U8*)&last_diff_32, sizeof(I32));
+  stream->putBytes((const U8*)&sym_last_offset_diff, sizeof(U32));
+
+  /* save models and integer compressors */
+  dec->saveSymbolModel(stream, m_packet_index);
+  dec->saveSymbolModel(stream, m_offset_diff[0]);
+  dec->saveSymbolModel(stream, m_offset_diff[1]);
+  dec->saveSymbolModel(stream, m_offset_diff[2]);
+  dec->saveSymbolModel(stream, m_offset_diff[3]);
+  ic_offset_diff->saveDecompressor(stream);
+  ic_packet_size->saveDecompressor(stream);
+  ic_return_point->saveDecompressor(stream);
+  ic_xyz->saveDecompressor(stream);
+
+  return TRUE;
+}
+
+BOOL LASreadItemCompressed_WAVEPACKET13_v1::load_state(ByteStreamIn* stream)
+{
+  /* load state */
+  stream->getBytes(last_item, 28);
+  stream->getBytes((U8*)&last_diff_32, sizeof(I32));
+  stream->getBytes((U8*)&sym_last_offset_diff, sizeof(U32));
+
+  /* load models and integer compressors */
+  dec->loadSymbolModel(stream, m_packet_index);
+  dec->loadSymbolModel(stream, m_offset_diff[0]);
+  dec->loadSymbolModel(stream, m_offset_diff[1]);
+  dec->loadSymbolModel(stream, m_offset_diff[2]);
+  dec->loadSymbolModel(stream, m_offset_diff[3]);
+  ic_offset_diff->loadDecompressor(stream);
+  ic_packet_size->loadDecompressor(stream);
+  ic_return_point->loadDecompressor(stream);
+  ic_xyz->loadDecompressor(stream);
+
+  return TRUE;
+}
+
 LASreadItemCompressed_BYTE_v1::LASreadItemCompressed_BYTE_v1(ArithmeticDecoder* dec, U32 number)
 {
   /* set decoder */
@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- save and load the WAVEPACKET13 state for seek checkpoints
     28 August 2017 -- moving 'context' from global development hack to interface  
     6 September 2014 -- removed inheritance of EntropyEncoder and EntropyDecoder
     10 January 2011 -- licensing change for LGPL release and liblas integration
@@ -118,6 +119,9 @@ public:
   BOOL init(const U8* item, U32& context); // context is unused
   void read(U8* item, U32& context);       // context is unused
 
+  BOOL save_state(ByteStreamOut* stream);
+  BOOL load_state(ByteStreamIn* stream);
+
   ~LASreadItemCompressed_WAVEPACKET13_v1();
 
 private:
@@ -30,6 +30,8 @@
 */
 
 #include "lasreaditemcompressed_v2.hpp"
+#include "lasreaditemsfused.hpp"
+#include "laszip.hpp"
 
 #include <cassert>
 #include <string.h>
@@ -60,19 +62,19 @@ LASreadItemCompressed_POINT10_v2::LASreadItemCompressed_POINT10_v2(ArithmeticDec
 
   /* create models and integer compressors */
   m_changed_values = dec->createSymbolModel(64);
-  ic_intensity = new IntegerCompressor(dec, 16, 4);
+  ic_intensity = new IntegerCompressorFixed<16>(dec, 4);
   m_scan_angle_rank[0] = dec->createSymbolModel(256);
   m_scan_angle_rank[1] = dec->createSymbolModel(256);
-  ic_point_source_ID = new IntegerCompressor(dec, 16);
+  ic_point_source_ID = new IntegerCompressorFixed<16>(dec);
   for (i = 0; i < 256; i++)
   {
     m_bit_byte[i] = 0;
     m_classification[i] = 0;
     m_user_data[i] = 0;
   }
-  ic_dx = new IntegerCompressor(dec, 32, 2);  // 32 bits, 2 context
-  ic_dy = new IntegerCompressor(dec, 32, 22); // 32 bits, 22 contexts
-  ic_z = new IntegerCompressor(dec, 32, 20);  // 32 bits, 20 contexts
+  ic_dx = new IntegerCompressorFixed<32>(dec, 2);  // 32 bits, 2 context
+  ic_dy = new IntegerCompressorFixed<32>(dec, 22); // 32 bits, 22 contexts
+  ic_z = new IntegerCompressorFixed<32>(dec, 20);  // 32 bits, 20 contexts
 }
 
 LASreadItemCompressed_POINT10_v2::~LASreadItemCompressed_POINT10_v2()
@@ -243,6 +245,66 @@ inline void LASreadItemCompressed_POINT10_v2::read(U8* item, U32& context)
 ===============================================================================
 */
 
+BOOL LASreadItemCompressed_POINT10_v2::save_state(ByteStreamOut* stream)
+{
+  U32 i;
+
+  /* save state */
+  stream->putBytes(last_item, 20);
+  stream->putBytes((const U8*)last_intensity, sizeof(last_intensity));
+  stream->putBytes((const U8*)last_x_diff_median5, sizeof(last_x_diff_median5));
+  stream->putBytes((const U8*)last_y_diff_median5, sizeof(last_y_diff_median5));
+  stream->putBytes((const U8*)last_height, sizeof(last_height));
+
+  /* save models and integer compressors */
+  dec->saveSymbolModel(stream, m_changed_values);
+  ic_intensity->saveDecompressor(stream);
+  dec->saveSymbolModel(stream, m_scan_angle_rank[0]);
+  dec->saveSymbolModel(stream, m_scan_angle_rank[1]);
+  ic_point_source_ID->saveDecompressor(stream);
+  for (i = 0; i < 256; i++)
+  {
+    dec->saveSymbolModel(stream, m_bit_byte[i]);
+    dec->saveSymbolModel(stream, m_classification[i]);
+    dec->saveSymbolModel(stream, m_user_data[i]);
+  }
+  ic_dx->saveDecompressor(stream);
+  ic_dy->saveDecompressor(stream);
+  ic_z->saveDecompressor(stream);
+
+  return TRUE;
+}
+
+BOOL LASreadItemCompressed_POINT10_v2::load_state(ByteStreamIn* stream)
+{
+  U32 i;
+
+  /* load state */
+  stream->getBytes(last_item, 20);
+  stream->getBytes((U8*)last_intensity, sizeof(last_intensity));
+  stream->getBytes((U8*)last_x_diff_median5, sizeof(last_x_diff_median5));
+  stream->getBytes((U8*)last_y_diff_median5, sizeof(last_y_diff_median5));
+  stream->getBytes((U8*)last_height, sizeof(last_height));
+
+  /* load models and integer compressors */
+  dec->loadSymbolModel(stream, m_changed_values);
+  ic_intensity->loadDecompressor(stream);
+  dec->loadSymbolModel(stream, m_scan_angle_rank[0]);
+  dec->loadSymbolModel(stream, m_scan_angle_rank[1]);
+  ic_point_source_ID->loadDecompressor(stream);
+  for (i = 0; i < 256; i++)
+  {
+    dec->loadSymbolModel(stream, m_bit_byte[i]);
+    dec->loadSymbolModel(stream, m_classification[i]);
+    dec->loadSymbolModel(stream, m_user_data[i]);
+  }
+  ic_dx->loadDecompressor(stream);
+  ic_dy->loadDecompressor(stream);
+  ic_z->loadDecompressor(stream);
+
+  return TRUE;
+}
+
 #define LASZIP_GPSTIME_MULTI 500
 #define LASZIP_GPSTIME_MULTI_MINUS -10
 #define LASZIP_GPSTIME_MULTI_UNCHANGED (LASZIP_GPSTIME_MULTI - LASZIP_GPSTIME_MULTI_MINUS + 1)
@@ -258,7 +320,7 @@ LASreadItemCompressed_GPSTIME11_v2::LASreadItemCompressed_GPSTIME11_v2(Arithmeti
   /* create entropy models and integer compressors */
   m_gpstime_multi = dec->createSymbolModel(LASZIP_GPSTIME_MULTI_TOTAL);
   m_gpstime_0diff = dec->createSymbolModel(6);
-  ic_gpstime = new IntegerCompressor(dec, 32, 9); // 32 bits, 9 contexts
+  ic_gpstime = new IntegerCompressorFixed<32>(dec, 9); // 32 bits, 9 contexts
   last = 0;
 }
 
@@ -406,6 +468,40 @@ inline void LASreadItemCompressed_GPSTIME11_v2::read(U8* item, U32& context)
 ===============================================================================
 */
 
+BOOL LASreadItemCompressed_GPSTIME11_v2::save_state(ByteStreamOut* stream)
+{
+  /* save state */
+  stream->putBytes((const U8*)&last, sizeof(U32));
+  stream->putBytes((const U8*)&next, sizeof(U32));
+  stream->putBytes((const U8*)last_gpstime, sizeof(last_gpstime));
+  stream->putBytes((const U8*)last_gpstime_diff, sizeof(last_gpstime_diff));
+  stream->putBytes((const U8*)multi_extreme_counter, sizeof(multi_extreme_counter));
+
+  /* save models and integer compressors */
+  dec->saveSymbolModel(stream, m_gpstime_multi);
+  dec->saveSymbolModel(stream, m_gpstime_0diff);
+  ic_gpstime->saveDecompressor(stream);
+
+  return TRUE;
+}
+
+BOOL LASreadItemCompressed_GPSTIME11_v2::load_state(ByteStreamIn* stream)
+{
+  /* load state */
+  stream->getBytes((U8*)&last, sizeof(U32));
+  stream->getBytes((U8*)&next, sizeof(U32));
+  stream->getBytes((U8*)last_gpstime, sizeof(last_gpstime));
+  stream->getBytes((U8*)last_gpstime_diff, sizeof(last_gpstime_diff));
+  stream->getBytes((U8*)multi_extreme_counter, sizeof(multi_extreme_counter));
+
+  /* load models and integer compressors */
+  dec->loadSymbolModel(stream, m_gpstime_multi);
+  dec->loadSymbolModel(stream, m_gpstime_0diff);
+  ic_gpstime->loadDecompressor(stream);
+
+  return TRUE;
+}
+
 LASreadItemCompressed_RGB12_v2::LASreadItemCompressed_RGB12_v2(ArithmeticDecoder* dec)
 {
   /* set decoder */
@@ -531,6 +627,40 @@ inline void LASreadItemCompressed_RGB12_v2::read(U8* item, U32& context)
 ===============================================================================
 */
 
+BOOL LASreadItemCompressed_RGB12_v2::save_state(ByteStreamOut* stream)
+{
+  /* save state */
+  stream->putBytes((const U8*)last_item, sizeof(last_item));
+
+  /* save models */
+  dec->saveSymbolModel(stream, m_byte_used);
+  dec->saveSymbolModel(stream, m_rgb_diff_0);
+  dec->saveSymbolModel(stream, m_rgb_diff_1);
+  dec->saveSymbolModel(stream, m_rgb_diff_2);
+  dec->saveSymbolModel(stream, m_rgb_diff_3);
+  dec->saveSymbolModel(stream, m_rgb_diff_4);
+  dec->saveSymbolModel(stream, m_rgb_diff_5);
+
+  return TRUE;
+}
+
+BOOL LASreadItemCompressed_RGB12_v2::load_state(ByteStreamIn* stream)
+{
+  /* load state */
+  stream->getBytes((U8*)last_item, sizeof(last_item));
+
+  /* load models */
+  dec->loadSymbolModel(stream, m_byte_used);
+  dec->loadSymbolModel(stream, m_rgb_diff_0);
+  dec->loadSymbolModel(stream, m_rgb_diff_1);
+  dec->loadSymbolModel(stream, m_rgb_diff_2);
+  dec->loadSymbolModel(stream, m_rgb_diff_3);
+  dec->loadSymbolModel(stream, m_rgb_diff_4);
+  dec->loadSymbolModel(stream, m_rgb_diff_5);
+
+  return TRUE;
+}
+
 LASreadItemCompressed_BYTE_v2::LASreadItemCompressed_BYTE_v2(ArithmeticDecoder* dec, U32 number)
 {
   U32 i;
@@ -592,3 +722,83 @@ inline void LASreadItemCompressed_BYTE_v2::read(U8* item, U32& context)
   }
   memcpy(last_item, item, number);
 }
+
+BOOL LASreadItemCompressed_BYTE_v2::save_state(ByteStreamOut* stream)
+{
+  U32 i;
+
+  /* save state */
+  stream->putBytes(last_item, number);
+
+  /* save models */
+  for (i = 0; i < number; i++)
+  {
+    dec->saveSymbolModel(stream, m_byte[i]);
+  }
+
+  return TRUE;
+}
+
+BOOL LASreadItemCompressed_BYTE_v2::load_state(ByteStreamIn* stream)
+{
+  U32 i;
+
+  /* load state */
+  stream->getBytes(last_item, number);
+
+  /* load models */
+  for (i = 0; i < number; i++)
+  {
+    dec->loadSymbolModel(stream, m_byte[i]);
+  }
+
+  return TRUE;
+}
+
+// the standard point types 0 to 3 (with or without extra bytes)
+
+typedef LASreadItemsFusedList<LASreadItemCompressed_BYTE_v2, LASreadItemsFusedEnd> LASreadItemsFused_BYTE_v2;
+
+template <class TAIL>
+static LASreadItemsFused* laszip_fuse_readers_v2(const U32 num_items, const LASitem* items, LASreadItem** readers)
+{
+  typedef LASreadItemsFusedList<LASreadItemCompressed_RGB12_v2, TAIL> RGB12_TAIL;
+  typedef LASreadItemsFusedList<LASreadItemCompressed_GPSTIME11_v2, TAIL> GPSTIME11_TAIL;
+  typedef LASreadItemsFusedList<LASreadItemCompressed_GPSTIME11_v2, RGB12_TAIL> GPSTIME11_RGB12_TAIL;
+
+  if (num_items == 1)
+  {
+    return new LASreadItemsFusedTemplate< LASreadItemsFusedList<LASreadItemCompressed_POINT10_v2, TAIL> >(readers);
+  }
+  else if ((num_items == 2) && (items[1].type == LASitem::GPSTIME11))
+  {
+    return new LASreadItemsFusedTemplate< LASreadItemsFusedList<LASreadItemCompressed_POINT10_v2, GPSTIME11_TAIL> >(readers);
+  }
+  else if ((num_items == 2) && (items[1].type == LASitem::RGB12))
+  {
+    return new LASreadItemsFusedTemplate< LASreadItemsFusedList<LASreadItemCompressed_POINT10_v2, RGB12_TAIL> >(readers);
+  }
+  else if ((num_items == 3) && (items[1].type == LASitem::GPSTIME11) && (items[2].type == LASitem::RGB12))
+  {
+    return new LASreadItemsFusedTemplate< LASreadItemsFusedList<LASreadItemCompressed_POINT10_v2, GPSTIME11_RGB12_TAIL> >(readers);
+  }
+  return 0;
+}
+
+LASreadItemsFused* laszip_fuse_readers_v2(const U32 num_items, const LASitem* items, LASreadItem** readers)
+{
+  U32 i;
+  for (i = 0; i < num_items; i++)
+  {
+    if (items[i].version != 2) return 0;
+  }
+  if ((num_items == 0) || (items[0].type != LASitem::POINT10))
+  {
+    return 0;
+  }
+  if ((num_items > 1) && (items[num_items-1].type == LASitem::BYTE))
+  {
+    return laszip_fuse_readers_v2<LASreadItemsFused_BYTE_v2>(num_items-1, items, readers);
+  }
+  return laszip_fuse_readers_v2<LASreadItemsFusedEnd>(num_items, items, readers);
+}
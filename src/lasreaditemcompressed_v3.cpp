@@ -30,6 +30,8 @@
 */
 
 #include "lasreaditemcompressed_v3.hpp"
+#include "lasreaditemsfused.hpp"
+#include "laszip.hpp"
 #include "lasmessage.hpp"
 
 #include <cassert>
@@ -80,14 +82,9 @@ typedef struct LASpoint14
 
 #define LASZIP_GPSTIME_MULTI_TOTAL (LASZIP_GPSTIME_MULTI - LASZIP_GPSTIME_MULTI_MINUS + 5) 
 
-LASreadItemCompressed_POINT14_v3::LASreadItemCompressed_POINT14_v3(ArithmeticDecoder* dec, const U32 decompress_selective)
+LASreadItemCompressed_POINT14_v3::LASreadItemCompressed_POINT14_v3(ArithmeticDecoder* dec, const U32 decompress_selective, const BOOL parallel_layers) : LASreadItemLayered_POINT14(dec, parallel_layers)
 {
-  /* not used as a decoder. just gives access to instream */
-
-  assert(dec);
-  this->dec = dec;
-
-  /* zero instreams and decoders */
+  /* zero instreams */
 
   instream_channel_returns_XY = 0;
   instream_Z = 0;
@@ -99,26 +96,7 @@ LASreadItemCompressed_POINT14_v3::LASreadItemCompressed_POINT14_v3(ArithmeticDec
   instream_point_source = 0;
   instream_gps_time = 0;
 
-  dec_channel_returns_XY = 0;
-  dec_Z = 0;
-  dec_classification = 0;
-  dec_flags = 0;
-  dec_intensity = 0;
-  dec_scan_angle = 0;
-  dec_user_data = 0;
-  dec_point_source = 0;
-  dec_gps_time = 0;
-
-  /* mark the four scanner channel contexts as uninitialized */
-
-  U32 c;
-  for (c = 0; c < 4; c++)
-  {
-    contexts[c].m_changed_values[0] = 0;
-  }
-  current_context = 0;
-
-  /* zero num_bytes and init booleans */
+  /* zero num_bytes */
 
   num_bytes_channel_returns_XY = 0;
   num_bytes_Z = 0;
@@ -130,15 +108,7 @@ LASreadItemCompressed_POINT14_v3::LASreadItemCompressed_POINT14_v3(ArithmeticDec
   num_bytes_point_source = 0;
   num_bytes_gps_time = 0;
 
-  changed_Z = FALSE;
-  changed_classification = FALSE;
-  changed_flags = FALSE;
-  changed_intensity = FALSE;
-  changed_scan_angle = FALSE;
-  changed_user_data = FALSE;
-  changed_point_source = FALSE;
-  changed_gps_time = FALSE;
-
+  this->decompress_selective = decompress_selective;
   requested_Z = (decompress_selective & LASZIP_DECOMPRESS_SELECTIVE_Z ? TRUE : FALSE);
   requested_classification = (decompress_selective & LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION ? TRUE : FALSE);
   requested_flags = (decompress_selective & LASZIP_DECOMPRESS_SELECTIVE_FLAGS ? TRUE : FALSE);
@@ -225,166 +195,6 @@ LASreadItemCompressed_POINT14_v3::~LASreadItemCompressed_POINT14_v3()
   if (bytes) delete [] bytes;
 }
 
-inline BOOL LASreadItemCompressed_POINT14_v3::createAndInitModelsAndDecompressors(U32 context, const U8* item)
-{
-  I32 i;
-
-  /* should only be called when context is unused */
-
-  assert(contexts[context].unused);
-
-  /* first create all entropy models and integer decompressors (if needed) */
-
-  if (contexts[context].m_changed_values[0] == 0)
-  {
-    /* for the channel_returns_XY layer */
-
-    contexts[context].m_changed_values[0] = dec_channel_returns_XY->createSymbolModel(128);
-    contexts[context].m_changed_values[1] = dec_channel_returns_XY->createSymbolModel(128);
-    contexts[context].m_changed_values[2] = dec_channel_returns_XY->createSymbolModel(128);
-    contexts[context].m_changed_values[3] = dec_channel_returns_XY->createSymbolModel(128);
-    contexts[context].m_changed_values[4] = dec_channel_returns_XY->createSymbolModel(128);
-    contexts[context].m_changed_values[5] = dec_channel_returns_XY->createSymbolModel(128);
-    contexts[context].m_changed_values[6] = dec_channel_returns_XY->createSymbolModel(128);
-    contexts[context].m_changed_values[7] = dec_channel_returns_XY->createSymbolModel(128);
-    contexts[context].m_scanner_channel = dec_channel_returns_XY->createSymbolModel(3);
-    for (i = 0; i < 16; i++)
-    {
-      contexts[context].m_number_of_returns[i] = 0;
-      contexts[context].m_return_number[i] = 0;
-    }
-    contexts[context].m_return_number_gps_same = dec_channel_returns_XY->createSymbolModel(13);
-
-    contexts[context].ic_dX = new IntegerCompressor(dec_channel_returns_XY, 32, 2);  // 32 bits, 2 context
-    contexts[context].ic_dY = new IntegerCompressor(dec_channel_returns_XY, 32, 22); // 32 bits, 22 contexts
-
-    /* for the Z layer */
-
-    contexts[context].ic_Z = new IntegerCompressor(dec_Z, 32, 20);  // 32 bits, 20 contexts
-
-    /* for the classification layer */
-    /* for the flags layer */
-    /* for the user_data layer */
-
-    for (i = 0; i < 64; i++)
-    {
-      contexts[context].m_classification[i] = 0;
-      contexts[context].m_flags[i] = 0;
-      contexts[context].m_user_data[i] = 0;
-    }
-
-    /* for the intensity layer */
-
-    contexts[context].ic_intensity = new IntegerCompressor(dec_intensity, 16, 4);
-
-    /* for the scan_angle layer */
-
-    contexts[context].ic_scan_angle = new IntegerCompressor(dec_scan_angle, 16, 2);
-
-    /* for the point_source_ID layer */
-
-    contexts[context].ic_point_source_ID = new IntegerCompressor(dec_point_source, 16);
-
-    /* for the gps_time layer */
-
-    contexts[context].m_gpstime_multi = dec_gps_time->createSymbolModel(LASZIP_GPSTIME_MULTI_TOTAL);
-    contexts[context].m_gpstime_0diff = dec_gps_time->createSymbolModel(5);
-    contexts[context].ic_gpstime = new IntegerCompressor(dec_gps_time, 32, 9); // 32 bits, 9 contexts
-  }
-
-  /* then init entropy models and integer compressors */
-
-  /* for the channel_returns_XY layer */
-
-  dec_channel_returns_XY->initSymbolModel(contexts[context].m_changed_values[0]);
-  dec_channel_returns_XY->initSymbolModel(contexts[context].m_changed_values[1]);
-  dec_channel_returns_XY->initSymbolModel(contexts[context].m_changed_values[2]);
-  dec_channel_returns_XY->initSymbolModel(contexts[context].m_changed_values[3]);
-  dec_channel_returns_XY->initSymbolModel(contexts[context].m_changed_values[4]);
-  dec_channel_returns_XY->initSymbolModel(contexts[context].m_changed_values[5]);
-  dec_channel_returns_XY->initSymbolModel(contexts[context].m_changed_values[6]);
-  dec_channel_returns_XY->initSymbolModel(contexts[context].m_changed_values[7]);
-  dec_channel_returns_XY->initSymbolModel(contexts[context].m_scanner_channel);
-  for (i = 0; i < 16; i++)
-  {
-    if (contexts[context].m_number_of_returns[i]) dec_channel_returns_XY->initSymbolModel(contexts[context].m_number_of_returns[i]);
-    if (contexts[context].m_return_number[i]) dec_channel_returns_XY->initSymbolModel(contexts[context].m_return_number[i]);
-  }
-  dec_channel_returns_XY->initSymbolModel(contexts[context].m_return_number_gps_same);
-  contexts[context].ic_dX->initDecompressor();
-  contexts[context].ic_dY->initDecompressor();
-  for (i = 0; i < 12; i++)
-  {
-    contexts[context].last_X_diff_median5[i].init();
-    contexts[context].last_Y_diff_median5[i].init();
-  }
-
-  /* for the Z layer */
-
-  contexts[context].ic_Z->initDecompressor();
-  for (i = 0; i < 8; i++)
-  {
-    contexts[context].last_Z[i] = ((const LASpoint14*)item)->Z;
-  }
-
-  /* for the classification layer */
-  /* for the flags layer */
-  /* for the user_data layer */
-
-  for (i = 0; i < 64; i++)
-  {
-    if (contexts[context].m_classification[i]) dec_classification->initSymbolModel(contexts[context].m_classification[i]);
-    if (contexts[context].m_flags[i]) dec_flags->initSymbolModel(contexts[context].m_flags[i]);
-    if (contexts[context].m_user_data[i]) dec_user_data->initSymbolModel(contexts[context].m_user_data[i]);
-  }
-
-  /* for the intensity layer */
-
-  contexts[context].ic_intensity->initDecompressor();
-  for (i = 0; i < 8; i++)
-  {
-    contexts[context].last_intensity[i] = ((const LASpoint14*)item)->intensity;
-  }
-
-  /* for the scan_angle layer */
-
-  contexts[context].ic_scan_angle->initDecompressor();
-
-  /* for the point_source_ID layer */
-
-  contexts[context].ic_point_source_ID->initDecompressor();
-
-  /* for the gps_time layer */
-
-  dec_gps_time->initSymbolModel(contexts[context].m_gpstime_multi);
-  dec_gps_time->initSymbolModel(contexts[context].m_gpstime_0diff);
-  contexts[context].ic_gpstime->initDecompressor();
-  contexts[context].last = 0, contexts[context].next = 0;
-  contexts[context].last_gpstime_diff[0] = 0;
-  contexts[context].last_gpstime_diff[1] = 0;
-  contexts[context].last_gpstime_diff[2] = 0;
-  contexts[context].last_gpstime_diff[3] = 0;
-  contexts[context].multi_extreme_counter[0] = 0;
-  contexts[context].multi_extreme_counter[1] = 0;
-  contexts[context].multi_extreme_counter[2] = 0;
-  contexts[context].multi_extreme_counter[3] = 0;
-  contexts[context].last_gpstime[0].f64 = ((const LASpoint14*)item)->gps_time;
-  contexts[context].last_gpstime[1].u64 = 0;
-  contexts[context].last_gpstime[2].u64 = 0;
-  contexts[context].last_gpstime[3].u64 = 0;
-
-  /* init current context from last item */
-
-  memcpy(contexts[context].last_item, item, sizeof(LASpoint14));
-  ((LASpoint14*)contexts[context].last_item)->gps_time_change = FALSE;
-
-//  LASMessage(LAS_VERBOSE, "INIT: current_context %d last item %.14g %d %d %d %d %d %d", current_context, ((LASpoint14*)item)->gps_time, ((LASpoint14*)item)->X, ((LASpoint14*)item)->Y, ((LASpoint14*)item)->Z, ((LASpoint14*)item)->intensity, ((LASpoint14*)item)->return_number, ((LASpoint14*)item)->number_of_returns);
-
-  contexts[context].unused = FALSE;
-
-  return TRUE;
-}
-
 BOOL LASreadItemCompressed_POINT14_v3::chunk_sizes()
 {
   /* for layered compression 'dec' only hands over the stream */
@@ -445,15 +255,27 @@ BOOL LASreadItemCompressed_POINT14_v3::init(const U8* item, U32& context)
 
     /* create decoders */
 
-    dec_channel_returns_XY = new ArithmeticDecoder();
-    dec_Z = new ArithmeticDecoder();
-    dec_classification = new ArithmeticDecoder();
-    dec_flags = new ArithmeticDecoder();
-    dec_intensity = new ArithmeticDecoder();
-    dec_scan_angle = new ArithmeticDecoder();
-    dec_user_data = new ArithmeticDecoder();
-    dec_point_source = new ArithmeticDecoder();
-    dec_gps_time = new ArithmeticDecoder();
+    dec_channel_returns_XY = new ArithmeticDecoder(dec->getCoder());
+    dec_Z = new ArithmeticDecoder(dec->getCoder());
+    dec_classification = new ArithmeticDecoder(dec->getCoder());
+    dec_flags = new ArithmeticDecoder(dec->getCoder());
+    dec_intensity = new ArithmeticDecoder(dec->getCoder());
+    dec_scan_angle = new ArithmeticDecoder(dec->getCoder());
+    dec_user_data = new ArithmeticDecoder(dec->getCoder());
+    dec_point_source = new ArithmeticDecoder(dec->getCoder());
+    dec_gps_time = new ArithmeticDecoder(dec->getCoder());
+
+    /* which report errors like the main decoder */
+
+    dec_channel_returns_XY->setStatus(dec->getStatus());
+    dec_Z->setStatus(dec->getStatus());
+    dec_classification->setStatus(dec->getStatus());
+    dec_flags->setStatus(dec->getStatus());
+    dec_intensity->setStatus(dec->getStatus());
+    dec_scan_angle->setStatus(dec->getStatus());
+    dec_user_data->setStatus(dec->getStatus());
+    dec_point_source->setStatus(dec->getStatus());
+    dec_gps_time->setStatus(dec->getStatus());
   }
 
   /* how many bytes do we need to read */
@@ -703,402 +525,234 @@ BOOL LASreadItemCompressed_POINT14_v3::init(const U8* item, U32& context)
 
   createAndInitModelsAndDecompressors(current_context, item);
 
+  /* maybe decompress all layers of this chunk right away */
+
+  layered_count = 0;
+  layered_index = 0;
+
+  if (parallel_layers && (chunk_count > 1))
+  {
+    layered_context = current_context;
+    memcpy(layered_item, item, sizeof(LASpoint14));
+    decompress_layers();
+  }
+
   return TRUE;
 }
 
 inline void LASreadItemCompressed_POINT14_v3::read(U8* item, U32& context)
 {
-  // get last
-
-  U8* last_item = contexts[current_context].last_item;
-
-  ////////////////////////////////////////
-  // decompress returns_XY layer 
-  ////////////////////////////////////////
+  BOOL switched;
+  U32 c = read_point(item, switched);
+  if (switched)
+  {
+    context = c; // the POINT14 reader sets context for all other items
+  }
+}
 
-  // create single (3) / first (1) / last (2) / intermediate (0) context from last point return
+void LASreadItemCompressed_POINT14_v3::request_layers(const U32 decompress_selective)
+{
+  requested_Z = ((this->decompress_selective | decompress_selective) & LASZIP_DECOMPRESS_SELECTIVE_Z ? TRUE : FALSE);
+  requested_classification = ((this->decompress_selective | decompress_selective) & LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION ? TRUE : FALSE);
+  requested_flags = ((this->decompress_selective | decompress_selective) & LASZIP_DECOMPRESS_SELECTIVE_FLAGS ? TRUE : FALSE);
+  requested_intensity = ((this->decompress_selective | decompress_selective) & LASZIP_DECOMPRESS_SELECTIVE_INTENSITY ? TRUE : FALSE);
+  requested_scan_angle = ((this->decompress_selective | decompress_selective) & LASZIP_DECOMPRESS_SELECTIVE_SCAN_ANGLE ? TRUE : FALSE);
+  requested_user_data = ((this->decompress_selective | decompress_selective) & LASZIP_DECOMPRESS_SELECTIVE_USER_DATA ? TRUE : FALSE);
+  requested_point_source = ((this->decompress_selective | decompress_selective) & LASZIP_DECOMPRESS_SELECTIVE_POINT_SOURCE ? TRUE : FALSE);
+  requested_gps_time = ((this->decompress_selective | decompress_selective) & LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME ? TRUE : FALSE);
+}
 
-  I32 lpr = (((LASpoint14*)last_item)->return_number == 1 ? 1 : 0); // first?
-  lpr += (((LASpoint14*)last_item)->return_number >= ((LASpoint14*)last_item)->number_of_returns ? 2 : 0); // last?
+BOOL LASreadItemCompressed_POINT14_v3::save_state(ByteStreamOut* stream)
+{
+  U32 c, i;
 
-  // add info whether the GPS time changed in the last return to the context
+  /* were the layers of this chunk decompressed in parallel */
 
-  lpr += (((LASpoint14*)last_item)->gps_time_change ? 4 : 0);
+  stream->putBytes((const U8*)&layered_index, sizeof(U32));
+  if (layered_count) return TRUE;
 
-  // decompress which values have changed with last point return context
+  /* save the contexts that are in use */
 
-  I32 changed_values = dec_channel_returns_XY->decodeSymbol(contexts[current_context].m_changed_values[lpr]);
+  stream->putBytes((const U8*)&current_context, sizeof(U32));
+  for (c = 0; c < 4; c++)
+  {
+    stream->putByte(contexts[c].unused ? 1 : 0);
+    if (contexts[c].unused) continue;
 
-  // if scanner channel has changed
+    /* for the channel_returns_XY layer */
 
-  if (changed_values & (1 << 6))
-  {
-    U32 diff = dec_channel_returns_XY->decodeSymbol(contexts[current_context].m_scanner_channel); // curr = last + (sym + 1)
-    U32 scanner_channel = (current_context + diff + 1) % 4;
-    // maybe create and init entropy models and integer compressors
-    if (contexts[scanner_channel].unused)
+    stream->putBytes(contexts[c].last_item, sizeof(contexts[c].last_item));
+    stream->putBytes((const U8*)contexts[c].last_X_diff_median5, sizeof(contexts[c].last_X_diff_median5));
+    stream->putBytes((const U8*)contexts[c].last_Y_diff_median5, sizeof(contexts[c].last_Y_diff_median5));
+    for (i = 0; i < 8; i++)
     {
-      // create and init entropy models and integer decompressors
-      createAndInitModelsAndDecompressors(scanner_channel, contexts[current_context].last_item);
+      dec_channel_returns_XY->saveSymbolModel(stream, contexts[c].m_changed_values[i]);
     }
-    // switch context to current scanner channel
-    current_context = scanner_channel;
-    context = current_context; // the POINT14 reader sets context for all other items
-
-    // get last for new context
-    last_item = contexts[current_context].last_item;
-    ((LASpoint14*)last_item)->scanner_channel = scanner_channel;
-  }
-
-  // determine changed attributes
-
-  BOOL point_source_change = (changed_values & (1 << 5) ? TRUE : FALSE);
-  BOOL gps_time_change = (changed_values & (1 << 4) ? TRUE : FALSE);
-  BOOL scan_angle_change = (changed_values & (1 << 3) ? TRUE : FALSE);
+    dec_channel_returns_XY->saveSymbolModel(stream, contexts[c].m_scanner_channel);
+    for (i = 0; i < 16; i++)
+    {
+      dec_channel_returns_XY->saveSymbolModel(stream, contexts[c].m_number_of_returns[i]);
+      dec_channel_returns_XY->saveSymbolModel(stream, contexts[c].m_return_number[i]);
+    }
+    dec_channel_returns_XY->saveSymbolModel(stream, contexts[c].m_return_number_gps_same);
+    contexts[c].ic_dX->saveDecompressor(stream);
+    contexts[c].ic_dY->saveDecompressor(stream);
 
-  // get last return counts
+    /* for the Z layer */
 
-  U32 last_n = ((LASpoint14*)last_item)->number_of_returns;
-  U32 last_r = ((LASpoint14*)last_item)->return_number;
+    stream->putBytes((const U8*)contexts[c].last_Z, sizeof(contexts[c].last_Z));
+    contexts[c].ic_Z->saveDecompressor(stream);
 
-  // if number of returns is different we decompress it
+    /* for the classification layer */
+    /* for the flags layer */
+    /* for the user_data layer */
 
-  U32 n;
-  if (changed_values & (1 << 2))
-  {
-    if (contexts[current_context].m_number_of_returns[last_n] == 0)
+    for (i = 0; i < 64; i++)
     {
-      contexts[current_context].m_number_of_returns[last_n] = dec_channel_returns_XY->createSymbolModel(16);
-      dec_channel_returns_XY->initSymbolModel(contexts[current_context].m_number_of_returns[last_n]);
+      dec_classification->saveSymbolModel(stream, contexts[c].m_classification[i]);
+      dec_flags->saveSymbolModel(stream, contexts[c].m_flags[i]);
+      dec_user_data->saveSymbolModel(stream, contexts[c].m_user_data[i]);
     }
-    n = dec_channel_returns_XY->decodeSymbol(contexts[current_context].m_number_of_returns[last_n]);
-    ((LASpoint14*)last_item)->number_of_returns = n;
-  }
-  else
-  {
-    n = last_n;
-  }
 
-  // how is the return number different
+    /* for the intensity layer */
 
-  U32 r;
-  if ((changed_values & 3) == 0) // same return number
-  {
-    r = last_r;
-  }
-  else if ((changed_values & 3) == 1) // return number plus 1 mod 16
-  {
-    r = ((last_r + 1) % 16);
-    ((LASpoint14*)last_item)->return_number = r;
-  }
-  else if ((changed_values & 3) == 2) // return number minus 1 mod 16
-  {
-    r = ((last_r + 15) % 16);
-    ((LASpoint14*)last_item)->return_number = r;
-  }
-  else
-  {
-    // the return number difference is bigger than +1 / -1 so we decompress how it is different
+    stream->putBytes((const U8*)contexts[c].last_intensity, sizeof(contexts[c].last_intensity));
+    contexts[c].ic_intensity->saveDecompressor(stream);
 
-    if (gps_time_change) // if the GPS time has changed
-    {
-      if (contexts[current_context].m_return_number[last_r] == 0)
-      {
-        contexts[current_context].m_return_number[last_r] = dec_channel_returns_XY->createSymbolModel(16);
-        dec_channel_returns_XY->initSymbolModel(contexts[current_context].m_return_number[last_r]);
-      }
-      r = dec_channel_returns_XY->decodeSymbol(contexts[current_context].m_return_number[last_r]);
-    }
-    else // if the GPS time has not changed
-    {
-      I32 sym = dec_channel_returns_XY->decodeSymbol(contexts[current_context].m_return_number_gps_same);
-      r = (last_r + (sym + 2)) % 16;
-    }
-    ((LASpoint14*)last_item)->return_number = r;
-  }
+    /* for the scan_angle layer */
 
-  // set legacy return counts and number of returns
+    contexts[c].ic_scan_angle->saveDecompressor(stream);
 
-  if (n > 7)
-  {
-    if (r > 6)
-    {
-      if (r >= n)
-      {
-        ((LASpoint14*)last_item)->legacy_return_number = 7;
-      }
-      else
-      {
-        ((LASpoint14*)last_item)->legacy_return_number = 6;
-      }
-    }
-    else
-    {
-      ((LASpoint14*)last_item)->legacy_return_number = r;
-    }
-    ((LASpoint14*)last_item)->legacy_number_of_returns = 7;
-  }
-  else
-  {
-    ((LASpoint14*)last_item)->legacy_return_number = r;
-    ((LASpoint14*)last_item)->legacy_number_of_returns = n;
-  }
+    /* for the point_source_ID layer */
 
-  // get return map m and return level l context for current point
+    contexts[c].ic_point_source_ID->saveDecompressor(stream);
 
-  U32 m = number_return_map_6ctx[n][r];
-  U32 l = number_return_level_8ctx[n][r];
+    /* for the gps_time layer */
 
-  // create single (3) / first (1) / last (2) / intermediate (0) return context for current point
+    stream->putBytes((const U8*)&contexts[c].last, sizeof(U32));
+    stream->putBytes((const U8*)&contexts[c].next, sizeof(U32));
+    stream->putBytes((const U8*)contexts[c].last_gpstime, sizeof(contexts[c].last_gpstime));
+    stream->putBytes((const U8*)contexts[c].last_gpstime_diff, sizeof(contexts[c].last_gpstime_diff));
+    stream->putBytes((const U8*)contexts[c].multi_extreme_counter, sizeof(contexts[c].multi_extreme_counter));
+    dec_gps_time->saveSymbolModel(stream, contexts[c].m_gpstime_multi);
+    dec_gps_time->saveSymbolModel(stream, contexts[c].m_gpstime_0diff);
+    contexts[c].ic_gpstime->saveDecompressor(stream);
+  }
 
-  I32 cpr = (r == 1 ? 2 : 0); // first ?
-  cpr += (r >= n ? 1 : 0); // last ?
+  /* save where the decoders are in their layers */
 
-  U32 k_bits;
-  I32 median, diff;
+  dec_channel_returns_XY->saveState(stream);
+  if (changed_Z) dec_Z->saveState(stream);
+  if (changed_classification) dec_classification->saveState(stream);
+  if (changed_flags) dec_flags->saveState(stream);
+  if (changed_intensity) dec_intensity->saveState(stream);
+  if (changed_scan_angle) dec_scan_angle->saveState(stream);
+  if (changed_user_data) dec_user_data->saveState(stream);
+  if (changed_point_source) dec_point_source->saveState(stream);
+  if (changed_gps_time) dec_gps_time->saveState(stream);
 
-  // decompress X coordinate
-  median = contexts[current_context].last_X_diff_median5[(m<<1) | gps_time_change].get();
-  diff = contexts[current_context].ic_dX->decompress(median, n==1);
-  ((LASpoint14*)last_item)->X += diff;
-  contexts[current_context].last_X_diff_median5[(m<<1) | gps_time_change].add(diff);
+  return TRUE;
+}
 
-  // decompress Y coordinate
-  median = contexts[current_context].last_Y_diff_median5[(m<<1) | gps_time_change].get();
-  k_bits = contexts[current_context].ic_dX->getK();
-  diff = contexts[current_context].ic_dY->decompress(median, (n==1) + ( k_bits < 20 ? U32_ZERO_BIT_0(k_bits) : 20 ));
-  ((LASpoint14*)last_item)->Y += diff;
-  contexts[current_context].last_Y_diff_median5[(m<<1) | gps_time_change].add(diff);
+BOOL LASreadItemCompressed_POINT14_v3::load_state(ByteStreamIn* stream)
+{
+  U32 c, i;
+  U8 last_item[128];
 
-  ////////////////////////////////////////
-  // decompress Z layer (if changed and requested)
-  ////////////////////////////////////////
+  /* were the layers of this chunk decompressed in parallel */
 
-  if (changed_Z) // if the Z coordinate should be decompressed and changes within this chunk
-  {
-    k_bits = (contexts[current_context].ic_dX->getK() + contexts[current_context].ic_dY->getK()) / 2;
-    ((LASpoint14*)last_item)->Z = contexts[current_context].ic_Z->decompress(contexts[current_context].last_Z[l], (n==1) + (k_bits < 18 ? U32_ZERO_BIT_0(k_bits) : 18));
-    contexts[current_context].last_Z[l] = ((LASpoint14*)last_item)->Z;
-  }
+  stream->getBytes((U8*)&layered_index, sizeof(U32));
+  if (layered_count) return TRUE;
 
-  ////////////////////////////////////////
-  // decompress classifications layer (if changed and requested)
-  ////////////////////////////////////////
+  /* load the contexts that are in use */
 
-  if (changed_classification) // if the classification should be decompressed and changes within this chunk
+  stream->getBytes((U8*)&current_context, sizeof(U32));
+  for (c = 0; c < 4; c++)
   {
-    U32 last_classification = ((LASpoint14*)last_item)->classification;
-    I32 ccc = ((last_classification & 0x1F) << 1) + (cpr == 3 ? 1 : 0);
-    if (contexts[current_context].m_classification[ccc] == 0)
+    if (stream->getByte())
     {
-      contexts[current_context].m_classification[ccc] = dec_classification->createSymbolModel(256);
-      dec_classification->initSymbolModel(contexts[current_context].m_classification[ccc]);
+      contexts[c].unused = TRUE;
+      continue;
     }
-    ((LASpoint14*)last_item)->classification = dec_classification->decodeSymbol(contexts[current_context].m_classification[ccc]);
 
-    // update the legacy copy
-    if (((LASpoint14*)last_item)->classification < 32)
+    /* for the channel_returns_XY layer */
+
+    stream->getBytes(last_item, sizeof(last_item));
+    if (contexts[c].unused)
     {
-      ((LASpoint14*)last_item)->legacy_classification = ((LASpoint14*)last_item)->classification;
+      createAndInitModelsAndDecompressors(c, last_item);
     }
-    else
+    memcpy(contexts[c].last_item, last_item, sizeof(last_item));
+    stream->getBytes((U8*)contexts[c].last_X_diff_median5, sizeof(contexts[c].last_X_diff_median5));
+    stream->getBytes((U8*)contexts[c].last_Y_diff_median5, sizeof(contexts[c].last_Y_diff_median5));
+    for (i = 0; i < 8; i++)
     {
-      ((LASpoint14*)last_item)->legacy_classification = 0;
+      dec_channel_returns_XY->loadSymbolModel(stream, contexts[c].m_changed_values[i]);
     }
-  }
-
-  ////////////////////////////////////////
-  // decompress flags layer (if changed and requested)
-  ////////////////////////////////////////
-
-  if (changed_flags) // if the flags should be decompressed and change within this chunk
-  {
-    U32 last_flags = (((LASpoint14*)last_item)->edge_of_flight_line << 5) | (((LASpoint14*)last_item)->scan_direction_flag << 4) | ((LASpoint14*)last_item)->classification_flags;
-    if (contexts[current_context].m_flags[last_flags] == 0)
+    dec_channel_returns_XY->loadSymbolModel(stream, contexts[c].m_scanner_channel);
+    for (i = 0; i < 16; i++)
     {
-      contexts[current_context].m_flags[last_flags] = dec_flags->createSymbolModel(64);
-      dec_flags->initSymbolModel(contexts[current_context].m_flags[last_flags]);
+      dec_channel_returns_XY->loadSymbolModel(stream, contexts[c].m_number_of_returns[i]);
+      dec_channel_returns_XY->loadSymbolModel(stream, contexts[c].m_return_number[i]);
     }
-    U32 flags = dec_flags->decodeSymbol(contexts[current_context].m_flags[last_flags]);
-    ((LASpoint14*)last_item)->edge_of_flight_line = !!(flags & (1 << 5));
-    ((LASpoint14*)last_item)->scan_direction_flag = !!(flags & (1 << 4));
-    ((LASpoint14*)last_item)->classification_flags = (flags & 0x0F);
+    dec_channel_returns_XY->loadSymbolModel(stream, contexts[c].m_return_number_gps_same);
+    contexts[c].ic_dX->loadDecompressor(stream);
+    contexts[c].ic_dY->loadDecompressor(stream);
 
-    // legacy copies
-    ((LASpoint14*)last_item)->legacy_flags = (flags & 0x07);
-  }
-
-  ////////////////////////////////////////
-  // decompress intensity layer (if changed and requested)
-  ////////////////////////////////////////
+    /* for the Z layer */
 
-  if (changed_intensity) // if the intensity should be decompressed and changes within this chunk
-  {
-    U16 intensity = contexts[current_context].ic_intensity->decompress(contexts[current_context].last_intensity[(cpr<<1) | gps_time_change], cpr);
-    contexts[current_context].last_intensity[(cpr<<1) | gps_time_change] = intensity;
-    ((LASpoint14*)last_item)->intensity = intensity;
-  }
+    stream->getBytes((U8*)contexts[c].last_Z, sizeof(contexts[c].last_Z));
+    contexts[c].ic_Z->loadDecompressor(stream);
 
-  ////////////////////////////////////////
-  // decompress scan_angle layer (if changed and requested)
-  ////////////////////////////////////////
+    /* for the classification layer */
+    /* for the flags layer */
+    /* for the user_data layer */
 
-  if (changed_scan_angle) // if the scan angle should be decompressed and changes within this chunk
-  {
-    if (scan_angle_change) // if the scan angle has actually changed
+    for (i = 0; i < 64; i++)
     {
-      ((LASpoint14*)last_item)->scan_angle = contexts[current_context].ic_scan_angle->decompress(((LASpoint14*)last_item)->scan_angle, gps_time_change); // if the GPS time has changed
-      ((LASpoint14*)last_item)->legacy_scan_angle_rank = I8_CLAMP(I16_QUANTIZE(0.006f*((LASpoint14*)last_item)->scan_angle));
+      dec_classification->loadSymbolModel(stream, contexts[c].m_classification[i]);
+      dec_flags->loadSymbolModel(stream, contexts[c].m_flags[i]);
+      dec_user_data->loadSymbolModel(stream, contexts[c].m_user_data[i]);
     }
-  }
 
-  ////////////////////////////////////////
-  // decompress user_data layer (if changed and requested)
-  ////////////////////////////////////////
+    /* for the intensity layer */
 
-  if (changed_user_data) // if the user data should be decompressed and changes within this chunk
-  {
-    if (contexts[current_context].m_user_data[((LASpoint14*)last_item)->user_data/4] == 0)
-    {
-      contexts[current_context].m_user_data[((LASpoint14*)last_item)->user_data/4] = dec_user_data->createSymbolModel(256);
-      dec_user_data->initSymbolModel(contexts[current_context].m_user_data[((LASpoint14*)last_item)->user_data/4]);
-    }
-    ((LASpoint14*)last_item)->user_data = dec_user_data->decodeSymbol(contexts[current_context].m_user_data[((LASpoint14*)last_item)->user_data/4]);
-  }
+    stream->getBytes((U8*)contexts[c].last_intensity, sizeof(contexts[c].last_intensity));
+    contexts[c].ic_intensity->loadDecompressor(stream);
 
-  ////////////////////////////////////////
-  // decompress point_source layer (if changed and requested)
-  ////////////////////////////////////////
+    /* for the scan_angle layer */
 
-  if (changed_point_source) // if the point source ID should be decompressed and changes within this chunk
-  {
-    if (point_source_change) // if the point source ID has actually changed
-    {
-      ((LASpoint14*)last_item)->point_source_ID = contexts[current_context].ic_point_source_ID->decompress(((LASpoint14*)last_item)->point_source_ID);
-    }
-  }
+    contexts[c].ic_scan_angle->loadDecompressor(stream);
 
-  ////////////////////////////////////////
-  // decompress gps_time layer (if changed and requested)
-  ////////////////////////////////////////
+    /* for the point_source_ID layer */
 
-  if (changed_gps_time) // if the GPS time should be decompressed and changes within this chunk
-  {
-    if (gps_time_change) // if the GPS time has actually changed
-    {
-      read_gps_time();
-      ((LASpoint14*)last_item)->gps_time = contexts[current_context].last_gpstime[contexts[current_context].last].f64;
-    }
-  }
+    contexts[c].ic_point_source_ID->loadDecompressor(stream);
 
-  // copy the last item
-  memcpy(item, last_item, sizeof(LASpoint14));
-  // remember if the last point had a gps_time_change
-  ((LASpoint14*)last_item)->gps_time_change = gps_time_change;
-}
+    /* for the gps_time layer */
 
-void LASreadItemCompressed_POINT14_v3::read_gps_time()
-{
-  I32 multi;
-  if (contexts[current_context].last_gpstime_diff[contexts[current_context].last] == 0) // if the last integer difference was zero
-  {
-    multi = dec_gps_time->decodeSymbol(contexts[current_context].m_gpstime_0diff);
-    if (multi == 0) // the difference can be represented with 32 bits
-    {
-      contexts[current_context].last_gpstime_diff[contexts[current_context].last] = contexts[current_context].ic_gpstime->decompress(0, 0);
-      contexts[current_context].last_gpstime[contexts[current_context].last].i64 += contexts[current_context].last_gpstime_diff[contexts[current_context].last];
-      contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0; 
-    }
-    else if (multi == 1) // the difference is huge
-    {
-      contexts[current_context].next = (contexts[current_context].next+1)&3;
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 = contexts[current_context].ic_gpstime->decompress((I32)(contexts[current_context].last_gpstime[contexts[current_context].last].u64 >> 32), 8);
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 = contexts[current_context].last_gpstime[contexts[current_context].next].u64 << 32;
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 |= dec_gps_time->readInt();
-      contexts[current_context].last = contexts[current_context].next;
-      contexts[current_context].last_gpstime_diff[contexts[current_context].last] = 0;
-      contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0; 
-    }
-    else // we switch to another sequence
-    {
-      contexts[current_context].last = (contexts[current_context].last+multi-1)&3;
-      read_gps_time();
-    }
-  }
-  else
-  {
-    multi = dec_gps_time->decodeSymbol(contexts[current_context].m_gpstime_multi);
-    if (multi == 1)
-    {
-      contexts[current_context].last_gpstime[contexts[current_context].last].i64 += contexts[current_context].ic_gpstime->decompress(contexts[current_context].last_gpstime_diff[contexts[current_context].last], 1);;
-      contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0;
-    }
-    else if (multi < LASZIP_GPSTIME_MULTI_CODE_FULL)
-    {
-      I32 gpstime_diff;
-      if (multi == 0)
-      {
-        gpstime_diff = contexts[current_context].ic_gpstime->decompress(0, 7);
-        contexts[current_context].multi_extreme_counter[contexts[current_context].last]++;
-        if (contexts[current_context].multi_extreme_counter[contexts[current_context].last] > 3)
-        {
-          contexts[current_context].last_gpstime_diff[contexts[current_context].last] = gpstime_diff;
-          contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0;
-        }
-      }
-      else if (multi < LASZIP_GPSTIME_MULTI)
-      {
-        if (multi < 10)
-          gpstime_diff = contexts[current_context].ic_gpstime->decompress(multi*contexts[current_context].last_gpstime_diff[contexts[current_context].last], 2);
-        else
-          gpstime_diff = contexts[current_context].ic_gpstime->decompress(multi*contexts[current_context].last_gpstime_diff[contexts[current_context].last], 3);
-      }
-      else if (multi == LASZIP_GPSTIME_MULTI)
-      {
-        gpstime_diff = contexts[current_context].ic_gpstime->decompress(LASZIP_GPSTIME_MULTI*contexts[current_context].last_gpstime_diff[contexts[current_context].last], 4);
-        contexts[current_context].multi_extreme_counter[contexts[current_context].last]++;
-        if (contexts[current_context].multi_extreme_counter[contexts[current_context].last] > 3)
-        {
-          contexts[current_context].last_gpstime_diff[contexts[current_context].last] = gpstime_diff;
-          contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0;
-        }
-      }
-      else
-      {
-        multi = LASZIP_GPSTIME_MULTI - multi;
-        if (multi > LASZIP_GPSTIME_MULTI_MINUS)
-        {
-          gpstime_diff = contexts[current_context].ic_gpstime->decompress(multi*contexts[current_context].last_gpstime_diff[contexts[current_context].last], 5);
-        }
-        else
-        {
-          gpstime_diff = contexts[current_context].ic_gpstime->decompress(LASZIP_GPSTIME_MULTI_MINUS*contexts[current_context].last_gpstime_diff[contexts[current_context].last], 6);
-          contexts[current_context].multi_extreme_counter[contexts[current_context].last]++;
-          if (contexts[current_context].multi_extreme_counter[contexts[current_context].last] > 3)
-          {
-            contexts[current_context].last_gpstime_diff[contexts[current_context].last] = gpstime_diff;
-            contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0;
-          }
-        }
-      }
-      contexts[current_context].last_gpstime[contexts[current_context].last].i64 += gpstime_diff;
-    }
-    else if (multi ==  LASZIP_GPSTIME_MULTI_CODE_FULL)
-    {
-      contexts[current_context].next = (contexts[current_context].next+1)&3;
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 = contexts[current_context].ic_gpstime->decompress((I32)(contexts[current_context].last_gpstime[contexts[current_context].last].u64 >> 32), 8);
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 = contexts[current_context].last_gpstime[contexts[current_context].next].u64 << 32;
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 |= dec_gps_time->readInt();
-      contexts[current_context].last = contexts[current_context].next;
-      contexts[current_context].last_gpstime_diff[contexts[current_context].last] = 0;
-      contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0; 
-    }
-    else if (multi >=  LASZIP_GPSTIME_MULTI_CODE_FULL)
-    {
-      contexts[current_context].last = (contexts[current_context].last+multi-LASZIP_GPSTIME_MULTI_CODE_FULL)&3;
-      read_gps_time();
-    }
+    stream->getBytes((U8*)&contexts[c].last, sizeof(U32));
+    stream->getBytes((U8*)&contexts[c].next, sizeof(U32));
+    stream->getBytes((U8*)contexts[c].last_gpstime, sizeof(contexts[c].last_gpstime));
+    stream->getBytes((U8*)contexts[c].last_gpstime_diff, sizeof(contexts[c].last_gpstime_diff));
+    stream->getBytes((U8*)contexts[c].multi_extreme_counter, sizeof(contexts[c].multi_extreme_counter));
+    dec_gps_time->loadSymbolModel(stream, contexts[c].m_gpstime_multi);
+    dec_gps_time->loadSymbolModel(stream, contexts[c].m_gpstime_0diff);
+    contexts[c].ic_gpstime->loadDecompressor(stream);
   }
+
+  /* move the decoders to where they were in their layers */
+
+  if (!dec_channel_returns_XY->loadState(stream)) return FALSE;
+  if (changed_Z && !dec_Z->loadState(stream)) return FALSE;
+  if (changed_classification && !dec_classification->loadState(stream)) return FALSE;
+  if (changed_flags && !dec_flags->loadState(stream)) return FALSE;
+  if (changed_intensity && !dec_intensity->loadState(stream)) return FALSE;
+  if (changed_scan_angle && !dec_scan_angle->loadState(stream)) return FALSE;
+  if (changed_user_data && !dec_user_data->loadState(stream)) return FALSE;
+  if (changed_point_source && !dec_point_source->loadState(stream)) return FALSE;
+  if (changed_gps_time && !dec_gps_time->loadState(stream)) return FALSE;
+
+  return TRUE;
 }
 
 /*
@@ -1126,6 +780,7 @@ LASreadItemCompressed_RGB14_v3::LASreadItemCompressed_RGB14_v3(ArithmeticDecoder
 
   changed_RGB = FALSE;
 
+  this->decompress_selective = decompress_selective;
   requested_RGB = (decompress_selective & LASZIP_DECOMPRESS_SELECTIVE_RGB ? TRUE : FALSE);
 
   /* init the bytes buffer to zero */
@@ -1248,7 +903,8 @@ BOOL LASreadItemCompressed_RGB14_v3::init(const U8* item, U32& context)
 
     /* create decoders */
 
-    dec_RGB = new ArithmeticDecoder();
+    dec_RGB = new ArithmeticDecoder(dec->getCoder());
+    dec_RGB->setStatus(dec->getStatus());
   }
   
   /* make sure the buffer is sufficiently large */
@@ -1405,6 +1061,76 @@ inline void LASreadItemCompressed_RGB14_v3::read(U8* item, U32& context)
   }
 }
 
+void LASreadItemCompressed_RGB14_v3::request_layers(const U32 decompress_selective)
+{
+  requested_RGB = ((this->decompress_selective | decompress_selective) & LASZIP_DECOMPRESS_SELECTIVE_RGB ? TRUE : FALSE);
+}
+
+BOOL LASreadItemCompressed_RGB14_v3::save_state(ByteStreamOut* stream)
+{
+  U32 c;
+
+  /* save the contexts that are in use */
+
+  stream->putBytes((const U8*)&current_context, sizeof(U32));
+  for (c = 0; c < 4; c++)
+  {
+    stream->putByte(contexts[c].unused ? 1 : 0);
+    if (contexts[c].unused) continue;
+    stream->putBytes((const U8*)contexts[c].last_item, sizeof(contexts[c].last_item));
+    dec_RGB->saveSymbolModel(stream, contexts[c].m_byte_used);
+    dec_RGB->saveSymbolModel(stream, contexts[c].m_rgb_diff_0);
+    dec_RGB->saveSymbolModel(stream, contexts[c].m_rgb_diff_1);
+    dec_RGB->saveSymbolModel(stream, contexts[c].m_rgb_diff_2);
+    dec_RGB->saveSymbolModel(stream, contexts[c].m_rgb_diff_3);
+    dec_RGB->saveSymbolModel(stream, contexts[c].m_rgb_diff_4);
+    dec_RGB->saveSymbolModel(stream, contexts[c].m_rgb_diff_5);
+  }
+
+  /* save where the decoder is in its layer */
+
+  if (changed_RGB) dec_RGB->saveState(stream);
+
+  return TRUE;
+}
+
+BOOL LASreadItemCompressed_RGB14_v3::load_state(ByteStreamIn* stream)
+{
+  U32 c;
+  U16 last_item[3];
+
+  /* load the contexts that are in use */
+
+  stream->getBytes((U8*)&current_context, sizeof(U32));
+  for (c = 0; c < 4; c++)
+  {
+    if (stream->getByte())
+    {
+      contexts[c].unused = TRUE;
+      continue;
+    }
+    stream->getBytes((U8*)last_item, sizeof(last_item));
+    if (contexts[c].unused)
+    {
+      createAndInitModelsAndDecompressors(c, (U8*)last_item);
+    }
+    memcpy(contexts[c].last_item, last_item, sizeof(last_item));
+    dec_RGB->loadSymbolModel(stream, contexts[c].m_byte_used);
+    dec_RGB->loadSymbolModel(stream, contexts[c].m_rgb_diff_0);
+    dec_RGB->loadSymbolModel(stream, contexts[c].m_rgb_diff_1);
+    dec_RGB->loadSymbolModel(stream, contexts[c].m_rgb_diff_2);
+    dec_RGB->loadSymbolModel(stream, contexts[c].m_rgb_diff_3);
+    dec_RGB->loadSymbolModel(stream, contexts[c].m_rgb_diff_4);
+    dec_RGB->loadSymbolModel(stream, contexts[c].m_rgb_diff_5);
+  }
+
+  /* move the decoder to where it was in its layer */
+
+  if (changed_RGB && !dec_RGB->loadState(stream)) return FALSE;
+
+  return TRUE;
+}
+
 /*
 ===============================================================================
                     LASreadItemCompressed_RGBNIR14_v3
@@ -1434,6 +1160,7 @@ LASreadItemCompressed_RGBNIR14_v3::LASreadItemCompressed_RGBNIR14_v3(ArithmeticD
   changed_RGB = FALSE;
   changed_NIR = FALSE;
 
+  this->decompress_selective = decompress_selective;
   requested_RGB = (decompress_selective & LASZIP_DECOMPRESS_SELECTIVE_RGB ? TRUE : FALSE);
   requested_NIR = (decompress_selective & LASZIP_DECOMPRESS_SELECTIVE_NIR ? TRUE : FALSE);
 
@@ -1448,7 +1175,15 @@ LASreadItemCompressed_RGBNIR14_v3::LASreadItemCompressed_RGBNIR14_v3(ArithmeticD
   for (c = 0; c < 4; c++)
   {
     contexts[c].m_rgb_bytes_used = 0;
+    contexts[c].m_rgb_diff_0 = 0;
+    contexts[c].m_rgb_diff_1 = 0;
+    contexts[c].m_rgb_diff_2 = 0;
+    contexts[c].m_rgb_diff_3 = 0;
+    contexts[c].m_rgb_diff_4 = 0;
+    contexts[c].m_rgb_diff_5 = 0;
     contexts[c].m_nir_bytes_used = 0;
+    contexts[c].m_nir_diff_0 = 0;
+    contexts[c].m_nir_diff_1 = 0;
   }
   current_context = 0;
 }
@@ -1594,8 +1329,13 @@ BOOL LASreadItemCompressed_RGBNIR14_v3::init(const U8* item, U32& context)
 
     /* create decoders */
 
-    dec_RGB = new ArithmeticDecoder();
-    dec_NIR = new ArithmeticDecoder();
+    dec_RGB = new ArithmeticDecoder(dec->getCoder());
+    dec_NIR = new ArithmeticDecoder(dec->getCoder());
+
+    /* which report errors like the main decoder */
+
+    dec_RGB->setStatus(dec->getStatus());
+    dec_NIR->setStatus(dec->getStatus());
   }
   
   /* how many bytes do we need to read */
@@ -1822,6 +1562,85 @@ inline void LASreadItemCompressed_RGBNIR14_v3::read(U8* item, U32& context)
   }
 }
 
+void LASreadItemCompressed_RGBNIR14_v3::request_layers(const U32 decompress_selective)
+{
+  requested_RGB = ((this->decompress_selective | decompress_selective) & LASZIP_DECOMPRESS_SELECTIVE_RGB ? TRUE : FALSE);
+  requested_NIR = ((this->decompress_selective | decompress_selective) & LASZIP_DECOMPRESS_SELECTIVE_NIR ? TRUE : FALSE);
+}
+
+BOOL LASreadItemCompressed_RGBNIR14_v3::save_state(ByteStreamOut* stream)
+{
+  U32 c;
+
+  /* save the contexts that are in use */
+
+  stream->putBytes((const U8*)&current_context, sizeof(U32));
+  for (c = 0; c < 4; c++)
+  {
+    stream->putByte(contexts[c].unused ? 1 : 0);
+    if (contexts[c].unused) continue;
+    stream->putBytes((const U8*)contexts[c].last_item, sizeof(contexts[c].last_item));
+    dec_RGB->saveSymbolModel(stream, contexts[c].m_rgb_bytes_used);
+    dec_RGB->saveSymbolModel(stream, contexts[c].m_rgb_diff_0);
+    dec_RGB->saveSymbolModel(stream, contexts[c].m_rgb_diff_1);
+    dec_RGB->saveSymbolModel(stream, contexts[c].m_rgb_diff_2);
+    dec_RGB->saveSymbolModel(stream, contexts[c].m_rgb_diff_3);
+    dec_RGB->saveSymbolModel(stream, contexts[c].m_rgb_diff_4);
+    dec_RGB->saveSymbolModel(stream, contexts[c].m_rgb_diff_5);
+    dec_NIR->saveSymbolModel(stream, contexts[c].m_nir_bytes_used);
+    dec_NIR->saveSymbolModel(stream, contexts[c].m_nir_diff_0);
+    dec_NIR->saveSymbolModel(stream, contexts[c].m_nir_diff_1);
+  }
+
+  /* save where the decoders are in their layers */
+
+  if (changed_RGB) dec_RGB->saveState(stream);
+  if (changed_NIR) dec_NIR->saveState(stream);
+
+  return TRUE;
+}
+
+BOOL LASreadItemCompressed_RGBNIR14_v3::load_state(ByteStreamIn* stream)
+{
+  U32 c;
+  U16 last_item[4];
+
+  /* load the contexts that are in use */
+
+  stream->getBytes((U8*)&current_context, sizeof(U32));
+  for (c = 0; c < 4; c++)
+  {
+    if (stream->getByte())
+    {
+      contexts[c].unused = TRUE;
+      continue;
+    }
+    stream->getBytes((U8*)last_item, sizeof(last_item));
+    if (contexts[c].unused)
+    {
+      createAndInitModelsAndDecompressors(c, (U8*)last_item);
+    }
+    memcpy(contexts[c].last_item, last_item, sizeof(last_item));
+    dec_RGB->loadSymbolModel(stream, contexts[c].m_rgb_bytes_used);
+    dec_RGB->loadSymbolModel(stream, contexts[c].m_rgb_diff_0);
+    dec_RGB->loadSymbolModel(stream, contexts[c].m_rgb_diff_1);
+    dec_RGB->loadSymbolModel(stream, contexts[c].m_rgb_diff_2);
+    dec_RGB->loadSymbolModel(stream, contexts[c].m_rgb_diff_3);
+    dec_RGB->loadSymbolModel(stream, contexts[c].m_rgb_diff_4);
+    dec_RGB->loadSymbolModel(stream, contexts[c].m_rgb_diff_5);
+    dec_NIR->loadSymbolModel(stream, contexts[c].m_nir_bytes_used);
+    dec_NIR->loadSymbolModel(stream, contexts[c].m_nir_diff_0);
+    dec_NIR->loadSymbolModel(stream, contexts[c].m_nir_diff_1);
+  }
+
+  /* move the decoders to where they were in their layers */
+
+  if (changed_RGB && !dec_RGB->loadState(stream)) return FALSE;
+  if (changed_NIR && !dec_NIR->loadState(stream)) return FALSE;
+
+  return TRUE;
+}
+
 /*
 ===============================================================================
                        LASreadItemCompressed_WAVEPACKET14_v3
@@ -1847,6 +1666,7 @@ LASreadItemCompressed_WAVEPACKET14_v3::LASreadItemCompressed_WAVEPACKET14_v3(Ari
 
   changed_wavepacket = FALSE;
 
+  this->decompress_selective = decompress_selective;
   requested_wavepacket = (decompress_selective & LASZIP_DECOMPRESS_SELECTIVE_WAVEPACKET ? TRUE : FALSE);
 
   /* init the bytes buffer to zero */
@@ -1980,7 +1800,8 @@ BOOL LASreadItemCompressed_WAVEPACKET14_v3::init(const U8* item, U32& context)
 
     /* create decoders */
 
-    dec_wavepacket = new ArithmeticDecoder();
+    dec_wavepacket = new ArithmeticDecoder(dec->getCoder());
+    dec_wavepacket->setStatus(dec->getStatus());
   }
   
   /* make sure the buffer is sufficiently large */
@@ -2097,13 +1918,97 @@ inline void LASreadItemCompressed_WAVEPACKET14_v3::read(U8* item, U32& context)
   }
 }
 
+void LASreadItemCompressed_WAVEPACKET14_v3::request_layers(const U32 decompress_selective)
+{
+  requested_wavepacket = ((this->decompress_selective | decompress_selective) & LASZIP_DECOMPRESS_SELECTIVE_WAVEPACKET ? TRUE : FALSE);
+}
+
+BOOL LASreadItemCompressed_WAVEPACKET14_v3::save_state(ByteStreamOut* stream)
+{
+  U32 c;
+
+  /* save the contexts that are in use */
+
+  stream->putBytes((const U8*)&current_context, sizeof(U32));
+  for (c = 0; c < 4; c++)
+  {
+    stream->putByte(contexts[c].unused ? 1 : 0);
+    if (contexts[c].unused) continue;
+    stream->putBytes(contexts[c].last_item, sizeof(contexts[c].last_item));
+    stream->putBytes((const U8*)&contexts[c].last_diff_32, sizeof(I32));
+    stream->putBytes((const U8*)&contexts[c].sym_last_offset_diff, sizeof(U32));
+    if (requested_wavepacket)
+    {
+      dec_wavepacket->saveSymbolModel(stream, contexts[c].m_packet_index);
+      dec_wavepacket->saveSymbolModel(stream, contexts[c].m_offset_diff[0]);
+      dec_wavepacket->saveSymbolModel(stream, contexts[c].m_offset_diff[1]);
+      dec_wavepacket->saveSymbolModel(stream, contexts[c].m_offset_diff[2]);
+      dec_wavepacket->saveSymbolModel(stream, contexts[c].m_offset_diff[3]);
+      contexts[c].ic_offset_diff->saveDecompressor(stream);
+      contexts[c].ic_packet_size->saveDecompressor(stream);
+      contexts[c].ic_return_point->saveDecompressor(stream);
+      contexts[c].ic_xyz->saveDecompressor(stream);
+    }
+  }
+
+  /* save where the decoder is in its layer */
+
+  if (changed_wavepacket) dec_wavepacket->saveState(stream);
+
+  return TRUE;
+}
+
+BOOL LASreadItemCompressed_WAVEPACKET14_v3::load_state(ByteStreamIn* stream)
+{
+  U32 c;
+  U8 last_item[29];
+
+  /* load the contexts that are in use */
+
+  stream->getBytes((U8*)&current_context, sizeof(U32));
+  for (c = 0; c < 4; c++)
+  {
+    if (stream->getByte())
+    {
+      contexts[c].unused = TRUE;
+      continue;
+    }
+    stream->getBytes(last_item, sizeof(last_item));
+    if (contexts[c].unused)
+    {
+      createAndInitModelsAndDecompressors(c, last_item);
+    }
+    memcpy(contexts[c].last_item, last_item, sizeof(last_item));
+    stream->getBytes((U8*)&contexts[c].last_diff_32, sizeof(I32));
+    stream->getBytes((U8*)&contexts[c].sym_last_offset_diff, sizeof(U32));
+    if (requested_wavepacket)
+    {
+      dec_wavepacket->loadSymbolModel(stream, contexts[c].m_packet_index);
+      dec_wavepacket->loadSymbolModel(stream, contexts[c].m_offset_diff[0]);
+      dec_wavepacket->loadSymbolModel(stream, contexts[c].m_offset_diff[1]);
+      dec_wavepacket->loadSymbolModel(stream, contexts[c].m_offset_diff[2]);
+      dec_wavepacket->loadSymbolModel(stream, contexts[c].m_offset_diff[3]);
+      contexts[c].ic_offset_diff->loadDecompressor(stream);
+      contexts[c].ic_packet_size->loadDecompressor(stream);
+      contexts[c].ic_return_point->loadDecompressor(stream);
+      contexts[c].ic_xyz->loadDecompressor(stream);
+    }
+  }
+
+  /* move the decoder to where it was in its layer */
+
+  if (changed_wavepacket && !dec_wavepacket->loadState(stream)) return FALSE;
+
+  return TRUE;
+}
+
 /*
 ===============================================================================
                        LASreadItemCompressed_BYTE14_v3
 ===============================================================================
 */
 
-LASreadItemCompressed_BYTE14_v3::LASreadItemCompressed_BYTE14_v3(ArithmeticDecoder* dec, U32 number, const U32 decompress_selective)
+LASreadItemCompressed_BYTE14_v3::LASreadItemCompressed_BYTE14_v3(ArithmeticDecoder* dec, U32 number, const U32 decompress_selective, const U32 num_selective_bytes, const BOOL* selective_bytes)
 {
   /* not used as a decoder. just gives access to instream */
 
@@ -2127,6 +2032,8 @@ LASreadItemCompressed_BYTE14_v3::LASreadItemCompressed_BYTE14_v3(ArithmeticDecod
 
   changed_Bytes = new BOOL[number];
 
+  selected_Bytes = new BOOL[number];
+
   requested_Bytes = new BOOL[number];
 
   U32 i;
@@ -2136,14 +2043,20 @@ LASreadItemCompressed_BYTE14_v3::LASreadItemCompressed_BYTE14_v3(ArithmeticDecod
 
     changed_Bytes[i] = FALSE;
 
-    if (i > 15) // currently only the first 16 extra bytes can be selectively decompressed
+    if (selective_bytes) // the requested bytes override the BYTE flags of decompress_selective
     {
-      requested_Bytes[i] = TRUE;
+      selected_Bytes[i] = ((i < num_selective_bytes) && selective_bytes[i]);
+    }
+    else if (i > 15) // the BYTE flags only select among the first 16 extra bytes
+    {
+      selected_Bytes[i] = TRUE;
     }
     else
     {
-      requested_Bytes[i] = (decompress_selective & (LASZIP_DECOMPRESS_SELECTIVE_BYTE0 << i) ? TRUE : FALSE);
+      selected_Bytes[i] = (decompress_selective & (LASZIP_DECOMPRESS_SELECTIVE_BYTE0 << i) ? TRUE : FALSE);
     }
+
+    requested_Bytes[i] = selected_Bytes[i];
   }
 
   /* init the bytes buffer to zero */
@@ -2202,6 +2115,7 @@ LASreadItemCompressed_BYTE14_v3::~LASreadItemCompressed_BYTE14_v3()
 
   if (changed_Bytes) delete [] changed_Bytes;
 
+  if (selected_Bytes) delete [] selected_Bytes;
   if (requested_Bytes) delete [] requested_Bytes;
 
   if (bytes) delete [] bytes;
@@ -2305,7 +2219,8 @@ BOOL LASreadItemCompressed_BYTE14_v3::init(const U8* item, U32& context)
 
     for (i = 0; i < number; i++)
     {
-      dec_Bytes[i] = new ArithmeticDecoder();
+      dec_Bytes[i] = new ArithmeticDecoder(dec->getCoder());
+      dec_Bytes[i]->setStatus(dec->getStatus());
     }
   }
 
@@ -2413,3 +2328,121 @@ inline void LASreadItemCompressed_BYTE14_v3::read(U8* item, U32& context)
     }
   }
 }
+
+void LASreadItemCompressed_BYTE14_v3::request_layers(const U32 decompress_selective)
+{
+  U32 i;
+  for (i = 0; i < number; i++)
+  {
+    requested_Bytes[i] = (selected_Bytes[i] || ((i < 16) && (decompress_selective & (LASZIP_DECOMPRESS_SELECTIVE_BYTE0 << i))));
+  }
+}
+
+BOOL LASreadItemCompressed_BYTE14_v3::save_state(ByteStreamOut* stream)
+{
+  U32 c, i;
+
+  /* save the contexts that are in use */
+
+  stream->putBytes((const U8*)&current_context, sizeof(U32));
+  for (c = 0; c < 4; c++)
+  {
+    stream->putByte(contexts[c].unused ? 1 : 0);
+    if (contexts[c].unused) continue;
+    stream->putBytes(contexts[c].last_item, number);
+    for (i = 0; i < number; i++)
+    {
+      dec_Bytes[i]->saveSymbolModel(stream, contexts[c].m_bytes[i]);
+    }
+  }
+
+  /* save where the decoders are in their layers */
+
+  for (i = 0; i < number; i++)
+  {
+    if (changed_Bytes[i]) dec_Bytes[i]->saveState(stream);
+  }
+
+  return TRUE;
+}
+
+BOOL LASreadItemCompressed_BYTE14_v3::load_state(ByteStreamIn* stream)
+{
+  U32 c, i;
+  U8* last_item = new U8[number];
+
+  /* load the contexts that are in use */
+
+  stream->getBytes((U8*)&current_context, sizeof(U32));
+  for (c = 0; c < 4; c++)
+  {
+    if (stream->getByte())
+    {
+      contexts[c].unused = TRUE;
+      continue;
+    }
+    stream->getBytes(last_item, number);
+    if (contexts[c].unused)
+    {
+      createAndInitModelsAndDecompressors(c, last_item);
+    }
+    memcpy(contexts[c].last_item, last_item, number);
+    for (i = 0; i < number; i++)
+    {
+      dec_Bytes[i]->loadSymbolModel(stream, contexts[c].m_bytes[i]);
+    }
+  }
+  delete [] last_item;
+
+  /* move the decoders to where they were in their layers */
+
+  for (i = 0; i < number; i++)
+  {
+    if (changed_Bytes[i] && !dec_Bytes[i]->loadState(stream)) return FALSE;
+  }
+
+  return TRUE;
+}
+
+// the standard point types 6 to 8 (with or without extra bytes)
+
+typedef LASreadItemsFusedList<LASreadItemCompressed_BYTE14_v3, LASreadItemsFusedEnd> LASreadItemsFused_BYTE14_v3;
+
+template <class TAIL>
+static LASreadItemsFused* laszip_fuse_readers_v3(const U32 num_items, const LASitem* items, LASreadItem** readers)
+{
+  typedef LASreadItemsFusedList<LASreadItemCompressed_RGB14_v3, TAIL> RGB14_TAIL;
+  typedef LASreadItemsFusedList<LASreadItemCompressed_RGBNIR14_v3, TAIL> RGBNIR14_TAIL;
+
+  if (num_items == 1)
+  {
+    return new LASreadItemsFusedTemplate< LASreadItemsFusedList<LASreadItemCompressed_POINT14_v3, TAIL> >(readers);
+  }
+  else if ((num_items == 2) && (items[1].type == LASitem::RGB14))
+  {
+    return new LASreadItemsFusedTemplate< LASreadItemsFusedList<LASreadItemCompressed_POINT14_v3, RGB14_TAIL> >(readers);
+  }
+  else if ((num_items == 2) && (items[1].type == LASitem::RGBNIR14))
+  {
+    return new LASreadItemsFusedTemplate< LASreadItemsFusedList<LASreadItemCompressed_POINT14_v3, RGBNIR14_TAIL> >(readers);
+  }
+  return 0;
+}
+
+LASreadItemsFused* laszip_fuse_readers_v3(const U32 num_items, const LASitem* items, LASreadItem** readers)
+{
+  U32 i;
+  for (i = 0; i < num_items; i++)
+  {
+    if ((items[i].version != 3) && (items[i].version != 2)) return 0;
+  }
+  if ((num_items == 0) || (items[0].type != LASitem::POINT14))
+  {
+    return 0;
+  }
+  if ((num_items > 1) && (items[num_items-1].type == LASitem::BYTE14))
+  {
+    return laszip_fuse_readers_v3<LASreadItemsFused_BYTE14_v3>(num_items-1, items, readers);
+  }
+  return laszip_fuse_readers_v3<LASreadItemsFusedEnd>(num_items, items, readers);
+}
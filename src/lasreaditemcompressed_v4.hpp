@@ -24,6 +24,15 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- zero all RGBNIR14 models so that saving the state never reads garbage
+    16 October 2026 -- the layers are decoded by the functions shared with the other version in LASreadItemLayered_POINT14
+    16 October 2026 -- more layers can be requested from one chunk to the next
+    16 October 2026 -- selective decompression of any of the extra bytes (not only the first 16)
+    16 October 2026 -- fused reading of the items of the point types 6 to 8
+    16 October 2026 -- threads keep the errors of their layers in their own status
+    16 October 2026 -- threads decompress their share of the layers of a chunk in lockstep
+    16 October 2026 -- save and load the state between two points for seek checkpoints
+    16 October 2026 -- optionally decompress the layers of a chunk in parallel
     19 March 2019 -- set "legacy classification" to zero if "classification > 31"  
     28 December 2017 -- fix incorrect 'context switch' reported by Wanwannodao 
     28 August 2017 -- moving 'context' from global development hack to interface  
@@ -40,27 +49,30 @@
 #include "integercompressor.hpp"
 #include "bytestreamin_array.hpp"
 
+#include "lasreaditemlayered.hpp"
 #include "laszip_common_v3.hpp"
 #include "laszip_decompress_selective_v3.hpp"
 
-class LASreadItemCompressed_POINT14_v4 : public LASreadItemCompressed
+class LASitem;
+class LASreadItemsFused;
+
+class LASreadItemCompressed_POINT14_v4 : public LASreadItemLayered_POINT14
 {
 public:
 
-  LASreadItemCompressed_POINT14_v4(ArithmeticDecoder* dec, const U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL);
+  LASreadItemCompressed_POINT14_v4(ArithmeticDecoder* dec, const U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL, const BOOL parallel_layers=FALSE);
 
   BOOL chunk_sizes();
   BOOL init(const U8* item, U32& context); // context is set
   void read(U8* item, U32& context);       // context is set
+  BOOL save_state(ByteStreamOut* stream);
+  BOOL load_state(ByteStreamIn* stream);
+  void request_layers(const U32 decompress_selective);
 
   ~LASreadItemCompressed_POINT14_v4();
 
 private:
 
-  /* not used as a decoder. just gives access to instream */
-  
-  ArithmeticDecoder* dec;
-
   ByteStreamInArray* instream_channel_returns_XY;
   ByteStreamInArray* instream_Z;
   ByteStreamInArray* instream_classification;
@@ -71,25 +83,6 @@ private:
   ByteStreamInArray* instream_point_source;
   ByteStreamInArray* instream_gps_time;
 
-  ArithmeticDecoder* dec_channel_returns_XY;
-  ArithmeticDecoder* dec_Z;
-  ArithmeticDecoder* dec_classification;
-  ArithmeticDecoder* dec_flags;
-  ArithmeticDecoder* dec_intensity;
-  ArithmeticDecoder* dec_scan_angle;
-  ArithmeticDecoder* dec_user_data;
-  ArithmeticDecoder* dec_point_source;
-  ArithmeticDecoder* dec_gps_time;
-
-  BOOL changed_Z;
-  BOOL changed_classification;
-  BOOL changed_flags;
-  BOOL changed_intensity;
-  BOOL changed_scan_angle;
-  BOOL changed_user_data;
-  BOOL changed_point_source;
-  BOOL changed_gps_time;
-
   U32 num_bytes_channel_returns_XY;
   U32 num_bytes_Z;
   U32 num_bytes_classification;
@@ -100,6 +93,7 @@ private:
   U32 num_bytes_point_source;
   U32 num_bytes_gps_time;
 
+  U32 decompress_selective;
   BOOL requested_Z;
   BOOL requested_classification;
   BOOL requested_flags;
@@ -111,12 +105,6 @@ private:
 
   U8* bytes;
   U32 num_bytes_allocated;
-
-  U32 current_context;
-  LAScontextPOINT14 contexts[4];
-
-  BOOL createAndInitModelsAndDecompressors(U32 context, const U8* item);
-  void read_gps_time();
 };
 
 class LASreadItemCompressed_RGB14_v4 : public LASreadItemCompressed
@@ -128,6 +116,9 @@ public:
   BOOL chunk_sizes();
   BOOL init(const U8* item, U32& context); // context is only read
   void read(U8* item, U32& context);       // context is only read
+  BOOL save_state(ByteStreamOut* stream);
+  BOOL load_state(ByteStreamIn* stream);
+  void request_layers(const U32 decompress_selective);
 
   ~LASreadItemCompressed_RGB14_v4();
 
@@ -145,6 +136,7 @@ private:
 
   U32 num_bytes_RGB;
 
+  U32 decompress_selective;
   BOOL requested_RGB;
 
   U8* bytes;
@@ -165,6 +157,9 @@ public:
   BOOL chunk_sizes();
   BOOL init(const U8* item, U32& context); // context is only read
   void read(U8* item, U32& context);       // context is only read
+  BOOL save_state(ByteStreamOut* stream);
+  BOOL load_state(ByteStreamIn* stream);
+  void request_layers(const U32 decompress_selective);
 
   ~LASreadItemCompressed_RGBNIR14_v4();
 
@@ -186,6 +181,7 @@ private:
   U32 num_bytes_RGB;
   U32 num_bytes_NIR;
 
+  U32 decompress_selective;
   BOOL requested_RGB;
   BOOL requested_NIR;
 
@@ -207,6 +203,9 @@ public:
   BOOL chunk_sizes();
   BOOL init(const U8* item, U32& context); // context is only read
   void read(U8* item, U32& context);       // context is only read
+  BOOL save_state(ByteStreamOut* stream);
+  BOOL load_state(ByteStreamIn* stream);
+  void request_layers(const U32 decompress_selective);
 
   ~LASreadItemCompressed_WAVEPACKET14_v4();
 
@@ -224,6 +223,7 @@ private:
 
   U32 num_bytes_wavepacket;
 
+  U32 decompress_selective;
   BOOL requested_wavepacket;
 
   U8* bytes;
@@ -239,11 +239,14 @@ class LASreadItemCompressed_BYTE14_v4 : public LASreadItemCompressed
 {
 public:
 
-  LASreadItemCompressed_BYTE14_v4(ArithmeticDecoder* dec, U32 number, const U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL);
+  LASreadItemCompressed_BYTE14_v4(ArithmeticDecoder* dec, U32 number, const U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL, const U32 num_selective_bytes=0, const BOOL* selective_bytes=0);
 
   BOOL chunk_sizes();
   BOOL init(const U8* item, U32& context); // context is only read
   void read(U8* item, U32& context);       // context is only read
+  BOOL save_state(ByteStreamOut* stream);
+  BOOL load_state(ByteStreamIn* stream);
+  void request_layers(const U32 decompress_selective);
 
   ~LASreadItemCompressed_BYTE14_v4();
 
@@ -261,6 +264,7 @@ private:
 
   BOOL* changed_Bytes;
 
+  BOOL* selected_Bytes;
   BOOL* requested_Bytes;
 
   U8* bytes;
@@ -273,4 +277,9 @@ private:
   BOOL createAndInitModelsAndDecompressors(U32 context, const U8* item);
 };
 
+// one reader for all items of the point types 6 to 8 (with or without extra
+// bytes) that were created as version 4 readers or 0 for any other items
+
+LASreadItemsFused* laszip_fuse_readers_v4(const U32 num_items, const LASitem* items, LASreadItem** readers);
+
 #endif
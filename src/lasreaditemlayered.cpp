@@ -0,0 +1,1076 @@
+/*
+===============================================================================
+
+  FILE:  lasreaditemlayered.cpp
+  
+  CONTENTS:
+  
+    see corresponding header file
+  
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  
+  CHANGE HISTORY:
+  
+    see corresponding header file
+  
+===============================================================================
+*/
+
+#include "lasreaditemlayered.hpp"
+#include "lasthreadpool.hpp"
+
+#include <cassert>
+#include <string.h>
+
+#include <thread>
+
+typedef struct LASpoint14
+{
+  I32 X;
+  I32 Y;
+  I32 Z;
+  U16 intensity;
+  U8 legacy_return_number : 3;
+  U8 legacy_number_of_returns : 3;
+  U8 scan_direction_flag : 1;
+  U8 edge_of_flight_line : 1;
+  U8 legacy_classification : 5;
+  U8 legacy_flags : 3;
+  I8 legacy_scan_angle_rank;
+  U8 user_data;
+  U16 point_source_ID;
+
+  // LAS 1.4 only
+  I16 scan_angle;
+  U8 legacy_point_type : 2;
+  U8 scanner_channel : 2;
+  U8 classification_flags : 4;
+  U8 classification;
+  U8 return_number : 4;
+  U8 number_of_returns : 4;
+
+  // LASlib internal use only
+  U8 deleted_flag;
+
+  // for 8 byte alignment of the GPS time
+  U8 dummy[2];
+
+  // compressed LASzip 1.4 points only
+  BOOL gps_time_change;
+
+  F64 gps_time;
+  U16 rgb[4];
+//  LASwavepacket wavepacket;
+} LASpoint14;
+
+#define LASZIP_GPSTIME_MULTI 500
+#define LASZIP_GPSTIME_MULTI_MINUS -10
+#define LASZIP_GPSTIME_MULTI_CODE_FULL (LASZIP_GPSTIME_MULTI - LASZIP_GPSTIME_MULTI_MINUS + 1)
+
+#define LASZIP_GPSTIME_MULTI_TOTAL (LASZIP_GPSTIME_MULTI - LASZIP_GPSTIME_MULTI_MINUS + 5) 
+
+LASreadItemLayered_POINT14::LASreadItemLayered_POINT14(ArithmeticDecoder* dec, const BOOL parallel_layers)
+{
+  /* not used as a decoder. just gives access to instream */
+
+  assert(dec);
+  this->dec = dec;
+
+  /* zero decoders */
+
+  dec_channel_returns_XY = 0;
+  dec_Z = 0;
+  dec_classification = 0;
+  dec_flags = 0;
+  dec_intensity = 0;
+  dec_scan_angle = 0;
+  dec_user_data = 0;
+  dec_point_source = 0;
+  dec_gps_time = 0;
+
+  /* mark the four scanner channel contexts as uninitialized */
+
+  U32 c;
+  for (c = 0; c < 4; c++)
+  {
+    contexts[c].m_changed_values[0] = 0;
+  }
+  current_context = 0;
+
+  /* init booleans */
+
+  changed_Z = FALSE;
+  changed_classification = FALSE;
+  changed_flags = FALSE;
+  changed_intensity = FALSE;
+  changed_scan_angle = FALSE;
+  changed_user_data = FALSE;
+  changed_point_source = FALSE;
+  changed_gps_time = FALSE;
+
+  /* by default the layers are decompressed point by point */
+
+  this->parallel_layers = parallel_layers;
+  chunk_count = 0;
+  layered_count = 0;
+  layered_index = 0;
+  layered_allocated = 0;
+  layered_context = 0;
+  layered_points = 0;
+  pool = 0;
+}
+
+LASreadItemLayered_POINT14::~LASreadItemLayered_POINT14()
+{
+  /* the readers destroy the contexts, the decoders, and their instreams */
+
+  if (layered_points) delete [] layered_points;
+  if (pool) delete pool;
+}
+
+BOOL LASreadItemLayered_POINT14::createAndInitModelsAndDecompressors(U32 context, const U8* item)
+{
+  I32 i;
+
+  /* should only be called when context is unused */
+
+  assert(contexts[context].unused);
+
+  /* first create all entropy models and integer decompressors (if needed) */
+
+  if (contexts[context].m_changed_values[0] == 0)
+  {
+    /* for the channel_returns_XY layer */
+
+    contexts[context].m_changed_values[0] = dec_channel_returns_XY->createSymbolModel(128);
+    contexts[context].m_changed_values[1] = dec_channel_returns_XY->createSymbolModel(128);
+    contexts[context].m_changed_values[2] = dec_channel_returns_XY->createSymbolModel(128);
+    contexts[context].m_changed_values[3] = dec_channel_returns_XY->createSymbolModel(128);
+    contexts[context].m_changed_values[4] = dec_channel_returns_XY->createSymbolModel(128);
+    contexts[context].m_changed_values[5] = dec_channel_returns_XY->createSymbolModel(128);
+    contexts[context].m_changed_values[6] = dec_channel_returns_XY->createSymbolModel(128);
+    contexts[context].m_changed_values[7] = dec_channel_returns_XY->createSymbolModel(128);
+    contexts[context].m_scanner_channel = dec_channel_returns_XY->createSymbolModel(3);
+    for (i = 0; i < 16; i++)
+    {
+      contexts[context].m_number_of_returns[i] = 0;
+      contexts[context].m_return_number[i] = 0;
+    }
+    contexts[context].m_return_number_gps_same = dec_channel_returns_XY->createSymbolModel(13);
+
+    contexts[context].ic_dX = new IntegerCompressorFixed<32>(dec_channel_returns_XY, 2);  // 32 bits, 2 context
+    contexts[context].ic_dY = new IntegerCompressorFixed<32>(dec_channel_returns_XY, 22); // 32 bits, 22 contexts
+
+    /* for the Z layer */
+
+    contexts[context].ic_Z = new IntegerCompressorFixed<32>(dec_Z, 20);  // 32 bits, 20 contexts
+
+    /* for the classification layer */
+    /* for the flags layer */
+    /* for the user_data layer */
+
+    for (i = 0; i < 64; i++)
+    {
+      contexts[context].m_classification[i] = 0;
+      contexts[context].m_flags[i] = 0;
+      contexts[context].m_user_data[i] = 0;
+    }
+
+    /* for the intensity layer */
+
+    contexts[context].ic_intensity = new IntegerCompressorFixed<16>(dec_intensity, 4);
+
+    /* for the scan_angle layer */
+
+    contexts[context].ic_scan_angle = new IntegerCompressorFixed<16>(dec_scan_angle, 2);
+
+    /* for the point_source_ID layer */
+
+    contexts[context].ic_point_source_ID = new IntegerCompressorFixed<16>(dec_point_source);
+
+    /* for the gps_time layer */
+
+    contexts[context].m_gpstime_multi = dec_gps_time->createSymbolModel(LASZIP_GPSTIME_MULTI_TOTAL);
+    contexts[context].m_gpstime_0diff = dec_gps_time->createSymbolModel(5);
+    contexts[context].ic_gpstime = new IntegerCompressorFixed<32>(dec_gps_time, 9); // 32 bits, 9 contexts
+  }
+
+  /* then init entropy models and integer compressors */
+
+  /* for the channel_returns_XY layer */
+
+  dec_channel_returns_XY->initSymbolModel(contexts[context].m_changed_values[0]);
+  dec_channel_returns_XY->initSymbolModel(contexts[context].m_changed_values[1]);
+  dec_channel_returns_XY->initSymbolModel(contexts[context].m_changed_values[2]);
+  dec_channel_returns_XY->initSymbolModel(contexts[context].m_changed_values[3]);
+  dec_channel_returns_XY->initSymbolModel(contexts[context].m_changed_values[4]);
+  dec_channel_returns_XY->initSymbolModel(contexts[context].m_changed_values[5]);
+  dec_channel_returns_XY->initSymbolModel(contexts[context].m_changed_values[6]);
+  dec_channel_returns_XY->initSymbolModel(contexts[context].m_changed_values[7]);
+  dec_channel_returns_XY->initSymbolModel(contexts[context].m_scanner_channel);
+  for (i = 0; i < 16; i++)
+  {
+    if (contexts[context].m_number_of_returns[i]) dec_channel_returns_XY->initSymbolModel(contexts[context].m_number_of_returns[i]);
+    if (contexts[context].m_return_number[i]) dec_channel_returns_XY->initSymbolModel(contexts[context].m_return_number[i]);
+  }
+  dec_channel_returns_XY->initSymbolModel(contexts[context].m_return_number_gps_same);
+  contexts[context].ic_dX->initDecompressor();
+  contexts[context].ic_dY->initDecompressor();
+  for (i = 0; i < 12; i++)
+  {
+    contexts[context].last_X_diff_median5[i].init();
+    contexts[context].last_Y_diff_median5[i].init();
+  }
+
+  /* for the Z layer */
+
+  contexts[context].ic_Z->initDecompressor();
+  for (i = 0; i < 8; i++)
+  {
+    contexts[context].last_Z[i] = ((const LASpoint14*)item)->Z;
+  }
+
+  /* for the classification layer */
+  /* for the flags layer */
+  /* for the user_data layer */
+
+  for (i = 0; i < 64; i++)
+  {
+    if (contexts[context].m_classification[i]) dec_classification->initSymbolModel(contexts[context].m_classification[i]);
+    if (contexts[context].m_flags[i]) dec_flags->initSymbolModel(contexts[context].m_flags[i]);
+    if (contexts[context].m_user_data[i]) dec_user_data->initSymbolModel(contexts[context].m_user_data[i]);
+  }
+
+  /* for the intensity layer */
+
+  contexts[context].ic_intensity->initDecompressor();
+  for (i = 0; i < 8; i++)
+  {
+    contexts[context].last_intensity[i] = ((const LASpoint14*)item)->intensity;
+  }
+
+  /* for the scan_angle layer */
+
+  contexts[context].ic_scan_angle->initDecompressor();
+
+  /* for the point_source_ID layer */
+
+  contexts[context].ic_point_source_ID->initDecompressor();
+
+  /* for the gps_time layer */
+
+  dec_gps_time->initSymbolModel(contexts[context].m_gpstime_multi);
+  dec_gps_time->initSymbolModel(contexts[context].m_gpstime_0diff);
+  contexts[context].ic_gpstime->initDecompressor();
+  contexts[context].last = 0, contexts[context].next = 0;
+  contexts[context].last_gpstime_diff[0] = 0;
+  contexts[context].last_gpstime_diff[1] = 0;
+  contexts[context].last_gpstime_diff[2] = 0;
+  contexts[context].last_gpstime_diff[3] = 0;
+  contexts[context].multi_extreme_counter[0] = 0;
+  contexts[context].multi_extreme_counter[1] = 0;
+  contexts[context].multi_extreme_counter[2] = 0;
+  contexts[context].multi_extreme_counter[3] = 0;
+  contexts[context].last_gpstime[0].f64 = ((const LASpoint14*)item)->gps_time;
+  contexts[context].last_gpstime[1].u64 = 0;
+  contexts[context].last_gpstime[2].u64 = 0;
+  contexts[context].last_gpstime[3].u64 = 0;
+
+  /* init current context from last item */
+
+  memcpy(contexts[context].last_item, item, sizeof(LASpoint14));
+  ((LASpoint14*)contexts[context].last_item)->gps_time_change = FALSE;
+
+//  LASMessage(LAS_VERBOSE, "INIT: current_context %d last item %.14g %d %d %d %d %d %d", current_context, ((LASpoint14*)item)->gps_time, ((LASpoint14*)item)->X, ((LASpoint14*)item)->Y, ((LASpoint14*)item)->Z, ((LASpoint14*)item)->intensity, ((LASpoint14*)item)->return_number, ((LASpoint14*)item)->number_of_returns);
+
+  contexts[context].unused = FALSE;
+
+  return TRUE;
+}
+
+U32 LASreadItemLayered_POINT14::read_point(U8* item, BOOL& switched)
+{
+  // serve the point if the layers of this chunk were decompressed up front
+
+  if (layered_index < layered_count)
+  {
+    const LASlayeredPOINT14* point = &layered_points[layered_index++];
+    memcpy(item, point->item, sizeof(LASpoint14));
+    if (changed_Z)
+    {
+      ((LASpoint14*)item)->Z = point->Z;
+    }
+    if (changed_classification)
+    {
+      ((LASpoint14*)item)->classification = point->classification;
+      ((LASpoint14*)item)->legacy_classification = (point->classification < 32 ? point->classification : 0);
+    }
+    if (changed_flags)
+    {
+      ((LASpoint14*)item)->edge_of_flight_line = !!(point->flags & (1 << 5));
+      ((LASpoint14*)item)->scan_direction_flag = !!(point->flags & (1 << 4));
+      ((LASpoint14*)item)->classification_flags = (point->flags & 0x0F);
+      ((LASpoint14*)item)->legacy_flags = (point->flags & 0x07);
+    }
+    if (changed_intensity)
+    {
+      ((LASpoint14*)item)->intensity = point->intensity;
+    }
+    if (changed_scan_angle)
+    {
+      ((LASpoint14*)item)->scan_angle = point->scan_angle;
+      ((LASpoint14*)item)->legacy_scan_angle_rank = point->legacy_scan_angle_rank;
+    }
+    if (changed_user_data)
+    {
+      ((LASpoint14*)item)->user_data = point->user_data;
+    }
+    if (changed_point_source)
+    {
+      ((LASpoint14*)item)->point_source_ID = point->point_source_ID;
+    }
+    if (changed_gps_time)
+    {
+      ((LASpoint14*)item)->gps_time = point->gps_time;
+    }
+    switched = (point->changes & LASZIP_LAYERED_SWITCHED_CONTEXT ? TRUE : FALSE);
+    return point->context;
+  }
+
+  // otherwise decompress the channel_returns_XY layer and then each of the
+  // other layers (if changed and requested) into the last item
+
+  LASlayeredPOINT14 layered;
+  read_channel_returns_XY(&layered);
+  switched = (layered.changes & LASZIP_LAYERED_SWITCHED_CONTEXT ? TRUE : FALSE);
+
+  LAScontextPOINT14* c = &contexts[current_context];
+  LASpoint14* last_item = (LASpoint14*)c->last_item;
+  U32 gps_time_change = (layered.changes & LASZIP_LAYERED_GPS_TIME_CHANGE ? 1 : 0);
+
+  if (changed_Z)
+  {
+    last_item->Z = read_Z(c, layered.l, layered.k_Z);
+  }
+
+  if (changed_classification)
+  {
+    last_item->classification = read_classification(c, last_item->classification, layered.cpr);
+
+    // update the legacy copy
+    if (last_item->classification < 32)
+    {
+      last_item->legacy_classification = last_item->classification;
+    }
+    else
+    {
+      last_item->legacy_classification = 0;
+    }
+  }
+
+  if (changed_flags)
+  {
+    U8 flags = read_flags(c, (last_item->edge_of_flight_line << 5) | (last_item->scan_direction_flag << 4) | last_item->classification_flags);
+    last_item->edge_of_flight_line = !!(flags & (1 << 5));
+    last_item->scan_direction_flag = !!(flags & (1 << 4));
+    last_item->classification_flags = (flags & 0x0F);
+
+    // legacy copies
+    last_item->legacy_flags = (flags & 0x07);
+  }
+
+  if (changed_intensity)
+  {
+    last_item->intensity = read_intensity(c, layered.cpr, gps_time_change);
+  }
+
+  if (changed_scan_angle)
+  {
+    if (layered.changes & LASZIP_LAYERED_SCAN_ANGLE_CHANGE) // if the scan angle has actually changed
+    {
+      last_item->scan_angle = read_scan_angle(c, last_item->scan_angle, gps_time_change);
+      last_item->legacy_scan_angle_rank = I8_CLAMP(I16_QUANTIZE(0.006f*last_item->scan_angle));
+    }
+  }
+
+  if (changed_user_data)
+  {
+    last_item->user_data = read_user_data(c, last_item->user_data);
+  }
+
+  if (changed_point_source)
+  {
+    if (layered.changes & LASZIP_LAYERED_POINT_SOURCE_CHANGE) // if the point source ID has actually changed
+    {
+      last_item->point_source_ID = read_point_source(c, last_item->point_source_ID);
+    }
+  }
+
+  if (changed_gps_time)
+  {
+    if (gps_time_change) // if the GPS time has actually changed
+    {
+      read_gps_time(c);
+      last_item->gps_time = c->last_gpstime[c->last].f64;
+    }
+  }
+
+  // copy the last item
+  memcpy(item, last_item, sizeof(LASpoint14));
+  // remember if the last point had a gps_time_change
+  last_item->gps_time_change = gps_time_change;
+
+  return current_context;
+}
+
+////////////////////////////////////////
+// decompress returns_XY layer
+////////////////////////////////////////
+
+inline void LASreadItemLayered_POINT14::read_channel_returns_XY(LASlayeredPOINT14* point)
+{
+  // get last
+
+  U8* last_item = contexts[current_context].last_item;
+
+  point->changes = 0;
+
+  // create single (3) / first (1) / last (2) / intermediate (0) context from last point return
+
+  I32 lpr = (((LASpoint14*)last_item)->return_number == 1 ? 1 : 0); // first?
+  lpr += (((LASpoint14*)last_item)->return_number >= ((LASpoint14*)last_item)->number_of_returns ? 2 : 0); // last?
+
+  // add info whether the GPS time changed in the last return to the context
+
+  lpr += (((LASpoint14*)last_item)->gps_time_change ? 4 : 0);
+
+  // decompress which values have changed with last point return context
+
+  I32 changed_values = dec_channel_returns_XY->decodeSymbol(contexts[current_context].m_changed_values[lpr]);
+
+  // if scanner channel has changed
+
+  if (changed_values & (1 << 6))
+  {
+    U32 diff = dec_channel_returns_XY->decodeSymbol(contexts[current_context].m_scanner_channel); // curr = last + (sym + 1)
+    U32 scanner_channel = (current_context + diff + 1) % 4;
+    // maybe create and init entropy models and integer decompressors
+    if (contexts[scanner_channel].unused)
+    {
+      // create and init entropy models and integer decompressors
+      createAndInitModelsAndDecompressors(scanner_channel, contexts[current_context].last_item);
+      // the other layers init their state of this context from the previous point
+      point->changes |= LASZIP_LAYERED_NEW_CONTEXT;
+    }
+    // switch context to current scanner channel
+    current_context = scanner_channel;
+    point->changes |= LASZIP_LAYERED_SWITCHED_CONTEXT;
+
+    // get last for new context
+    last_item = contexts[current_context].last_item;
+    ((LASpoint14*)last_item)->scanner_channel = scanner_channel;
+  }
+  point->context = (U8)current_context;
+
+  // determine changed attributes
+
+  BOOL gps_time_change = (changed_values & (1 << 4) ? TRUE : FALSE);
+
+  if (changed_values & (1 << 5)) point->changes |= LASZIP_LAYERED_POINT_SOURCE_CHANGE;
+  if (changed_values & (1 << 4)) point->changes |= LASZIP_LAYERED_GPS_TIME_CHANGE;
+  if (changed_values & (1 << 3)) point->changes |= LASZIP_LAYERED_SCAN_ANGLE_CHANGE;
+
+  // get last return counts
+
+  U32 last_n = ((LASpoint14*)last_item)->number_of_returns;
+  U32 last_r = ((LASpoint14*)last_item)->return_number;
+
+  // if number of returns is different we decompress it
+
+  U32 n;
+  if (changed_values & (1 << 2))
+  {
+    if (contexts[current_context].m_number_of_returns[last_n] == 0)
+    {
+      contexts[current_context].m_number_of_returns[last_n] = dec_channel_returns_XY->createSymbolModel(16);
+      dec_channel_returns_XY->initSymbolModel(contexts[current_context].m_number_of_returns[last_n]);
+    }
+    n = dec_channel_returns_XY->decodeSymbol(contexts[current_context].m_number_of_returns[last_n]);
+    ((LASpoint14*)last_item)->number_of_returns = n;
+  }
+  else
+  {
+    n = last_n;
+  }
+
+  // how is the return number different
+
+  U32 r;
+  if ((changed_values & 3) == 0) // same return number
+  {
+    r = last_r;
+  }
+  else if ((changed_values & 3) == 1) // return number plus 1 mod 16
+  {
+    r = ((last_r + 1) % 16);
+    ((LASpoint14*)last_item)->return_number = r;
+  }
+  else if ((changed_values & 3) == 2) // return number minus 1 mod 16
+  {
+    r = ((last_r + 15) % 16);
+    ((LASpoint14*)last_item)->return_number = r;
+  }
+  else
+  {
+    // the return number difference is bigger than +1 / -1 so we decompress how it is different
+
+    if (gps_time_change) // if the GPS time has changed
+    {
+      if (contexts[current_context].m_return_number[last_r] == 0)
+      {
+        contexts[current_context].m_return_number[last_r] = dec_channel_returns_XY->createSymbolModel(16);
+        dec_channel_returns_XY->initSymbolModel(contexts[current_context].m_return_number[last_r]);
+      }
+      r = dec_channel_returns_XY->decodeSymbol(contexts[current_context].m_return_number[last_r]);
+    }
+    else // if the GPS time has not changed
+    {
+      I32 sym = dec_channel_returns_XY->decodeSymbol(contexts[current_context].m_return_number_gps_same);
+      r = (last_r + (sym + 2)) % 16;
+    }
+    ((LASpoint14*)last_item)->return_number = r;
+  }
+
+  // set legacy return counts and number of returns
+
+  if (n > 7)
+  {
+    if (r > 6)
+    {
+      if (r >= n)
+      {
+        ((LASpoint14*)last_item)->legacy_return_number = 7;
+      }
+      else
+      {
+        ((LASpoint14*)last_item)->legacy_return_number = 6;
+      }
+    }
+    else
+    {
+      ((LASpoint14*)last_item)->legacy_return_number = r;
+    }
+    ((LASpoint14*)last_item)->legacy_number_of_returns = 7;
+  }
+  else
+  {
+    ((LASpoint14*)last_item)->legacy_return_number = r;
+    ((LASpoint14*)last_item)->legacy_number_of_returns = n;
+  }
+
+  // get return map m and return level l context for current point
+
+  U32 m = number_return_map_6ctx[n][r];
+  U32 l = number_return_level_8ctx[n][r];
+
+  // create single (3) / first (1) / last (2) / intermediate (0) return context for current point
+
+  I32 cpr = (r == 1 ? 2 : 0); // first ?
+  cpr += (r >= n ? 1 : 0); // last ?
+
+  U32 k_bits;
+  I32 median, diff;
+
+  // decompress X coordinate
+  median = contexts[current_context].last_X_diff_median5[(m<<1) | gps_time_change].get();
+  diff = contexts[current_context].ic_dX->decompress(median, n==1);
+  ((LASpoint14*)last_item)->X += diff;
+  contexts[current_context].last_X_diff_median5[(m<<1) | gps_time_change].add(diff);
+
+  // decompress Y coordinate
+  median = contexts[current_context].last_Y_diff_median5[(m<<1) | gps_time_change].get();
+  k_bits = contexts[current_context].ic_dX->getK();
+  diff = contexts[current_context].ic_dY->decompress(median, (n==1) + ( k_bits < 20 ? U32_ZERO_BIT_0(k_bits) : 20 ));
+  ((LASpoint14*)last_item)->Y += diff;
+  contexts[current_context].last_Y_diff_median5[(m<<1) | gps_time_change].add(diff);
+
+  // remember the contexts that the other layers need for this point
+
+  k_bits = (contexts[current_context].ic_dX->getK() + contexts[current_context].ic_dY->getK()) / 2;
+  point->k_Z = (n==1) + (k_bits < 18 ? U32_ZERO_BIT_0(k_bits) : 18);
+  point->cpr = (U8)cpr;
+  point->l = (U8)l;
+}
+
+////////////////////////////////////////
+// decompress Z layer
+////////////////////////////////////////
+
+inline I32 LASreadItemLayered_POINT14::read_Z(LAScontextPOINT14* c, const U32 l, const U32 k_Z)
+{
+  c->last_Z[l] = c->ic_Z->decompress(c->last_Z[l], k_Z);
+  return c->last_Z[l];
+}
+
+////////////////////////////////////////
+// decompress classifications layer
+////////////////////////////////////////
+
+inline U8 LASreadItemLayered_POINT14::read_classification(LAScontextPOINT14* c, const U8 last_classification, const U32 cpr)
+{
+  I32 ccc = ((last_classification & 0x1F) << 1) + (cpr == 3 ? 1 : 0);
+  if (c->m_classification[ccc] == 0)
+  {
+    c->m_classification[ccc] = dec_classification->createSymbolModel(256);
+    dec_classification->initSymbolModel(c->m_classification[ccc]);
+  }
+  return (U8)dec_classification->decodeSymbol(c->m_classification[ccc]);
+}
+
+////////////////////////////////////////
+// decompress flags layer
+////////////////////////////////////////
+
+inline U8 LASreadItemLayered_POINT14::read_flags(LAScontextPOINT14* c, const U8 last_flags)
+{
+  if (c->m_flags[last_flags] == 0)
+  {
+    c->m_flags[last_flags] = dec_flags->createSymbolModel(64);
+    dec_flags->initSymbolModel(c->m_flags[last_flags]);
+  }
+  return (U8)dec_flags->decodeSymbol(c->m_flags[last_flags]);
+}
+
+////////////////////////////////////////
+// decompress intensity layer
+////////////////////////////////////////
+
+inline U16 LASreadItemLayered_POINT14::read_intensity(LAScontextPOINT14* c, const U32 cpr, const U32 gps_time_change)
+{
+  U16 intensity = (U16)c->ic_intensity->decompress(c->last_intensity[(cpr<<1) | gps_time_change], cpr);
+  c->last_intensity[(cpr<<1) | gps_time_change] = intensity;
+  return intensity;
+}
+
+////////////////////////////////////////
+// decompress scan_angle layer (only called if the scan angle has changed)
+////////////////////////////////////////
+
+inline I16 LASreadItemLayered_POINT14::read_scan_angle(LAScontextPOINT14* c, const I16 last_scan_angle, const U32 gps_time_change)
+{
+  return (I16)c->ic_scan_angle->decompress(last_scan_angle, gps_time_change); // if the GPS time has changed
+}
+
+////////////////////////////////////////
+// decompress user_data layer
+////////////////////////////////////////
+
+inline U8 LASreadItemLayered_POINT14::read_user_data(LAScontextPOINT14* c, const U8 last_user_data)
+{
+  if (c->m_user_data[last_user_data/4] == 0)
+  {
+    c->m_user_data[last_user_data/4] = dec_user_data->createSymbolModel(256);
+    dec_user_data->initSymbolModel(c->m_user_data[last_user_data/4]);
+  }
+  return (U8)dec_user_data->decodeSymbol(c->m_user_data[last_user_data/4]);
+}
+
+////////////////////////////////////////
+// decompress point_source layer (only called if the point source ID has changed)
+////////////////////////////////////////
+
+inline U16 LASreadItemLayered_POINT14::read_point_source(LAScontextPOINT14* c, const U16 last_point_source_ID)
+{
+  return (U16)c->ic_point_source_ID->decompress(last_point_source_ID);
+}
+
+////////////////////////////////////////
+// decompress gps_time layer (only called if the GPS time has changed)
+////////////////////////////////////////
+
+inline void LASreadItemLayered_POINT14::read_gps_time(LAScontextPOINT14* c)
+{
+  I32 multi;
+  if (c->last_gpstime_diff[c->last] == 0) // if the last integer difference was zero
+  {
+    multi = dec_gps_time->decodeSymbol(c->m_gpstime_0diff);
+    if (multi == 0) // the difference can be represented with 32 bits
+    {
+      c->last_gpstime_diff[c->last] = c->ic_gpstime->decompress(0, 0);
+      c->last_gpstime[c->last].i64 += c->last_gpstime_diff[c->last];
+      c->multi_extreme_counter[c->last] = 0; 
+    }
+    else if (multi == 1) // the difference is huge
+    {
+      c->next = (c->next+1)&3;
+      c->last_gpstime[c->next].u64 = c->ic_gpstime->decompress((I32)(c->last_gpstime[c->last].u64 >> 32), 8);
+      c->last_gpstime[c->next].u64 = c->last_gpstime[c->next].u64 << 32;
+      c->last_gpstime[c->next].u64 |= dec_gps_time->readInt();
+      c->last = c->next;
+      c->last_gpstime_diff[c->last] = 0;
+      c->multi_extreme_counter[c->last] = 0; 
+    }
+    else // we switch to another sequence
+    {
+      c->last = (c->last+multi-1)&3;
+      read_gps_time(c);
+    }
+  }
+  else
+  {
+    multi = dec_gps_time->decodeSymbol(c->m_gpstime_multi);
+    if (multi == 1)
+    {
+      c->last_gpstime[c->last].i64 += c->ic_gpstime->decompress(c->last_gpstime_diff[c->last], 1);
+      c->multi_extreme_counter[c->last] = 0;
+    }
+    else if (multi < LASZIP_GPSTIME_MULTI_CODE_FULL)
+    {
+      I32 gpstime_diff;
+      if (multi == 0)
+      {
+        gpstime_diff = c->ic_gpstime->decompress(0, 7);
+        c->multi_extreme_counter[c->last]++;
+        if (c->multi_extreme_counter[c->last] > 3)
+        {
+          c->last_gpstime_diff[c->last] = gpstime_diff;
+          c->multi_extreme_counter[c->last] = 0;
+        }
+      }
+      else if (multi < LASZIP_GPSTIME_MULTI)
+      {
+        if (multi < 10)
+          gpstime_diff = c->ic_gpstime->decompress(multi*c->last_gpstime_diff[c->last], 2);
+        else
+          gpstime_diff = c->ic_gpstime->decompress(multi*c->last_gpstime_diff[c->last], 3);
+      }
+      else if (multi == LASZIP_GPSTIME_MULTI)
+      {
+        gpstime_diff = c->ic_gpstime->decompress(LASZIP_GPSTIME_MULTI*c->last_gpstime_diff[c->last], 4);
+        c->multi_extreme_counter[c->last]++;
+        if (c->multi_extreme_counter[c->last] > 3)
+        {
+          c->last_gpstime_diff[c->last] = gpstime_diff;
+          c->multi_extreme_counter[c->last] = 0;
+        }
+      }
+      else
+      {
+        multi = LASZIP_GPSTIME_MULTI - multi;
+        if (multi > LASZIP_GPSTIME_MULTI_MINUS)
+        {
+          gpstime_diff = c->ic_gpstime->decompress(multi*c->last_gpstime_diff[c->last], 5);
+        }
+        else
+        {
+          gpstime_diff = c->ic_gpstime->decompress(LASZIP_GPSTIME_MULTI_MINUS*c->last_gpstime_diff[c->last], 6);
+          c->multi_extreme_counter[c->last]++;
+          if (c->multi_extreme_counter[c->last] > 3)
+          {
+            c->last_gpstime_diff[c->last] = gpstime_diff;
+            c->multi_extreme_counter[c->last] = 0;
+          }
+        }
+      }
+      c->last_gpstime[c->last].i64 += gpstime_diff;
+    }
+    else if (multi ==  LASZIP_GPSTIME_MULTI_CODE_FULL)
+    {
+      c->next = (c->next+1)&3;
+      c->last_gpstime[c->next].u64 = c->ic_gpstime->decompress((I32)(c->last_gpstime[c->last].u64 >> 32), 8);
+      c->last_gpstime[c->next].u64 = c->last_gpstime[c->next].u64 << 32;
+      c->last_gpstime[c->next].u64 |= dec_gps_time->readInt();
+      c->last = c->next;
+      c->last_gpstime_diff[c->last] = 0;
+      c->multi_extreme_counter[c->last] = 0; 
+    }
+    else if (multi >=  LASZIP_GPSTIME_MULTI_CODE_FULL)
+    {
+      c->last = (c->last+multi-LASZIP_GPSTIME_MULTI_CODE_FULL)&3;
+      read_gps_time(c);
+    }
+  }
+}
+
+void LASreadItemLayered_POINT14::set_chunk_count(const U32 count)
+{
+  chunk_count = count;
+}
+
+void LASreadItemLayered_POINT14::decompress_layers()
+{
+  U32 i, j;
+
+  /* the first point of the chunk is stored raw */
+
+  layered_count = chunk_count - 1;
+  layered_index = 0;
+
+  if (layered_count > layered_allocated)
+  {
+    if (layered_points) delete [] layered_points;
+    layered_points = new LASlayeredPOINT14[layered_count];
+    if (layered_points == 0)
+    {
+      layered_allocated = 0;
+      layered_count = 0;
+      return;
+    }
+    layered_allocated = layered_count;
+  }
+
+  /* the channel_returns_XY layer provides the contexts for all other layers */
+
+  for (i = 0; i < layered_count; i++)
+  {
+    LASlayeredPOINT14* point = &layered_points[i];
+    read_channel_returns_XY(point);
+    LASpoint14* last_item = (LASpoint14*)contexts[current_context].last_item;
+    // copy the last item
+    memcpy(point->item, last_item, sizeof(LASpoint14));
+    // remember if the last point had a gps_time_change
+    last_item->gps_time_change = (point->changes & LASZIP_LAYERED_GPS_TIME_CHANGE ? 1 : 0);
+  }
+
+  /* which means that those can then be decompressed independently */
+
+  U32 layers[8];
+  U32 num_layers = 0;
+
+  if (changed_Z) layers[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_Z;
+  if (changed_classification) layers[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
+  if (changed_flags) layers[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_FLAGS;
+  if (changed_intensity) layers[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
+  if (changed_scan_angle) layers[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_SCAN_ANGLE;
+  if (changed_user_data) layers[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_USER_DATA;
+  if (changed_point_source) layers[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_POINT_SOURCE;
+  if (changed_gps_time) layers[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME;
+
+  if (num_layers == 0) return;
+
+  /* the threads of the pool live as long as this reader (one per core but not more than layers) */
+
+  if (pool == 0)
+  {
+    U32 num_threads = std::thread::hardware_concurrency();
+    if ((num_threads == 0) || (num_threads > 8)) num_threads = 8;
+    pool = new LASthreadPool();
+    pool->start(num_threads - 1);
+  }
+
+  /* each job (one per thread or only this one) advances its share of the layers in lockstep */
+
+  U32 num_shares = pool->get_num_workers() + 1;
+  if (num_shares > num_layers) num_shares = num_layers;
+
+  U32 shares[8];
+  I32 errors[8];
+
+  for (i = 0; i < num_shares; i++)
+  {
+    shares[i] = 0;
+    errors[i] = 0;
+  }
+  for (j = 0; j < num_layers; j++)
+  {
+    shares[j % num_shares] |= layers[j];
+  }
+
+  BOOL with_status = (dec->getStatus() != 0);
+
+  pool->run(num_shares, [this, &shares, &errors, with_status](U32 i)
+  {
+    try { decompress_layers_in_lockstep(shares[i], (with_status ? &errors[i] : 0)); } catch (I32 error) { errors[i] = error; } catch (...) { errors[i] = 4711; }
+  });
+
+  for (i = 0; i < num_shares; i++)
+  {
+    if (errors[i]) dec->reportError(errors[i]);
+  }
+}
+
+void LASreadItemLayered_POINT14::decompress_layers_in_lockstep(const U32 layers, I32* status)
+{
+  U32 i;
+
+  // without exceptions the decoders of this share keep their errors in the
+  // status of this thread so that threads never write to the same status
+
+  if (status) set_layer_status(layers, status);
+
+  // each layer has its own decoder so that the CPU can overlap the decoding
+  // of one layer with that of the others when they advance point by point
+
+  LASlayersPOINT14 last;
+  start_layers(&last);
+
+  for (i = 0; i < layered_count; i++)
+  {
+    LASlayeredPOINT14* point = &layered_points[i];
+    if (layers & LASZIP_DECOMPRESS_SELECTIVE_Z) decompress_Z_layer(&last, point);
+    if (layers & LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION) decompress_classification_layer(&last, point);
+    if (layers & LASZIP_DECOMPRESS_SELECTIVE_FLAGS) decompress_flags_layer(&last, point);
+    if (layers & LASZIP_DECOMPRESS_SELECTIVE_INTENSITY) decompress_intensity_layer(&last, point);
+    if (layers & LASZIP_DECOMPRESS_SELECTIVE_SCAN_ANGLE) decompress_scan_angle_layer(&last, point);
+    if (layers & LASZIP_DECOMPRESS_SELECTIVE_USER_DATA) decompress_user_data_layer(&last, point);
+    if (layers & LASZIP_DECOMPRESS_SELECTIVE_POINT_SOURCE) decompress_point_source_layer(&last, point);
+    if (layers & LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME) decompress_gps_time_layer(&last, point);
+  }
+
+  if (status) set_layer_status(layers, dec->getStatus());
+}
+
+void LASreadItemLayered_POINT14::set_layer_status(const U32 layers, I32* status)
+{
+  if (layers & LASZIP_DECOMPRESS_SELECTIVE_Z) dec_Z->setStatus(status);
+  if (layers & LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION) dec_classification->setStatus(status);
+  if (layers & LASZIP_DECOMPRESS_SELECTIVE_FLAGS) dec_flags->setStatus(status);
+  if (layers & LASZIP_DECOMPRESS_SELECTIVE_INTENSITY) dec_intensity->setStatus(status);
+  if (layers & LASZIP_DECOMPRESS_SELECTIVE_SCAN_ANGLE) dec_scan_angle->setStatus(status);
+  if (layers & LASZIP_DECOMPRESS_SELECTIVE_USER_DATA) dec_user_data->setStatus(status);
+  if (layers & LASZIP_DECOMPRESS_SELECTIVE_POINT_SOURCE) dec_point_source->setStatus(status);
+  if (layers & LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME) dec_gps_time->setStatus(status);
+}
+
+// each of the following layers keeps the last value of its attribute per
+// context and starts a context that is newly used in this chunk with the
+// value of the previous point, just like createAndInitModelsAndDecompressors()
+// does for read_point(). the decoding itself is done by the same functions
+
+void LASreadItemLayered_POINT14::start_layers(LASlayersPOINT14* last) const
+{
+  const LASpoint14* item = (const LASpoint14*)layered_item;
+  last->Z = item->Z;
+  last->intensity = item->intensity;
+  last->classification[layered_context] = last->previous_classification = item->classification;
+  last->flags[layered_context] = last->previous_flags = (item->edge_of_flight_line << 5) | (item->scan_direction_flag << 4) | item->classification_flags;
+  last->scan_angle[layered_context] = last->previous_scan_angle = item->scan_angle;
+  last->scan_angle_rank[layered_context] = last->previous_scan_angle_rank = item->legacy_scan_angle_rank;
+  last->user_data[layered_context] = last->previous_user_data = item->user_data;
+  last->point_source_ID[layered_context] = last->previous_point_source_ID = item->point_source_ID;
+  last->gps_time[layered_context] = last->previous_gps_time = item->gps_time;
+}
+
+inline void LASreadItemLayered_POINT14::decompress_Z_layer(LASlayersPOINT14* last, LASlayeredPOINT14* point)
+{
+  U32 j;
+  LAScontextPOINT14* c = &contexts[point->context];
+  if (point->changes & LASZIP_LAYERED_NEW_CONTEXT)
+  {
+    for (j = 0; j < 8; j++)
+    {
+      c->last_Z[j] = last->Z;
+    }
+  }
+  last->Z = read_Z(c, point->l, point->k_Z);
+  point->Z = last->Z;
+}
+
+inline void LASreadItemLayered_POINT14::decompress_classification_layer(LASlayersPOINT14* last, LASlayeredPOINT14* point)
+{
+  if (point->changes & LASZIP_LAYERED_NEW_CONTEXT)
+  {
+    last->classification[point->context] = last->previous_classification;
+  }
+  last->previous_classification = read_classification(&contexts[point->context], last->classification[point->context], point->cpr);
+  last->classification[point->context] = last->previous_classification;
+  point->classification = last->previous_classification;
+}
+
+inline void LASreadItemLayered_POINT14::decompress_flags_layer(LASlayersPOINT14* last, LASlayeredPOINT14* point)
+{
+  if (point->changes & LASZIP_LAYERED_NEW_CONTEXT)
+  {
+    last->flags[point->context] = last->previous_flags;
+  }
+  last->previous_flags = read_flags(&contexts[point->context], last->flags[point->context]);
+  last->flags[point->context] = last->previous_flags;
+  point->flags = last->previous_flags;
+}
+
+inline void LASreadItemLayered_POINT14::decompress_intensity_layer(LASlayersPOINT14* last, LASlayeredPOINT14* point)
+{
+  U32 j;
+  LAScontextPOINT14* c = &contexts[point->context];
+  if (point->changes & LASZIP_LAYERED_NEW_CONTEXT)
+  {
+    for (j = 0; j < 8; j++)
+    {
+      c->last_intensity[j] = last->intensity;
+    }
+  }
+  last->intensity = read_intensity(c, point->cpr, (point->changes & LASZIP_LAYERED_GPS_TIME_CHANGE ? 1 : 0));
+  point->intensity = last->intensity;
+}
+
+inline void LASreadItemLayered_POINT14::decompress_scan_angle_layer(LASlayersPOINT14* last, LASlayeredPOINT14* point)
+{
+  if (point->changes & LASZIP_LAYERED_NEW_CONTEXT)
+  {
+    last->scan_angle[point->context] = last->previous_scan_angle;
+    last->scan_angle_rank[point->context] = last->previous_scan_angle_rank;
+  }
+  if (point->changes & LASZIP_LAYERED_SCAN_ANGLE_CHANGE) // if the scan angle has actually changed
+  {
+    last->scan_angle[point->context] = read_scan_angle(&contexts[point->context], last->scan_angle[point->context], (point->changes & LASZIP_LAYERED_GPS_TIME_CHANGE ? 1 : 0));
+    last->scan_angle_rank[point->context] = I8_CLAMP(I16_QUANTIZE(0.006f*last->scan_angle[point->context]));
+  }
+  last->previous_scan_angle = last->scan_angle[point->context];
+  last->previous_scan_angle_rank = last->scan_angle_rank[point->context];
+  point->scan_angle = last->previous_scan_angle;
+  point->legacy_scan_angle_rank = last->previous_scan_angle_rank;
+}
+
+inline void LASreadItemLayered_POINT14::decompress_user_data_layer(LASlayersPOINT14* last, LASlayeredPOINT14* point)
+{
+  if (point->changes & LASZIP_LAYERED_NEW_CONTEXT)
+  {
+    last->user_data[point->context] = last->previous_user_data;
+  }
+  last->previous_user_data = read_user_data(&contexts[point->context], last->user_data[point->context]);
+  last->user_data[point->context] = last->previous_user_data;
+  point->user_data = last->previous_user_data;
+}
+
+inline void LASreadItemLayered_POINT14::decompress_point_source_layer(LASlayersPOINT14* last, LASlayeredPOINT14* point)
+{
+  if (point->changes & LASZIP_LAYERED_NEW_CONTEXT)
+  {
+    last->point_source_ID[point->context] = last->previous_point_source_ID;
+  }
+  if (point->changes & LASZIP_LAYERED_POINT_SOURCE_CHANGE) // if the point source ID has actually changed
+  {
+    last->point_source_ID[point->context] = read_point_source(&contexts[point->context], last->point_source_ID[point->context]);
+  }
+  last->previous_point_source_ID = last->point_source_ID[point->context];
+  point->point_source_ID = last->previous_point_source_ID;
+}
+
+inline void LASreadItemLayered_POINT14::decompress_gps_time_layer(LASlayersPOINT14* last, LASlayeredPOINT14* point)
+{
+  if (point->changes & LASZIP_LAYERED_NEW_CONTEXT)
+  {
+    contexts[point->context].last_gpstime[0].f64 = last->previous_gps_time;
+    last->gps_time[point->context] = last->previous_gps_time;
+  }
+  if (point->changes & LASZIP_LAYERED_GPS_TIME_CHANGE) // if the GPS time has actually changed
+  {
+    read_gps_time(&contexts[point->context]);
+    last->gps_time[point->context] = contexts[point->context].last_gpstime[contexts[point->context].last].f64;
+  }
+  last->previous_gps_time = last->gps_time[point->context];
+  point->gps_time = last->previous_gps_time;
+}
@@ -0,0 +1,131 @@
+/*
+===============================================================================
+
+  FILE:  lasreaditemlayered.hpp
+
+  CONTENTS:
+
+    The decoding of the layers of the *new* point types 6 to 10 of LAS 1.4
+    that the version 3 and the version 4 readers have in common. Each layer
+    is decoded by one function that serves both when the layers are read
+    point by point and when the layers of a chunk are decompressed up front
+    (maybe on the threads of a pool).
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- the layers that threads advance in lockstep use the same decoding as read_point()
+    16 October 2026 -- created to decode each layer of the v3 and v4 readers in one place
+
+===============================================================================
+*/
+#ifndef LAS_READ_ITEM_LAYERED_HPP
+#define LAS_READ_ITEM_LAYERED_HPP
+
+#include "lasreaditem.hpp"
+#include "arithmeticdecoder.hpp"
+#include "integercompressor.hpp"
+
+#include "laszip_common_v3.hpp"
+#include "laszip_decompress_selective_v3.hpp"
+
+class LASthreadPool;
+
+class LASreadItemLayered_POINT14 : public LASreadItemCompressed
+{
+public:
+
+  void set_chunk_count(const U32 count);
+
+  ~LASreadItemLayered_POINT14();
+
+protected:
+
+  LASreadItemLayered_POINT14(ArithmeticDecoder* dec, const BOOL parallel_layers);
+
+  /* not used as a decoder. just gives access to instream */
+
+  ArithmeticDecoder* dec;
+
+  ArithmeticDecoder* dec_channel_returns_XY;
+  ArithmeticDecoder* dec_Z;
+  ArithmeticDecoder* dec_classification;
+  ArithmeticDecoder* dec_flags;
+  ArithmeticDecoder* dec_intensity;
+  ArithmeticDecoder* dec_scan_angle;
+  ArithmeticDecoder* dec_user_data;
+  ArithmeticDecoder* dec_point_source;
+  ArithmeticDecoder* dec_gps_time;
+
+  BOOL changed_Z;
+  BOOL changed_classification;
+  BOOL changed_flags;
+  BOOL changed_intensity;
+  BOOL changed_scan_angle;
+  BOOL changed_user_data;
+  BOOL changed_point_source;
+  BOOL changed_gps_time;
+
+  U32 current_context;
+  LAScontextPOINT14 contexts[4];
+
+  BOOL createAndInitModelsAndDecompressors(U32 context, const U8* item);
+
+  // reads the next point and returns the scanner channel it belongs to. sets
+  // 'switched' when that differs from the scanner channel of the point before
+
+  U32 read_point(U8* item, BOOL& switched);
+
+  /* the decoding of each layer */
+
+  void read_channel_returns_XY(LASlayeredPOINT14* point);
+  I32 read_Z(LAScontextPOINT14* c, const U32 l, const U32 k_Z);
+  U8 read_classification(LAScontextPOINT14* c, const U8 last_classification, const U32 cpr);
+  U8 read_flags(LAScontextPOINT14* c, const U8 last_flags);
+  U16 read_intensity(LAScontextPOINT14* c, const U32 cpr, const U32 gps_time_change);
+  I16 read_scan_angle(LAScontextPOINT14* c, const I16 last_scan_angle, const U32 gps_time_change);
+  U8 read_user_data(LAScontextPOINT14* c, const U8 last_user_data);
+  U16 read_point_source(LAScontextPOINT14* c, const U16 last_point_source_ID);
+  void read_gps_time(LAScontextPOINT14* c);
+
+  /* for decompressing the layers of a chunk up front (maybe in parallel) */
+
+  BOOL parallel_layers;
+  U32 chunk_count;
+  U32 layered_count;
+  U32 layered_index;
+  U32 layered_allocated;
+  U32 layered_context;
+  U8 layered_item[LASZIP_POINT14_FOOTPRINT];
+  LASlayeredPOINT14* layered_points;
+  LASthreadPool* pool;
+
+  void decompress_layers();
+  void decompress_layers_in_lockstep(const U32 layers, I32* status);
+  void set_layer_status(const U32 layers, I32* status);
+  void start_layers(LASlayersPOINT14* last) const;
+  void decompress_Z_layer(LASlayersPOINT14* last, LASlayeredPOINT14* point);
+  void decompress_classification_layer(LASlayersPOINT14* last, LASlayeredPOINT14* point);
+  void decompress_flags_layer(LASlayersPOINT14* last, LASlayeredPOINT14* point);
+  void decompress_intensity_layer(LASlayersPOINT14* last, LASlayeredPOINT14* point);
+  void decompress_scan_angle_layer(LASlayersPOINT14* last, LASlayeredPOINT14* point);
+  void decompress_user_data_layer(LASlayersPOINT14* last, LASlayeredPOINT14* point);
+  void decompress_point_source_layer(LASlayersPOINT14* last, LASlayeredPOINT14* point);
+  void decompress_gps_time_layer(LASlayersPOINT14* last, LASlayeredPOINT14* point);
+};
+
+#endif
@@ -0,0 +1,116 @@
+/*
+===============================================================================
+
+  FILE:  lasreaditemsfused.hpp
+
+  CONTENTS:
+
+    Reads all items of the points of a standard point type in one call. The
+    item readers are chained at compile time into a list whose read() calls
+    the read() of each item non-virtually, so that the compiler may inline
+    them into one loop body. There is one virtual call per point (or per
+    chunk) instead of one per item. The list must be instantiated where the
+    read() functions of its items are defined (they are 'inline' there),
+    which is why each lasreaditemcompressed_v*.cpp has its own factory.
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- created to read standard point types without a virtual call per item
+
+===============================================================================
+*/
+#ifndef LAS_READ_ITEMS_FUSED_HPP
+#define LAS_READ_ITEMS_FUSED_HPP
+
+#include "lasreaditem.hpp"
+
+#include <string.h>
+
+class LASreadItemsFused
+{
+public:
+  // reads one point whose items are at 'point[0]', 'point[1]', ...
+  virtual void read(U8* const * point, U32& context)=0;
+  // reads 'number' points of 'point_size' bytes each starting at 'points'. each
+  // starts as a copy of the point before it (readers may leave items untouched)
+  virtual void read(U8* points, const U32 number, const U32 point_size, const U32* item_offsets)=0;
+
+  virtual ~LASreadItemsFused(){};
+};
+
+// the end of a list of item readers
+
+class LASreadItemsFusedEnd
+{
+public:
+  LASreadItemsFusedEnd(LASreadItem** readers) {};
+  inline void read(U8* const * point, U32& context) {};
+  inline void read(U8* point, const U32* item_offsets, U32& context) {};
+};
+
+// the reader of type R for the next item followed by the list for the remaining items
+
+template <class R, class NEXT>
+class LASreadItemsFusedList
+{
+public:
+  LASreadItemsFusedList(LASreadItem** readers) : reader((R*)readers[0]), next(readers + 1) {};
+  inline void read(U8* const * point, U32& context)
+  {
+    reader->R::read(point[0], context);
+    next.read(point + 1, context);
+  };
+  inline void read(U8* point, const U32* item_offsets, U32& context)
+  {
+    reader->R::read(point + item_offsets[0], context);
+    next.read(point, item_offsets + 1, context);
+  };
+private:
+  R* reader;
+  NEXT next;
+};
+
+template <class LIST>
+class LASreadItemsFusedTemplate : public LASreadItemsFused
+{
+public:
+  LASreadItemsFusedTemplate(LASreadItem** readers) : list(readers) {};
+
+  void read(U8* const * point, U32& context)
+  {
+    list.read(point, context);
+  };
+
+  void read(U8* points, const U32 number, const U32 point_size, const U32* item_offsets)
+  {
+    U32 j;
+    U32 context;
+    for (j = 0; j < number; j++)
+    {
+      memcpy(points, points - point_size, point_size);
+      context = 0;
+      list.read(points, item_offsets, context);
+      points += point_size;
+    }
+  };
+
+private:
+  LIST list;
+};
+
+#endif
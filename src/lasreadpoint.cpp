@@ -32,16 +32,24 @@
 #include "lasreadpoint.hpp"
 
 #include "arithmeticdecoder.hpp"
+#include "bytestreamin_array.hpp"
+#include "bytestreamout_array.hpp"
 #include "lasreaditemraw.hpp"
 #include "lasreaditemcompressed_v1.hpp"
 #include "lasreaditemcompressed_v2.hpp"
 #include "lasreaditemcompressed_v3.hpp"
 #include "lasreaditemcompressed_v4.hpp"
+#include "lasreaditembitpacked.hpp"
+#include "lasreaditemattributes.hpp"
+#include "lasreaditemsfused.hpp"
+#include "lasthreadpool.hpp"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <thread>
+
 LASreadPoint::LASreadPoint(U32 decompress_selective)
 {
   point_size = 0;
@@ -50,6 +58,7 @@ LASreadPoint::LASreadPoint(U32 decompress_selective)
   readers = 0;
   readers_raw = 0;
   readers_compressed = 0;
+  fused = 0;
   dec = 0;
   layered_las14_compression = FALSE;
   // used for chunking
@@ -60,16 +69,151 @@ LASreadPoint::LASreadPoint(U32 decompress_selective)
   tabled_chunks = 0;
   chunk_totals = 0;
   chunk_starts = 0;
+  complete_chunk_table = FALSE;
+  // used for parallel decompression of chunks
+  num_threads = 0;
+  workers = 0;
+  pool = 0;
+  item_offsets = 0;
+  item_footprints = 0;
+  decoded_point_size = 0;
+  batch_bytes = 0;
+  batch_bytes_allocated = 0;
+  batch_points = 0;
+  batch_points_allocated = 0;
+  batch_sizes = 0;
+  batch_valid = 0;
+  batch_chunk = 0;
+  batch_count = 0;
+  batch_index = 0;
+  batch_point = 0;
+  chunk_stream = 0;
+  chunk_point = 0;
   // used for selective decompression (new LAS 1.4 point types only)
   this->decompress_selective = decompress_selective;
+  num_selective_bytes = 0;
+  selective_bytes = 0;
+  // used for parallel decompression of layers (new LAS 1.4 point types only)
+  parallel_layers = FALSE;
+  // used for checkpoints inside chunks
+  checkpoint_interval = 0;
+  checkpoint_chunks = 0;
+  checkpoints = 0;
+  checkpoint_counts = 0;
+  checkpoint_outstream = 0;
+  checkpoint_instream = 0;
+  // used for decompressing more layers while reading a chunk
+  lazy_selective = 0;
+  lazy_chunk = 0;
+  // used for caching decompressed chunks
+  cache_max_bytes = 0;
+  cache_bytes = 0;
+  cache_hits = 0;
+  cache_misses = 0;
+  cache_chunks = 0;
+  cache_points = 0;
+  cache_older = 0;
+  cache_newer = 0;
+  cache_oldest = U32_MAX;
+  cache_newest = U32_MAX;
+  cache_chunk_bytes = 0;
+  cache_chunk_bytes_allocated = 0;
+  cache_worker = 0;
   // used for seeking
   point_start = 0;
   seek_point = 0;
   // used for error and warning reporting
+  decode_status = 0;
   last_error = 0;
   last_warning = 0;
 }
 
+BOOL LASreadPoint::set_threads(const U32 num_threads)
+{
+  if (num_readers) return FALSE; // too late
+  // one thread per core but not more than 8 (as for the layers)
+  U32 max_threads = std::thread::hardware_concurrency();
+  if ((max_threads == 0) || (max_threads > 8)) max_threads = 8;
+  this->num_threads = (num_threads < max_threads ? num_threads : max_threads);
+  if (this->num_threads < 2) this->num_threads = 0;
+  return TRUE;
+}
+
+BOOL LASreadPoint::set_parallel_layers(const BOOL parallel_layers)
+{
+  if (num_readers) return FALSE; // too late
+  this->parallel_layers = parallel_layers;
+  return TRUE;
+}
+
+BOOL LASreadPoint::set_checkpoints(const U32 interval)
+{
+  if (num_readers) return FALSE; // too late
+  checkpoint_interval = interval;
+  return TRUE;
+}
+
+BOOL LASreadPoint::set_chunk_cache(const U64 max_bytes)
+{
+  if (num_readers) return FALSE; // too late
+  cache_max_bytes = max_bytes;
+  return TRUE;
+}
+
+BOOL LASreadPoint::set_selective_bytes(const U32 num_bytes, const BOOL* requested)
+{
+  if (num_readers) return FALSE; // too late
+  if (selective_bytes) delete [] selective_bytes;
+  num_selective_bytes = num_bytes;
+  selective_bytes = new BOOL[num_bytes ? num_bytes : 1];
+  U32 i;
+  for (i = 0; i < num_bytes; i++)
+  {
+    selective_bytes[i] = (requested[i] ? TRUE : FALSE);
+  }
+  return TRUE;
+}
+
+void LASreadPoint::get_chunk_cache_stats(U64& hits, U64& misses, U64& bytes) const
+{
+  hits = cache_hits;
+  misses = cache_misses;
+  bytes = cache_bytes;
+}
+
+BOOL LASreadPoint::get_chunk_count(U32& count)
+{
+  if ((dec == 0) || (instream == 0)) return FALSE;
+  // the chunk table is usually only read with the first point
+  if (point_start == 0)
+  {
+    if (!init_dec()) return FALSE;
+    chunk_count = 0;
+  }
+  if (!complete_chunk_table) return FALSE;
+  count = number_chunks;
+  return TRUE;
+}
+
+BOOL LASreadPoint::get_chunk_info(const U32 index, I64& first_point, U32& num_points, I64& byte_offset, I64& byte_size)
+{
+  U32 count;
+  if (!get_chunk_count(count) || (index >= count)) return FALSE;
+  if (chunk_totals) // variable sized chunks?
+  {
+    first_point = chunk_totals[index];
+    num_points = chunk_totals[index+1]-chunk_totals[index];
+  }
+  else // not clamped for the last fixed sized chunk (see header)
+  {
+    first_point = (I64)index*chunk_size;
+    num_points = chunk_size;
+  }
+  byte_offset = chunk_starts[index];
+  byte_size = chunk_starts[index+1]-chunk_starts[index];
+  return TRUE;
+}
+
 BOOL LASreadPoint::setup(U32 num_items, const LASitem* items, const LASzip* laszip)
 {
   U32 i;
@@ -98,7 +242,10 @@ BOOL LASreadPoint::setup(U32 num_items, const LASitem* items, const LASzip* lasz
     switch (laszip->coder)
     {
     case LASZIP_CODER_ARITHMETIC:
-      dec = new ArithmeticDecoder();
+    case LASZIP_CODER_ARITHMETIC_TWO_PASS:
+      dec = new ArithmeticDecoder(laszip->coder);
+      // errors of the decoders are checked after each point instead of thrown
+      dec->setStatus(&decode_status);
       break;
     default:
       // entropy decoder not supported
@@ -106,6 +253,8 @@ BOOL LASreadPoint::setup(U32 num_items, const LASitem* items, const LASzip* lasz
     }
     // maybe layered compression for LAS 1.4 
     layered_las14_compression = (laszip->compressor == LASZIP_COMPRESSOR_LAYERED_CHUNKED);
+    // bit-packed compression writes its chunks the same way as layered compression
+    if (laszip->compressor == LASZIP_COMPRESSOR_BITPACKED_CHUNKED) layered_las14_compression = TRUE;
   }
  
   // initizalize the readers
@@ -184,6 +333,9 @@ BOOL LASreadPoint::setup(U32 num_items, const LASitem* items, const LASzip* lasz
     {
       // because combo LAS 1.0 - 1.4 point struct has padding
       seek_point[0] = new U8[(point_size*2)];
+      // because the POINT14 reader also copies the padding (which a chunk that
+      // a seek starts keeps for all of its points)
+      memset(seek_point[0], 0, point_size*2);
       // because extended_point_type must be set
       seek_point[0][22] = 1;
     }
@@ -192,9 +344,25 @@ BOOL LASreadPoint::setup(U32 num_items, const LASitem* items, const LASzip* lasz
       seek_point[0] = new U8[point_size];
     }
     if (!seek_point[0]) return FALSE;
+    // where each item is placed in a decompressed point (same as in the seek point)
+    if (item_offsets) delete [] item_offsets;
+    if (item_footprints) delete [] item_footprints;
+    item_offsets = new U32[num_readers];
+    item_footprints = new U32[num_readers];
+    decoded_point_size = 0;
+    for (i = 0; i < num_readers; i++)
+    {
+      item_offsets[i] = decoded_point_size;
+      item_footprints[i] = (items[i].type == LASitem::POINT14 ? LASZIP_POINT14_FOOTPRINT : items[i].size);
+      decoded_point_size += (layered_las14_compression ? 2*items[i].size : items[i].size);
+    }
     for (i = 0; i < num_readers; i++)
     {
-      switch (items[i].type)
+      if (laszip->compressor == LASZIP_COMPRESSOR_BITPACKED_CHUNKED)
+      {
+        readers_compressed[i] = new LASreadItemBitpacked(dec, items[i]);
+      }
+      else switch (items[i].type)
       {
       case LASitem::POINT10:
         if (items[i].version == 1)
@@ -230,9 +398,9 @@ BOOL LASreadPoint::setup(U32 num_items, const LASitem* items, const LASzip* lasz
         break;
       case LASitem::POINT14:
         if ((items[i].version == 3) || (items[i].version == 2)) // version == 2 from lasproto
-          readers_compressed[i] = new LASreadItemCompressed_POINT14_v3(dec, decompress_selective);
+          readers_compressed[i] = new LASreadItemCompressed_POINT14_v3(dec, decompress_selective, parallel_layers);
         else if (items[i].version == 4)
-          readers_compressed[i] = new LASreadItemCompressed_POINT14_v4(dec, decompress_selective);
+          readers_compressed[i] = new LASreadItemCompressed_POINT14_v4(dec, decompress_selective, parallel_layers);
         else
           return FALSE;
         break;
@@ -254,9 +422,11 @@ BOOL LASreadPoint::setup(U32 num_items, const LASitem* items, const LASzip* lasz
         break;
       case LASitem::BYTE14:
         if ((items[i].version == 3) || (items[i].version == 2)) // version == 2 from lasproto
-          readers_compressed[i] = new LASreadItemCompressed_BYTE14_v3(dec, items[i].size, decompress_selective);
+          readers_compressed[i] = new LASreadItemCompressed_BYTE14_v3(dec, items[i].size, decompress_selective, num_selective_bytes, selective_bytes);
         else if (items[i].version == 4)
-          readers_compressed[i] = new LASreadItemCompressed_BYTE14_v4(dec, items[i].size, decompress_selective);
+          readers_compressed[i] = new LASreadItemCompressed_BYTE14_v4(dec, items[i].size, decompress_selective, num_selective_bytes, selective_bytes);
+        else if (items[i].version == LASZIP_BYTE14_VERSION_ATTRIBUTES)
+          readers_compressed[i] = new LASreadItemAttributes(dec, items[i].size, decompress_selective, num_selective_bytes, selective_bytes);
         else
           return FALSE;
         break;
@@ -290,10 +460,77 @@ BOOL LASreadPoint::setup(U32 num_items, const LASitem* items, const LASzip* lasz
         }
       }
     }
+    // the items of standard point types are read without a virtual call per item
+    if (fused)
+    {
+      delete fused;
+      fused = 0;
+    }
+    if (laszip->compressor != LASZIP_COMPRESSOR_BITPACKED_CHUNKED)
+    {
+      fused = laszip_fuse_readers_v2(num_readers, items, readers_compressed);
+      if (fused == 0) fused = laszip_fuse_readers_v3(num_readers, items, readers_compressed);
+      if (fused == 0) fused = laszip_fuse_readers_v4(num_readers, items, readers_compressed);
+    }
     if (laszip->compressor != LASZIP_COMPRESSOR_POINTWISE)
     {
       if (laszip->chunk_size) chunk_size = laszip->chunk_size;
       number_chunks = U32_MAX;
+      // create one worker per thread that decompresses entire chunks from memory
+      if (num_threads)
+      {
+        workers = new LASreadPoint*[num_threads];
+        batch_bytes = new U8*[num_threads];
+        batch_bytes_allocated = new U32[num_threads];
+        batch_points = new U8*[num_threads];
+        batch_points_allocated = new U32[num_threads];
+        batch_sizes = new U32[num_threads];
+        batch_valid = new BOOL[num_threads];
+        for (i = 0; i < num_threads; i++)
+        {
+          workers[i] = 0;
+          batch_bytes[i] = 0;
+          batch_bytes_allocated[i] = 0;
+          batch_points[i] = 0;
+          batch_points_allocated[i] = 0;
+          batch_sizes[i] = 0;
+          batch_valid[i] = FALSE;
+        }
+        for (i = 0; i < num_threads; i++)
+        {
+          workers[i] = new LASreadPoint(decompress_selective);
+          if (selective_bytes) workers[i]->set_selective_bytes(num_selective_bytes, selective_bytes);
+          if (!workers[i]->setup(num_items, items, laszip))
+          {
+            return FALSE;
+          }
+          if (IS_LITTLE_ENDIAN())
+            workers[i]->chunk_stream = new ByteStreamInArrayLE();
+          else
+            workers[i]->chunk_stream = new ByteStreamInArrayBE();
+          workers[i]->chunk_point = new U8*[num_readers];
+          workers[i]->init(workers[i]->chunk_stream);
+        }
+        // this thread decompresses one chunk of each batch and the pool the others
+        pool = new LASthreadPool();
+        pool->start(num_threads - 1);
+      }
+      // create a worker that decompresses entire chunks from memory into the cache
+      if (cache_max_bytes)
+      {
+        cache_worker = new LASreadPoint(decompress_selective);
+        if (selective_bytes) cache_worker->set_selective_bytes(num_selective_bytes, selective_bytes);
+        if (!cache_worker->setup(num_items, items, laszip))
+        {
+          return FALSE;
+        }
+        if (IS_LITTLE_ENDIAN())
+          cache_worker->chunk_stream = new ByteStreamInArrayLE();
+        else
+          cache_worker->chunk_stream = new ByteStreamInArrayBE();
+        cache_worker->chunk_point = new U8*[num_readers];
+        cache_worker->init(cache_worker->chunk_stream);
+      }
     }
   }
   return TRUE;
@@ -304,6 +541,10 @@ BOOL LASreadPoint::init(ByteStreamIn* instream)
   if (!instream) return FALSE;
   this->instream = instream;
 
+  // checkpoints and cached chunks of an earlier stream are useless
+  free_checkpoints();
+  free_cache();
+
   U32 i;
   for (i = 0; i < num_readers; i++)
   {
@@ -362,13 +603,21 @@ BOOL LASreadPoint::seek(const U32 current, const U32 target)
         }
         delta += (chunk_size*(target_chunk-current_chunk) - chunk_count);
       }
+      else if (batch_count && (current_chunk < target_chunk) && (target_chunk < (batch_chunk + batch_count)))
+      {
+        // target chunk was already decompressed
+        select_batch_chunk(target_chunk - batch_chunk);
+      }
       else if (current_chunk != target_chunk || current > target)
       {
+        batch_count = 0;
         dec->done();
         current_chunk = target_chunk;
         instream->seek(chunk_starts[current_chunk]);
         init_dec();
         chunk_count = 0;
+        // maybe the target chunk is (or will be) cached
+        if (cache_max_bytes) read_cached_chunk();
       }
       else
       {
@@ -386,6 +635,33 @@ BOOL LASreadPoint::seek(const U32 current, const U32 target)
     {
       delta = target - current;
     }
+    // maybe continue from the last checkpoint before the target
+    if (checkpoints && (batch_count == 0) && (current_chunk < checkpoint_chunks) && checkpoints[current_chunk] && ((chunk_count + delta) < chunk_size))
+    {
+      U32 index = (chunk_count + delta) / checkpoint_interval;
+      if (index >= checkpoint_counts[current_chunk]) index = checkpoint_counts[current_chunk] - 1;
+      while (index && ((index*checkpoint_interval) > chunk_count))
+      {
+        if (checkpoints[current_chunk][index])
+        {
+          U32 skipped = index*checkpoint_interval - chunk_count;
+          if (!load_checkpoint(index))
+          {
+            return FALSE;
+          }
+          delta -= skipped;
+          break;
+        }
+        index--;
+      }
+    }
+    // the points of a decompressed chunk are simply skipped
+    if (batch_count && batch_point && ((chunk_count + delta) < chunk_size))
+    {
+      chunk_count += delta;
+      batch_point += (size_t)delta*decoded_point_size;
+      delta = 0;
+    }
     while (delta)
     {
       if (!read(seek_point))
@@ -414,8 +690,14 @@ BOOL LASreadPoint::read(U8* const * point)
   {
     if (dec)
     {
-      if (chunk_count == chunk_size)
+      if (chunk_count == chunk_size && batch_count && ((batch_index + 1) < batch_count))
+      {
+        // next chunk was already decompressed
+        select_batch_chunk(batch_index + 1);
+      }
+      else if (chunk_count == chunk_size)
       {
+        batch_count = 0;
         if (point_start != 0)
         {
           dec->done();
@@ -428,7 +710,7 @@ BOOL LASreadPoint::read(U8* const * point)
             {
               // previous chunk was corrupt
               current_chunk--;
-              throw 4711;
+              return report_error(4711);
             }
           }
         }
@@ -448,14 +730,54 @@ BOOL LASreadPoint::read(U8* const * point)
           chunk_size = chunk_totals[current_chunk+1]-chunk_totals[current_chunk];
         }
         chunk_count = 0;
+        // maybe this chunk is (or will be) cached
+        if (cache_max_bytes && read_cached_chunk())
+        {
+          // points are copied from the cache
+        }
+        // maybe decompress this and the following chunks in parallel
+        else if (workers) read_chunks();
       }
       chunk_count++;
 
-      if (readers)
+      if (batch_count)
       {
+        if (batch_point == 0)
+        {
+          // create error string
+          if (last_error == 0) last_error = new CHAR[128];
+          // report error
+          snprintf(last_error, 128, "chunk with index %u of %u is corrupt", current_chunk, tabled_chunks);
+          // ready for next LASreadPoint::read()
+          chunk_count = chunk_size;
+          return FALSE;
+        }
         for (i = 0; i < num_readers; i++)
         {
-          readers[i]->read(point[i], context);
+          memcpy(point[i], batch_point + item_offsets[i], item_footprints[i]);
+        }
+        batch_point += decoded_point_size;
+      }
+      else if (readers)
+      {
+        if (fused)
+        {
+          fused->read(point, context);
+        }
+        else
+        {
+          for (i = 0; i < num_readers; i++)
+          {
+            readers[i]->read(point[i], context);
+          }
+        }
+        if (decode_status)
+        {
+          return report_error(decode_status);
+        }
+        if (checkpoint_interval && ((chunk_count % checkpoint_interval) == 0) && (chunk_count < chunk_size))
+        {
+          save_checkpoint();
         }
       }
       else
@@ -471,10 +793,22 @@ BOOL LASreadPoint::read(U8* const * point)
           // read how many points are in the chunk
           U32 count;
           instream->get32bitsLE((U8*)&count);
+          // the layers requested while reading a chunk are only for that chunk (as
+          // are the checkpoints saved with them)
+          if (lazy_selective && (lazy_chunk != current_chunk))
+          {
+            drop_checkpoints(lazy_chunk);
+            lazy_selective = 0;
+            for (i = 0; i < num_readers; i++)
+            {
+              ((LASreadItemCompressed*)(readers_compressed[i]))->request_layers(0);
+            }
+          }
           // read the sizes of all layers
           for (i = 0; i < num_readers; i++)
           {
             ((LASreadItemCompressed*)(readers_compressed[i]))->chunk_sizes();
+            ((LASreadItemCompressed*)(readers_compressed[i]))->set_chunk_count(count);
           }
           for (i = 0; i < num_readers; i++)
           {
@@ -491,6 +825,10 @@ BOOL LASreadPoint::read(U8* const * point)
           dec->init(instream);
         }
         readers = readers_compressed;
+        if (decode_status)
+        {
+          return report_error(decode_status);
+        }
       }
     }
     else
@@ -503,37 +841,80 @@ BOOL LASreadPoint::read(U8* const * point)
   }
   catch (I32 exception) 
   {
-    // create error string
-    if (last_error == 0) last_error = new CHAR[128];
-    // report error
-    if (exception == EOF)
+    // errors of instreams without a window
+    return report_error(exception);
+  }
+  return TRUE;
+}
+
+BOOL LASreadPoint::request_layers(const U32 decompress_selective, U8* const * point)
+{
+  U32 i;
+
+  // only new LAS 1.4 points have layers (all other items are always decompressed)
+  if (!layered_las14_compression) return TRUE;
+  // threads and the cache decompress entire chunks with the layers selected at setup
+  if (workers || cache_max_bytes) return FALSE;
+  if (!instream->isSeekable()) return FALSE;
+
+  if (lazy_chunk != current_chunk) lazy_selective = 0;
+  U32 layers = decompress_selective & ~(this->decompress_selective | lazy_selective);
+  if (layers == 0) return TRUE;
+
+  lazy_selective |= layers;
+  lazy_chunk = current_chunk;
+  for (i = 0; i < num_readers; i++)
+  {
+    ((LASreadItemCompressed*)(readers_compressed[i]))->request_layers(lazy_selective);
+  }
+
+  // the init of a chunk that was not started yet decompresses them right away
+  if (readers == 0) return TRUE;
+
+  // otherwise the chunk is decompressed again up to the point read last (without
+  // the checkpoints that lack the state of these layers)
+  drop_checkpoints(current_chunk);
+  U32 target = (chunk_totals ? chunk_totals[current_chunk] : current_chunk*chunk_size) + chunk_count - 1;
+  if (!seek(target + 1, target))
+  {
+    return FALSE;
+  }
+  return read(point);
+}
+
+BOOL LASreadPoint::report_error(const I32 error)
+{
+  decode_status = 0;
+  // create error string
+  if (last_error == 0) last_error = new CHAR[128];
+  // report error
+  if (error == EOF)
+  {
+    // end-of-file
+    if (dec)
     {
-      // end-of-file
-      if (dec)
-      {
-        snprintf(last_error, 128, "end-of-file during chunk with index %u", current_chunk);
-      }
-      else
-      {
-        snprintf(last_error, 128, "end-of-file");
-      }
+      snprintf(last_error, 128, "end-of-file during chunk with index %u", current_chunk);
     }
     else
     {
-      // decompression error
-      snprintf(last_error, 128, "chunk with index %u of %u is corrupt", current_chunk, tabled_chunks);
-      // if we know where the next chunk starts ...
-      if ((current_chunk+1) < tabled_chunks)
-      {
-        // ... try to seek to the next chunk
-        instream->seek(chunk_starts[(current_chunk+1)]);
-        // ... ready for next LASreadPoint::read()
-        chunk_count = chunk_size;
-      }
+      snprintf(last_error, 128, "end-of-file");
     }
-    return FALSE;
   }
-  return TRUE;
+  else
+  {
+    // decompression error
+    snprintf(last_error, 128, "chunk with index %u of %u is corrupt", current_chunk, tabled_chunks);
+  }
+  // if we know where the next chunk starts (a layer may also end early) ...
+  if (dec && ((current_chunk+1) < tabled_chunks))
+  {
+    // ... try to seek to the next chunk
+    dec->done();
+    instream->seek(chunk_starts[(current_chunk+1)]);
+    // ... ready for next LASreadPoint::read()
+    chunk_count = chunk_size;
+  }
+  return FALSE;
 }
 
 BOOL LASreadPoint::check_end()
@@ -542,6 +923,12 @@ BOOL LASreadPoint::check_end()
   {
     if (dec)
     {
+      // the stream is behind the last chunk that was decompressed in parallel
+      if (batch_count)
+      {
+        current_chunk = batch_chunk + batch_count - 1;
+        batch_count = 0;
+      }
       dec->done();
       current_chunk++;
       // check integrity
@@ -656,6 +1043,7 @@ BOOL LASreadPoint::read_chunk_table()
   }
 
   // read the chunk table
+  ArithmeticDecoder* table_dec = 0;
   try
   {
     // seek to where the chunk table
@@ -697,16 +1085,25 @@ BOOL LASreadPoint::read_chunk_table()
     if (number_chunks > 0)
     {
       U32 i;
-      dec->init(instream);
-      IntegerCompressor ic(dec, 32, 2);
-      ic.initDecompressor();
-      for (i = 1; i <= number_chunks; i++)
+      // the chunk table is written in one pass and never with static models. it
+      // has a decoder of its own so that its models are not kept in the arena of
+      // the decoder for the points
+      table_dec = new ArithmeticDecoder(LASZIP_CODER_ARITHMETIC);
+      table_dec->init(instream);
       {
-        if (chunk_size == U32_MAX) chunk_totals[i] = ic.decompress((i>1 ? chunk_totals[i-1] : 0), 0);
-        chunk_starts[i] = ic.decompress((i>1 ? (U32)(chunk_starts[i-1]) : 0), 1);
-        tabled_chunks++;
+        // the models of the IntegerCompressor go before their decoder
+        IntegerCompressorFixed<32> ic(table_dec, 2);
+        ic.initDecompressor();
+        for (i = 1; i <= number_chunks; i++)
+        {
+          if (chunk_size == U32_MAX) chunk_totals[i] = ic.decompress((i>1 ? chunk_totals[i-1] : 0), 0);
+          chunk_starts[i] = ic.decompress((i>1 ? (U32)(chunk_starts[i-1]) : 0), 1);
+          tabled_chunks++;
+        }
       }
-      dec->done();
+      table_dec->done();
+      delete table_dec;
+      table_dec = 0;
       for (i = 1; i <= number_chunks; i++)
       {
         if (chunk_size == U32_MAX) chunk_totals[i] += chunk_totals[i-1];
@@ -717,10 +1114,12 @@ BOOL LASreadPoint::read_chunk_table()
         }
       }
     }
+    complete_chunk_table = TRUE;
   }
   catch (...)
   {
     // something went wrong while reading the chunk table
+    if (table_dec) delete table_dec;
     if (chunk_totals) delete [] chunk_totals;
     chunk_totals = 0;
     // no choice but to fail if adaptive chunking was used
@@ -795,10 +1194,497 @@ U32 LASreadPoint::search_chunk_table(const U32 index, const U32 lower, const U32
     return search_chunk_table(index, lower, mid);
 }
 
+void LASreadPoint::save_checkpoint()
+{
+  U32 i;
+
+  // only for the chunks in a complete chunk table
+  if (!complete_chunk_table || (current_chunk >= number_chunks)) return;
+  if (checkpoints && (current_chunk >= checkpoint_chunks)) return;
+
+  if (checkpoints == 0)
+  {
+    checkpoint_chunks = number_chunks;
+    checkpoints = new U8**[checkpoint_chunks];
+    memset(checkpoints, 0, sizeof(U8**)*checkpoint_chunks);
+    checkpoint_counts = new U32[checkpoint_chunks];
+    if (IS_LITTLE_ENDIAN())
+    {
+      checkpoint_outstream = new ByteStreamOutArrayLE();
+      checkpoint_instream = new ByteStreamInArrayLE();
+    }
+    else
+    {
+      checkpoint_outstream = new ByteStreamOutArrayBE();
+      checkpoint_instream = new ByteStreamInArrayBE();
+    }
+  }
+
+  if (checkpoints[current_chunk] == 0)
+  {
+    checkpoint_counts[current_chunk] = chunk_size / checkpoint_interval + 1;
+    checkpoints[current_chunk] = new U8*[checkpoint_counts[current_chunk]];
+    memset(checkpoints[current_chunk], 0, sizeof(U8*)*checkpoint_counts[current_chunk]);
+  }
+
+  U32 index = chunk_count / checkpoint_interval;
+  if ((index >= checkpoint_counts[current_chunk]) || checkpoints[current_chunk][index]) return; // seen this point before
+
+  // the state of all readers and (unless layered) of the decoder they share
+  checkpoint_outstream->seek(0);
+  for (i = 0; i < num_readers; i++)
+  {
+    if (!((LASreadItemCompressed*)(readers_compressed[i]))->save_state(checkpoint_outstream))
+    {
+      // this point type does not support checkpoints
+      free_checkpoints();
+      checkpoint_interval = 0;
+      return;
+    }
+  }
+  if (!layered_las14_compression)
+  {
+    dec->saveState(checkpoint_outstream);
+  }
+
+  U32 num_bytes = (U32)checkpoint_outstream->getCurr();
+  U8* checkpoint = new U8[sizeof(U32)+num_bytes];
+  memcpy(checkpoint, &num_bytes, sizeof(U32));
+  memcpy(checkpoint+sizeof(U32), checkpoint_outstream->getData(), num_bytes);
+  checkpoints[current_chunk][index] = checkpoint;
+}
+
+BOOL LASreadPoint::load_checkpoint(const U32 index)
+{
+  U32 i;
+
+  // the first point of the chunk inits the readers and the decoder
+  if (chunk_count == 0)
+  {
+    if (!read(seek_point))
+    {
+      return FALSE;
+    }
+  }
+
+  const U8* checkpoint = checkpoints[current_chunk][index];
+  U32 num_bytes;
+  memcpy(&num_bytes, checkpoint, sizeof(U32));
+  checkpoint_instream->init(checkpoint+sizeof(U32), num_bytes);
+
+  try
+  {
+    for (i = 0; i < num_readers; i++)
+    {
+      if (!((LASreadItemCompressed*)(readers_compressed[i]))->load_state(checkpoint_instream))
+      {
+        return FALSE;
+      }
+    }
+    if (!layered_las14_compression)
+    {
+      if (!dec->loadState(checkpoint_instream))
+      {
+        return FALSE;
+      }
+    }
+  }
+  catch (...)
+  {
+    return FALSE;
+  }
+
+  chunk_count = index*checkpoint_interval;
+  return TRUE;
+}
+
+void LASreadPoint::drop_checkpoints(const U32 chunk)
+{
+  if (checkpoints && (chunk < checkpoint_chunks) && checkpoints[chunk])
+  {
+    U32 i;
+    for (i = 0; i < checkpoint_counts[chunk]; i++)
+    {
+      if (checkpoints[chunk][i]) delete [] checkpoints[chunk][i];
+    }
+    delete [] checkpoints[chunk];
+    checkpoints[chunk] = 0;
+  }
+}
+
+void LASreadPoint::free_checkpoints()
+{
+  if (checkpoints)
+  {
+    U32 c;
+    for (c = 0; c < checkpoint_chunks; c++)
+    {
+      drop_checkpoints(c);
+    }
+    delete [] checkpoints;
+    delete [] checkpoint_counts;
+    checkpoints = 0;
+    checkpoint_counts = 0;
+    checkpoint_chunks = 0;
+  }
+  if (checkpoint_outstream)
+  {
+    delete checkpoint_outstream;
+    checkpoint_outstream = 0;
+  }
+  if (checkpoint_instream)
+  {
+    delete checkpoint_instream;
+    checkpoint_instream = 0;
+  }
+}
+
+BOOL LASreadPoint::read_cached_chunk()
+{
+  U32 i;
+
+  // only for the chunks in a complete chunk table
+  U32 num_points = get_chunk_points(current_chunk);
+  if (num_points == 0) return FALSE;
+
+  if (cache_points == 0)
+  {
+    cache_chunks = number_chunks;
+    cache_points = new U8*[cache_chunks];
+    memset(cache_points, 0, sizeof(U8*)*cache_chunks);
+    cache_older = new U32[cache_chunks];
+    cache_newer = new U32[cache_chunks];
+    cache_oldest = U32_MAX;
+    cache_newest = U32_MAX;
+    cache_bytes = 0;
+  }
+  if (current_chunk >= cache_chunks) return FALSE;
+
+  if (cache_points[current_chunk])
+  {
+    // hit: becomes the most recently used chunk
+    cache_hits++;
+    unlink_cached_chunk(current_chunk);
+    insert_cached_chunk(current_chunk, cache_points[current_chunk]);
+    // as if we had read the compressed bytes of the chunk
+    if (!instream->seek(chunk_starts[current_chunk + 1]))
+    {
+      instream->seek(chunk_starts[current_chunk]);
+      return FALSE;
+    }
+  }
+  else
+  {
+    cache_misses++;
+    // chunks that do not fit are decompressed as usual
+    U64 num_decoded = (U64)num_points*decoded_point_size;
+    if (num_decoded > cache_max_bytes) return FALSE;
+    // maybe decompress this and the following chunks in parallel and cache them all
+    if (workers && read_chunks())
+    {
+      for (i = 0; i < batch_count; i++)
+      {
+        U32 chunk = batch_chunk + i;
+        if (!batch_valid[i] || cache_points[chunk]) continue;
+        num_decoded = (U64)get_chunk_points(chunk)*decoded_point_size;
+        if (num_decoded > cache_max_bytes) continue;
+        U8* points = new U8[(size_t)num_decoded];
+        memcpy(points, batch_points[i], (size_t)num_decoded);
+        insert_cached_chunk(chunk, points);
+      }
+      return TRUE;
+    }
+    I64 num_bytes = chunk_starts[current_chunk + 1] - chunk_starts[current_chunk];
+    if ((num_bytes <= 0) || (num_bytes > I32_MAX)) return FALSE;
+    if (cache_chunk_bytes_allocated < (U32)num_bytes)
+    {
+      if (cache_chunk_bytes) delete [] cache_chunk_bytes;
+      cache_chunk_bytes = new U8[(U32)num_bytes];
+      cache_chunk_bytes_allocated = (U32)num_bytes;
+    }
+    try
+    {
+      instream->getBytes(cache_chunk_bytes, (U32)num_bytes);
+    }
+    catch (...)
+    {
+      // let the sequential reader deal with truncated files
+      instream->seek(chunk_starts[current_chunk]);
+      return FALSE;
+    }
+    U8* points = new U8[(size_t)num_decoded];
+    if (!cache_worker->decompress_chunk(cache_chunk_bytes, (U32)num_bytes, num_points, points))
+    {
+      // let the sequential reader report the corrupt chunk
+      delete [] points;
+      instream->seek(chunk_starts[current_chunk]);
+      return FALSE;
+    }
+    insert_cached_chunk(current_chunk, points);
+  }
+
+  // from now on the points are copied from the cache as if it was a batch of one chunk
+  batch_chunk = current_chunk;
+  batch_count = 1;
+  batch_index = 0;
+  batch_point = cache_points[current_chunk];
+  chunk_size = num_points;
+  chunk_count = 0;
+  readers = readers_compressed;
+
+  return TRUE;
+}
+
+void LASreadPoint::insert_cached_chunk(const U32 chunk, U8* points)
+{
+  U64 num_bytes = (U64)get_chunk_points(chunk)*decoded_point_size;
+
+  // evict the least recently used chunks until the new one fits
+  if (cache_points[chunk] == 0)
+  {
+    while ((cache_oldest != U32_MAX) && ((cache_bytes + num_bytes) > cache_max_bytes))
+    {
+      U32 oldest = cache_oldest;
+      unlink_cached_chunk(oldest);
+      delete [] cache_points[oldest];
+      cache_points[oldest] = 0;
+      cache_bytes -= (U64)get_chunk_points(oldest)*decoded_point_size;
+    }
+    cache_points[chunk] = points;
+    cache_bytes += num_bytes;
+  }
+
+  // link as the most recently used chunk
+  cache_older[chunk] = cache_newest;
+  cache_newer[chunk] = U32_MAX;
+  if (cache_newest != U32_MAX) cache_newer[cache_newest] = chunk;
+  cache_newest = chunk;
+  if (cache_oldest == U32_MAX) cache_oldest = chunk;
+}
+
+void LASreadPoint::unlink_cached_chunk(const U32 chunk)
+{
+  if (cache_older[chunk] != U32_MAX)
+    cache_newer[cache_older[chunk]] = cache_newer[chunk];
+  else
+    cache_oldest = cache_newer[chunk];
+  if (cache_newer[chunk] != U32_MAX)
+    cache_older[cache_newer[chunk]] = cache_older[chunk];
+  else
+    cache_newest = cache_older[chunk];
+}
+
+void LASreadPoint::free_cache()
+{
+  if (cache_points)
+  {
+    U32 c;
+    for (c = 0; c < cache_chunks; c++)
+    {
+      if (cache_points[c]) delete [] cache_points[c];
+    }
+    delete [] cache_points;
+    delete [] cache_older;
+    delete [] cache_newer;
+    cache_points = 0;
+    cache_older = 0;
+    cache_newer = 0;
+    cache_chunks = 0;
+  }
+  cache_oldest = U32_MAX;
+  cache_newest = U32_MAX;
+  cache_bytes = 0;
+  cache_hits = 0;
+  cache_misses = 0;
+}
+
+U32 LASreadPoint::get_chunk_points(const U32 chunk) const
+{
+  if (!complete_chunk_table || (chunk >= number_chunks)) return 0;
+  // variable sized chunks?
+  if (chunk_totals) return chunk_totals[chunk+1]-chunk_totals[chunk];
+  // the number of points in the last fixed sized chunk is not known
+  if ((chunk+1) < number_chunks) return chunk_size;
+  return 0;
+}
+
+void LASreadPoint::select_batch_chunk(const U32 index)
+{
+  batch_index = index;
+  current_chunk = batch_chunk + batch_index;
+  chunk_size = get_chunk_points(current_chunk);
+  chunk_count = 0;
+  batch_point = (batch_valid[batch_index] ? batch_points[batch_index] : 0);
+}
+
+BOOL LASreadPoint::read_chunks()
+{
+  U32 i, n;
+
+  // how many of the upcoming chunks have a known size and number of points
+  for (n = 0; n < num_threads; n++)
+  {
+    U32 num_points = get_chunk_points(current_chunk + n);
+    if (num_points == 0) break;
+    I64 num_bytes = chunk_starts[current_chunk + n + 1] - chunk_starts[current_chunk + n];
+    if ((num_bytes <= 0) || (num_bytes > I32_MAX)) break;
+    batch_sizes[n] = (U32)num_bytes;
+    if (batch_bytes_allocated[n] < batch_sizes[n])
+    {
+      if (batch_bytes[n]) delete [] batch_bytes[n];
+      batch_bytes[n] = new U8[batch_sizes[n]];
+      batch_bytes_allocated[n] = batch_sizes[n];
+    }
+    if (batch_points_allocated[n] < num_points)
+    {
+      if (batch_points[n]) delete [] batch_points[n];
+      batch_points[n] = new U8[(size_t)num_points*decoded_point_size];
+      batch_points_allocated[n] = num_points;
+    }
+  }
+
+  // not worth the overhead with fewer than two chunks
+  if (n < 2) return FALSE;
+
+  // read the compressed bytes of all chunks
+  try
+  {
+    for (i = 0; i < n; i++)
+    {
+      instream->getBytes(batch_bytes[i], batch_sizes[i]);
+    }
+  }
+  catch (...)
+  {
+    // let the sequential reader deal with truncated files
+    instream->seek(chunk_starts[current_chunk]);
+    return FALSE;
+  }
+
+  // decompress the chunks of the batch on the threads of the pool (and this one)
+  pool->run(n, [this](U32 i) {
+    batch_valid[i] = workers[i]->decompress_chunk(batch_bytes[i], batch_sizes[i], get_chunk_points(current_chunk + i), batch_points[i]);
+  });
+
+  // from now on the points are copied from the decompressed chunks
+  batch_chunk = current_chunk;
+  batch_count = n;
+  select_batch_chunk(0);
+  readers = readers_compressed;
+
+  return TRUE;
+}
+
+BOOL LASreadPoint::decompress_chunk(const U8* bytes, const U32 num_bytes, const U32 num_points, U8* points)
+{
+  U32 i, j;
+  U32 context = 0;
+
+  try
+  {
+    chunk_stream->init(bytes, num_bytes);
+    for (i = 0; i < num_readers; i++)
+    {
+      chunk_point[i] = points + item_offsets[i];
+    }
+    // the first point is raw and leaves some bytes of the item untouched
+    memset(points, 0, decoded_point_size);
+    if (layered_las14_compression)
+    {
+      // because extended_point_type must be set
+      points[22] = 1;
+    }
+    for (i = 0; i < num_readers; i++)
+    {
+      readers_raw[i]->read(chunk_point[i], context);
+    }
+    if (layered_las14_compression)
+    {
+      // for layered compression 'dec' only hands over the stream
+      dec->init(chunk_stream, FALSE);
+      // read how many points are in the chunk
+      U32 count;
+      chunk_stream->get32bitsLE((U8*)&count);
+      // read the sizes of all layers
+      for (i = 0; i < num_readers; i++)
+      {
+        ((LASreadItemCompressed*)(readers_compressed[i]))->chunk_sizes();
+        ((LASreadItemCompressed*)(readers_compressed[i]))->set_chunk_count(count);
+      }
+      for (i = 0; i < num_readers; i++)
+      {
+        ((LASreadItemCompressed*)(readers_compressed[i]))->init(chunk_point[i], context);
+      }
+    }
+    else
+    {
+      for (i = 0; i < num_readers; i++)
+      {
+        ((LASreadItemCompressed*)(readers_compressed[i]))->init(chunk_point[i], context);
+      }
+      dec->init(chunk_stream);
+    }
+    if (fused)
+    {
+      if (num_points > 1) fused->read(points + decoded_point_size, num_points - 1, decoded_point_size, item_offsets);
+    }
+    else
+    {
+      for (j = 1; j < num_points; j++)
+      {
+        // readers may leave unchanged items untouched
+        memcpy(points + (size_t)j*decoded_point_size, points + (size_t)(j-1)*decoded_point_size, decoded_point_size);
+        context = 0;
+        for (i = 0; i < num_readers; i++)
+        {
+          chunk_point[i] += decoded_point_size;
+          readers_compressed[i]->read(chunk_point[i], context);
+        }
+      }
+    }
+    dec->done();
+  }
+  catch (...)
+  {
+    return FALSE;
+  }
+  if (decode_status)
+  {
+    decode_status = 0;
+    return FALSE;
+  }
+  // check integrity
+  return (chunk_stream->tell() == num_bytes);
+}
+
 LASreadPoint::~LASreadPoint()
 {
   U32 i;
 
+  if (pool) delete pool;
+
+  if (workers)
+  {
+    for (i = 0; i < num_threads; i++)
+    {
+      if (workers[i]) delete workers[i];
+      if (batch_bytes[i]) delete [] batch_bytes[i];
+      if (batch_points[i]) delete [] batch_points[i];
+    }
+    delete [] workers;
+    delete [] batch_bytes;
+    delete [] batch_bytes_allocated;
+    delete [] batch_points;
+    delete [] batch_points_allocated;
+    delete [] batch_sizes;
+    delete [] batch_valid;
+  }
+
+  if (item_offsets) delete [] item_offsets;
+  if (item_footprints) delete [] item_footprints;
+  if (chunk_stream) delete chunk_stream;
+  if (chunk_point) delete [] chunk_point;
+
   if (readers_raw)
   {
     for (i = 0; i < num_readers; i++)
@@ -817,11 +1703,18 @@ LASreadPoint::~LASreadPoint()
     delete [] readers_compressed;
   }
 
+  if (fused) delete fused;
+
   if (dec)
   {
     delete dec;
   }
 
+  free_checkpoints();
+  free_cache();
+  if (cache_worker) delete cache_worker;
+  if (cache_chunk_bytes) delete [] cache_chunk_bytes;
+
   if (chunk_totals) delete [] chunk_totals;
   if (chunk_starts) free(chunk_starts);
 
@@ -831,6 +1724,8 @@ LASreadPoint::~LASreadPoint()
     delete [] seek_point;
   }
 
+  if (selective_bytes) delete [] selective_bytes;
+
   if (last_error) delete [] last_error;
   if (last_warning) delete [] last_warning;
 }
@@ -24,6 +24,22 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- caps the threads at one per core and at most 8
+    16 October 2026 -- zero the seek point so that a seek puts no garbage into new LAS 1.4 points
+    16 October 2026 -- the threads that decompress chunks are reused from one batch to the next
+    16 October 2026 -- more layers of new LAS 1.4 points can be requested while reading a chunk
+    16 October 2026 -- optional selective decompression of any of the extra bytes of new LAS 1.4 points
+    16 October 2026 -- reads BYTE14 items that code the extra bytes attribute by attribute
+    16 October 2026 -- standard point types are read without a virtual call per item
+    16 October 2026 -- the decoders report errors through a status that is checked once per point
+    16 October 2026 -- reads chunks of static models (with an adaptive chunk table)
+    16 October 2026 -- reads chunks of the bit-packed compressor for the hot storage tier
+    16 October 2026 -- optional LRU cache of decompressed chunks for repeated reads
+    16 October 2026 -- optional checkpoints inside chunks for faster seeking
+    16 October 2026 -- public access to the chunk table
+    16 October 2026 -- decoder is done() before seeking past a corrupt chunk
+    16 October 2026 -- optional decompression of the LAS 1.4 layers of a chunk in parallel
+    16 October 2026 -- optional decompression of whole chunks with multiple threads
     23 September 2020 -- rare fix for bit-corrupted LAZ files where chunk table is zeroed
     28 August 2017 -- moving 'context' from global development hack to interface  
     18 July 2017 -- bug fix for spatial-indexed reading of native compressed LAS 1.4 
@@ -51,7 +67,11 @@
 #include "bytestreamin.hpp"
 
 class LASreadItem;
+class LASreadItemsFused;
 class ArithmeticDecoder;
+class ByteStreamInArray;
+class ByteStreamOutArray;
+class LASthreadPool;
 
 class LASreadPoint
 {
@@ -59,12 +79,43 @@ public:
   LASreadPoint(U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL);
   ~LASreadPoint();
 
+  // optional: decompress up to this many chunks in parallel (call *before* setup)
+  BOOL set_threads(const U32 num_threads);
+
+  // optional: decompress the layers of new LAS 1.4 points in parallel (call *before* setup)
+  BOOL set_parallel_layers(const BOOL parallel_layers);
+
+  // optional: remember the decoder every this many points of a chunk so that
+  // seek() can continue from there instead of from the chunk start (call *before* setup)
+  BOOL set_checkpoints(const U32 interval);
+
+  // optional: keep up to this many bytes of decompressed chunks in memory so that
+  // reading or seeking into a recently used chunk again is a memcpy (call *before* setup)
+  BOOL set_chunk_cache(const U64 max_bytes);
+
+  // optional: decompress only the extra bytes of new LAS 1.4 points that are requested
+  // here instead of those selected with the BYTE flags of decompress_selective. extra
+  // bytes beyond 'num_bytes' are not requested (call *before* setup)
+  BOOL set_selective_bytes(const U32 num_bytes, const BOOL* requested);
+  void get_chunk_cache_stats(U64& hits, U64& misses, U64& bytes) const;
+
+  // optional: query the chunk table of chunked compressed points (reads it if needed)
+  // 'num_points' of the last fixed sized chunk is the chunk size and not clamped
+  // because only the header knows the number of points (the caller clamps it)
+  BOOL get_chunk_count(U32& count);
+  BOOL get_chunk_info(const U32 index, I64& first_point, U32& num_points, I64& byte_offset, I64& byte_size);
+
   // should only be called *once*
   BOOL setup(const U32 num_items, const LASitem* items, const LASzip* laszip=0);
 
   BOOL init(ByteStreamIn* instream);
   BOOL seek(const U32 current, const U32 target);
   BOOL read(U8* const * point);
+
+  // optional: also decompress these layers of new LAS 1.4 points for the rest of the
+  // current chunk. the chunk is decompressed again up to the point read last, which is
+  // read into 'point' again (not with threads or a chunk cache, call *after* read)
+  BOOL request_layers(const U32 decompress_selective, U8* const * point);
   BOOL check_end();
   BOOL done();
 
@@ -77,6 +128,7 @@ private:
   LASreadItem** readers;
   LASreadItem** readers_raw;
   LASreadItem** readers_compressed;
+  LASreadItemsFused* fused;
   ArithmeticDecoder* dec;
   BOOL layered_las14_compression;
   // used for chunking
@@ -90,13 +142,75 @@ private:
   BOOL init_dec();
   BOOL read_chunk_table();
   U32 search_chunk_table(const U32 index, const U32 lower, const U32 upper);
+  BOOL complete_chunk_table;
+  // used for parallel decompression of chunks
+  U32 num_threads;
+  LASreadPoint** workers;
+  LASthreadPool* pool;
+  U32* item_offsets;
+  U32* item_footprints;
+  U32 decoded_point_size;
+  U8** batch_bytes;
+  U32* batch_bytes_allocated;
+  U8** batch_points;
+  U32* batch_points_allocated;
+  U32* batch_sizes;
+  BOOL* batch_valid;
+  U32 batch_chunk;
+  U32 batch_count;
+  U32 batch_index;
+  U8* batch_point;
+  ByteStreamInArray* chunk_stream;
+  U8** chunk_point;
+  U32 get_chunk_points(const U32 chunk) const;
+  BOOL read_chunks();
+  void select_batch_chunk(const U32 index);
+  BOOL decompress_chunk(const U8* bytes, const U32 num_bytes, const U32 num_points, U8* points);
   // used for selective decompression (new LAS 1.4 point types only)
   U32 decompress_selective;
+  U32 num_selective_bytes;
+  BOOL* selective_bytes;
+  // used for parallel decompression of layers (new LAS 1.4 point types only)
+  BOOL parallel_layers;
+  // used for checkpoints inside chunks (points in chunks of the chunk table only)
+  U32 checkpoint_interval;
+  U32 checkpoint_chunks;
+  U8*** checkpoints;
+  U32* checkpoint_counts;
+  ByteStreamOutArray* checkpoint_outstream;
+  ByteStreamInArray* checkpoint_instream;
+  void save_checkpoint();
+  BOOL load_checkpoint(const U32 index);
+  void drop_checkpoints(const U32 chunk);
+  void free_checkpoints();
+  // used for decompressing more layers while reading a chunk (new LAS 1.4 point types only)
+  U32 lazy_selective;
+  U32 lazy_chunk;
+  // used for caching decompressed chunks (points in chunks of the chunk table only)
+  U64 cache_max_bytes;
+  U64 cache_bytes;
+  U64 cache_hits;
+  U64 cache_misses;
+  U32 cache_chunks;
+  U8** cache_points;
+  U32* cache_older;
+  U32* cache_newer;
+  U32 cache_oldest;
+  U32 cache_newest;
+  U8* cache_chunk_bytes;
+  U32 cache_chunk_bytes_allocated;
+  LASreadPoint* cache_worker;
+  BOOL read_cached_chunk();
+  void insert_cached_chunk(const U32 chunk, U8* points);
+  void unlink_cached_chunk(const U32 chunk);
+  void free_cache();
   // used for seeking
   I64 point_start;
   U32 point_size;
   U8** seek_point;
   // used for error and warning reporting
+  I32 decode_status;
+  BOOL report_error(const I32 error);
   CHAR* last_error;
   CHAR* last_warning;
 };
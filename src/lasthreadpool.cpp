@@ -0,0 +1,116 @@
+/*
+===============================================================================
+
+  FILE:  lasthreadpool.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include "lasthreadpool.hpp"
+
+LASthreadPool::LASthreadPool()
+{
+  job = 0;
+  num_jobs = 0;
+  next_job = 0;
+  finished_jobs = 0;
+  generation = 0;
+  quit = FALSE;
+}
+
+LASthreadPool::~LASthreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    quit = TRUE;
+  }
+  wake.notify_all();
+  for (size_t i = 0; i < threads.size(); i++)
+  {
+    threads[i].join();
+  }
+}
+
+BOOL LASthreadPool::start(const U32 num_workers)
+{
+  U32 i;
+  for (i = 0; i < num_workers; i++)
+  {
+    try
+    {
+      threads.push_back(std::thread(&LASthreadPool::worker, this));
+    }
+    catch (...)
+    {
+      // make do with the threads we got
+      break;
+    }
+  }
+  return (threads.size() > 0);
+}
+
+void LASthreadPool::run(const U32 num_jobs, const std::function<void(U32)>& job)
+{
+  if (num_jobs == 0) return;
+  std::unique_lock<std::mutex> lock(mutex);
+  this->job = &job;
+  this->num_jobs = num_jobs;
+  next_job = 0;
+  finished_jobs = 0;
+  generation++;
+  if (num_jobs > 1) wake.notify_all();
+  // the calling thread takes jobs as well
+  work(lock);
+  done.wait(lock, [this]() { return finished_jobs == this->num_jobs; });
+  this->job = 0;
+}
+
+void LASthreadPool::work(std::unique_lock<std::mutex>& lock)
+{
+  while (job && (next_job < num_jobs))
+  {
+    U32 j = next_job++;
+    const std::function<void(U32)>* current = job;
+    lock.unlock();
+    (*current)(j);
+    lock.lock();
+    finished_jobs++;
+  }
+  if (job && (finished_jobs == num_jobs)) done.notify_all();
+}
+
+void LASthreadPool::worker()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  U32 seen = generation;
+  while (TRUE)
+  {
+    wake.wait(lock, [this, &seen]() { return quit || (generation != seen); });
+    if (quit) return;
+    seen = generation;
+    work(lock);
+  }
+}
@@ -0,0 +1,75 @@
+/*
+===============================================================================
+
+  FILE:  lasthreadpool.hpp
+
+  CONTENTS:
+
+    A fixed set of worker threads that stay alive from one batch of jobs to
+    the next so that readers and writers do not start threads for every batch
+    of chunks (or layers) that they decompress or compress in parallel.
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- created to reuse the threads of one batch for the next
+
+===============================================================================
+*/
+#ifndef LAS_THREAD_POOL_HPP
+#define LAS_THREAD_POOL_HPP
+
+#include "mydefs.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class LASthreadPool
+{
+public:
+  LASthreadPool();
+  ~LASthreadPool();
+
+  // starts (up to) 'num_workers' threads. returns FALSE if none could be started
+  BOOL start(const U32 num_workers);
+  U32 get_num_workers() const { return (U32)threads.size(); };
+
+  // runs job(0) to job(num_jobs - 1) on the workers and on the calling thread
+  // and returns once all of them are done. without workers the calling thread
+  // runs all of them. never call run() of the same pool from two threads
+  void run(const U32 num_jobs, const std::function<void(U32)>& job);
+
+private:
+  std::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+  const std::function<void(U32)>* job;
+  U32 num_jobs;
+  U32 next_job;
+  U32 finished_jobs;
+  U32 generation;
+  BOOL quit;
+
+  void work(std::unique_lock<std::mutex>& lock);
+  void worker();
+};
+
+#endif
@@ -0,0 +1,491 @@
+/*
+===============================================================================
+
+  FILE:  laswriteitemattributes.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include "laswriteitemattributes.hpp"
+#include "lasattributer.hpp"
+
+#include <assert.h>
+#include <string.h>
+
+U32 laszip_attribute_layers(const U32 num_attributes, const LASattribute* attributes, LASattributeLayer* layers)
+{
+  static const U8 kinds[10] = { LASZIP_ATTRIBUTE_BYTE, LASZIP_ATTRIBUTE_BYTE, LASZIP_ATTRIBUTE_INT16, LASZIP_ATTRIBUTE_INT16, LASZIP_ATTRIBUTE_INT32, LASZIP_ATTRIBUTE_INT32, LASZIP_ATTRIBUTE_INT64, LASZIP_ATTRIBUTE_INT64, LASZIP_ATTRIBUTE_FLOAT32, LASZIP_ATTRIBUTE_FLOAT64 };
+  U32 i;
+  for (i = 0; i < num_attributes; i++)
+  {
+    const LASattribute* attribute = &attributes[i];
+    LASattributeLayer* layer = &layers[i];
+    layer->has_no_data = FALSE;
+    layer->no_data = 0;
+    if (attribute->data_type == 0)
+    {
+      // untyped bytes
+      if (attribute->options == 0) break;
+      layer->kind = LASZIP_ATTRIBUTE_BYTE;
+      layer->count = attribute->options;
+    }
+    else if (attribute->data_type <= 30)
+    {
+      layer->kind = kinds[attribute->get_type()];
+      layer->count = (U8)attribute->get_dim();
+      // only single values have one no_data value
+      if (attribute->has_no_data() && (layer->count == 1) && (layer->kind != LASZIP_ATTRIBUTE_BYTE))
+      {
+        layer->has_no_data = TRUE;
+        if (layer->kind == LASZIP_ATTRIBUTE_FLOAT32)
+        {
+          U32I32F32 no_data;
+          no_data.f32 = (F32)attribute->no_data[0].f64;
+          layer->no_data = no_data.u32;
+        }
+        else
+        {
+          layer->no_data = attribute->no_data[0].u64;
+          if (layer->kind == LASZIP_ATTRIBUTE_INT16) layer->no_data &= 0xFFFF;
+          else if (layer->kind == LASZIP_ATTRIBUTE_INT32) layer->no_data &= 0xFFFFFFFF;
+        }
+      }
+    }
+    else
+    {
+      break;
+    }
+  }
+  return i;
+}
+
+LASwriteItemAttributes::LASwriteItemAttributes(ArithmeticEncoder* enc, U32 number, U32 num_attributes, const LASattributeLayer* attributes)
+{
+  U32 i, size;
+
+  /* not used as a encoder. just gives access to outstream */
+
+  assert(enc);
+  this->enc = enc;
+
+  /* must be more than one byte */
+
+  assert(number);
+  this->number = number;
+
+  /* the attributes that fit into the bytes followed by one layer per remaining byte */
+
+  layers = new LASattributeLayer[num_attributes + number];
+  num_layers = 0;
+  size = 0;
+  for (i = 0; i < num_attributes; i++)
+  {
+    if ((size + attributes[i].count*laszip_attribute_kind_size(attributes[i].kind)) > number) break;
+    layers[num_layers] = attributes[i];
+    size += attributes[i].count*laszip_attribute_kind_size(attributes[i].kind);
+    num_layers++;
+  }
+  while (size < number)
+  {
+    layers[num_layers].kind = LASZIP_ATTRIBUTE_BYTE;
+    layers[num_layers].count = 1;
+    layers[num_layers].has_no_data = FALSE;
+    layers[num_layers].no_data = 0;
+    size++;
+    num_layers++;
+  }
+
+  /* the values of all layers */
+
+  values = new LASattributeValue[number];
+  num_values = laszip_attribute_values(num_layers, layers, number, values);
+  assert(num_values);
+
+  /* zero outstream and encoder pointer arrays */
+
+  outstream_layers = 0;
+
+  enc_layers = 0;
+
+  changed_layers = new BOOL[num_layers];
+
+  for (i = 0; i < num_layers; i++)
+  {
+    changed_layers[i] = FALSE;
+  }
+
+  /* mark the four scanner channel contexts as uninitialized */
+
+  U32 c;
+  for (c = 0; c < 4; c++)
+  {
+    contexts[c].m_bytes = 0;
+  }
+  current_context = 0;
+}
+
+LASwriteItemAttributes::~LASwriteItemAttributes()
+{
+  /* destroy all initialized scanner channel contexts */
+
+  U32 c, i, b;
+  for (c = 0; c < 4; c++)
+  {
+    if (contexts[c].m_bytes)
+    {
+      for (i = 0; i < num_values; i++)
+      {
+        if (contexts[c].m_bytes[i]) enc_layers[values[i].layer]->destroySymbolModel(contexts[c].m_bytes[i]);
+        for (b = 0; b < 16; b++)
+        {
+          if (contexts[c].m_diff_bytes[16*i+b]) enc_layers[values[i].layer]->destroySymbolModel(contexts[c].m_diff_bytes[16*i+b]);
+        }
+        if (contexts[c].ic_values[i]) delete contexts[c].ic_values[i];
+        if (contexts[c].m_no_data[i]) enc_layers[values[i].layer]->destroyBitModel(contexts[c].m_no_data[i]);
+      }
+      delete [] contexts[c].m_bytes;
+      delete [] contexts[c].m_diff_bytes;
+      delete [] contexts[c].ic_values;
+      delete [] contexts[c].m_no_data;
+      delete [] contexts[c].last_item;
+    }
+  }
+
+  /* destroy all outstream and encoder arrays */
+
+  if (outstream_layers)
+  {
+    for (i = 0; i < num_layers; i++)
+    {
+      if (outstream_layers[i])
+      {
+        delete outstream_layers[i];
+        delete enc_layers[i];
+      }
+    }
+
+    delete [] outstream_layers;
+    delete [] enc_layers;
+  }
+
+  /* destroy all other arrays */
+
+  delete [] changed_layers;
+  delete [] values;
+  delete [] layers;
+}
+
+inline BOOL LASwriteItemAttributes::createAndInitModelsAndCompressors(U32 context, const U8* item)
+{
+  U32 i, b;
+
+  /* should only be called when context is unused */
+
+  assert(contexts[context].unused);
+
+  /* first create all entropy models, integer compressors and last items (if needed) */
+
+  if (contexts[context].m_bytes == 0)
+  {
+    contexts[context].m_bytes = new ArithmeticModel*[num_values];
+    contexts[context].m_diff_bytes = new ArithmeticModel*[16*num_values];
+    contexts[context].ic_values = new IntegerCompressor*[num_values];
+    contexts[context].m_no_data = new ArithmeticBitModel*[num_values];
+    for (i = 0; i < num_values; i++)
+    {
+      ArithmeticEncoder* enc_layer = enc_layers[values[i].layer];
+      contexts[context].m_bytes[i] = 0;
+      for (b = 0; b < 16; b++)
+      {
+        contexts[context].m_diff_bytes[16*i+b] = 0;
+      }
+      contexts[context].ic_values[i] = 0;
+      contexts[context].m_no_data[i] = 0;
+      switch (values[i].kind)
+      {
+      case LASZIP_ATTRIBUTE_BYTE:
+        contexts[context].m_bytes[i] = enc_layer->createSymbolModel(256);
+        break;
+      case LASZIP_ATTRIBUTE_INT16:
+        contexts[context].ic_values[i] = new IntegerCompressor(enc_layer, 16);
+        break;
+      case LASZIP_ATTRIBUTE_INT32:
+        contexts[context].ic_values[i] = new IntegerCompressor(enc_layer, 32);
+        break;
+      default:
+        // the number of significant bytes of the difference and the bytes
+        contexts[context].m_bytes[i] = enc_layer->createSymbolModel(laszip_attribute_kind_size(values[i].kind) + 1);
+        for (b = 0; b < 2*laszip_attribute_kind_size(values[i].kind); b++)
+        {
+          contexts[context].m_diff_bytes[16*i+b] = enc_layer->createSymbolModel(256);
+        }
+        break;
+      }
+      if (values[i].has_no_data)
+      {
+        contexts[context].m_no_data[i] = enc_layer->createBitModel();
+      }
+    }
+
+    /* create last item */
+    contexts[context].last_item = new U8[number];
+  }
+
+  /* then init entropy models and integer compressors */
+
+  for (i = 0; i < num_values; i++)
+  {
+    ArithmeticEncoder* enc_layer = enc_layers[values[i].layer];
+    if (contexts[context].m_bytes[i]) enc_layer->initSymbolModel(contexts[context].m_bytes[i]);
+    for (b = 0; b < 16; b++)
+    {
+      if (contexts[context].m_diff_bytes[16*i+b]) enc_layer->initSymbolModel(contexts[context].m_diff_bytes[16*i+b]);
+    }
+    if (contexts[context].ic_values[i]) contexts[context].ic_values[i]->initCompressor();
+    if (contexts[context].m_no_data[i]) enc_layer->initBitModel(contexts[context].m_no_data[i]);
+  }
+
+  /* init current context from item */
+
+  memcpy(contexts[context].last_item, item, number);
+
+  contexts[context].unused = FALSE;
+
+  return TRUE;
+}
+
+BOOL LASwriteItemAttributes::init(const U8* item, U32& context)
+{
+  U32 i;
+
+  /* on the first init create outstreams and encoders */
+
+  if (outstream_layers == 0)
+  {
+    /* create outstreams pointer array */
+
+    outstream_layers = new ByteStreamOutArray*[num_layers];
+
+    /* create outstreams */
+
+    if (IS_LITTLE_ENDIAN())
+    {
+      for (i = 0; i < num_layers; i++)
+      {
+        outstream_layers[i] = new ByteStreamOutArrayLE();
+      }
+    }
+    else
+    {
+      for (i = 0; i < num_layers; i++)
+      {
+        outstream_layers[i] = new ByteStreamOutArrayBE();
+      }
+    }
+
+    /* create encoder pointer array */
+
+    enc_layers = new ArithmeticEncoder*[num_layers];
+
+    /* create layer encoders */
+
+    for (i = 0; i < num_layers; i++)
+    {
+      enc_layers[i] = new ArithmeticEncoder(enc->getCoder());
+    }
+  }
+  else
+  {
+    /* otherwise just seek back */
+
+    for (i = 0; i < num_layers; i++)
+    {
+      outstream_layers[i]->seek(0);
+    }
+  }
+
+  /* init layer encoders */
+
+  for (i = 0; i < num_layers; i++)
+  {
+    enc_layers[i]->init(outstream_layers[i]);
+  }
+
+  /* set changed booleans to FALSE */
+
+  for (i = 0; i < num_layers; i++)
+  {
+    changed_layers[i] = FALSE;
+  }
+
+  /* mark the four scanner channel contexts as unused */
+
+  U32 c;
+  for (c = 0; c < 4; c++)
+  {
+    contexts[c].unused = TRUE;
+  }
+
+  /* set scanner channel as current context */
+
+  current_context = context; // all other items use context set by POINT14 writer
+
+  /* create and init entropy models and integer compressors (and init context from item)  */
+
+  createAndInitModelsAndCompressors(current_context, item);
+
+  return TRUE;
+}
+
+inline BOOL LASwriteItemAttributes::write(const U8* item, U32& context)
+{
+  // get last
+
+  U8* last_item = contexts[current_context].last_item;
+
+  // check for context switch
+
+  if (current_context != context)
+  {
+    current_context = context; // all other items use context set by POINT14 writer
+    if (contexts[current_context].unused)
+    {
+      createAndInitModelsAndCompressors(current_context, last_item);
+    }
+    last_item = contexts[current_context].last_item;
+  }
+
+  // compress
+
+  LAScontextATTRIBUTES* current = &contexts[current_context];
+  U32 i;
+  for (i = 0; i < num_values; i++)
+  {
+    const LASattributeValue* value = &values[i];
+    ArithmeticEncoder* enc_layer = enc_layers[value->layer];
+    if (value->kind == LASZIP_ATTRIBUTE_BYTE)
+    {
+      I32 diff = item[value->offset] - last_item[value->offset];
+      enc_layer->encodeSymbol(current->m_bytes[i], U8_FOLD(diff));
+      if (diff)
+      {
+        changed_layers[value->layer] = TRUE;
+        last_item[value->offset] = item[value->offset];
+      }
+      continue;
+    }
+    const U32 size = laszip_attribute_kind_size(value->kind);
+    U64 real = laszip_attribute_get(item + value->offset, size);
+    U64 pred = laszip_attribute_get(last_item + value->offset, size);
+    if (value->has_no_data)
+    {
+      // no_data values are flagged and do not become the prediction
+      if (real == value->no_data)
+      {
+        enc_layer->encodeBit(current->m_no_data[i], 1);
+        if (real != pred) changed_layers[value->layer] = TRUE;
+        continue;
+      }
+      enc_layer->encodeBit(current->m_no_data[i], 0);
+    }
+    if (real != pred)
+    {
+      changed_layers[value->layer] = TRUE;
+      laszip_attribute_set(last_item + value->offset, size, real);
+    }
+    if (current->ic_values[i])
+    {
+      current->ic_values[i]->compress((I32)(U32)pred, (I32)(U32)real);
+    }
+    else
+    {
+      U64 zigzag = laszip_attribute_zigzag(size, laszip_attribute_order(value->kind, real) - laszip_attribute_order(value->kind, pred));
+      U32 b, n = laszip_attribute_significant_bytes(zigzag);
+      enc_layer->encodeSymbol(current->m_bytes[i], n);
+      for (b = 0; b < n; b++)
+      {
+        enc_layer->encodeSymbol(current->m_diff_bytes[16*i+2*b+(b+1 == n)], (U32)(zigzag >> (8*b)) & 0xFF);
+      }
+    }
+  }
+  return TRUE;
+}
+
+inline BOOL LASwriteItemAttributes::chunk_sizes()
+{
+  U32 i;
+  U32 num_bytes = 0;
+  ByteStreamOut* outstream = enc->getByteStreamOut();
+
+  // output the layout and the sizes of all layers (i.e.. number of bytes per layer)
+
+  outstream->put32bitsLE((U8*)&num_layers);
+
+  for (i = 0; i < num_layers; i++)
+  {
+    // finish the encoders
+    enc_layers[i]->done();
+
+    U8 layout[4] = { layers[i].kind, layers[i].count, (U8)(layers[i].has_no_data ? 1 : 0), 0 };
+    outstream->putBytes(layout, 4);
+    if (layers[i].has_no_data)
+    {
+      outstream->put64bitsLE((U8*)&(layers[i].no_data));
+    }
+
+    if (changed_layers[i])
+    {
+      num_bytes = (U32)outstream_layers[i]->getCurr();
+    }
+    else
+    {
+      num_bytes = 0;
+    }
+    outstream->put32bitsLE(((U8*)&num_bytes));
+  }
+
+  return TRUE;
+}
+
+inline BOOL LASwriteItemAttributes::chunk_bytes()
+{
+  U32 i;
+  U32 num_bytes = 0;
+  ByteStreamOut* outstream = enc->getByteStreamOut();
+
+  // output the bytes of all layers
+
+  for (i = 0; i < num_layers; i++)
+  {
+    if (changed_layers[i])
+    {
+      num_bytes = (U32)outstream_layers[i]->getCurr();
+      outstream->putBytes(outstream_layers[i]->getData(), num_bytes);
+    }
+  }
+
+  return TRUE;
+}
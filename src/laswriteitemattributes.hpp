@@ -0,0 +1,88 @@
+/*
+===============================================================================
+
+  FILE:  laswriteitemattributes.hpp
+
+  CONTENTS:
+
+    Writes the extra bytes of LAS 1.4 points attribute by attribute with a
+    layer per attribute (see laszip_common_attributes.hpp)
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- created to code typed extra bytes with whole values
+
+===============================================================================
+*/
+#ifndef LAS_WRITE_ITEM_ATTRIBUTES_HPP
+#define LAS_WRITE_ITEM_ATTRIBUTES_HPP
+
+#include "laswriteitem.hpp"
+#include "arithmeticencoder.hpp"
+#include "integercompressor.hpp"
+#include "bytestreamout_array.hpp"
+
+#include "laszip_common_attributes.hpp"
+
+class LASattribute;
+
+class LASwriteItemAttributes : public LASwriteItemCompressed
+{
+public:
+
+  LASwriteItemAttributes(ArithmeticEncoder* enc, U32 number, U32 num_attributes=0, const LASattributeLayer* attributes=0);
+
+  BOOL init(const U8* item, U32& context);
+  BOOL write(const U8* item, U32& context);
+  BOOL chunk_sizes();
+  BOOL chunk_bytes();
+
+  ~LASwriteItemAttributes();
+
+private:
+
+  /* not used as a encoder. just gives access to outstream */
+
+  ArithmeticEncoder* enc;
+
+  U32 number;
+
+  U32 num_layers;
+  LASattributeLayer* layers;
+
+  U32 num_values;
+  LASattributeValue* values;
+
+  ByteStreamOutArray** outstream_layers;
+
+  ArithmeticEncoder** enc_layers;
+
+  BOOL* changed_layers;
+
+  U32 current_context;
+  LAScontextATTRIBUTES contexts[4];
+
+  BOOL createAndInitModelsAndCompressors(U32 context, const U8* item);
+};
+
+// converts the descriptors of the "extra bytes" VLR into layers and returns
+// their number. descriptors without a size (reserved) end the conversion
+
+U32 laszip_attribute_layers(const U32 num_attributes, const LASattribute* attributes, LASattributeLayer* layers);
+
+#endif
@@ -0,0 +1,239 @@
+/*
+===============================================================================
+
+  FILE:  laswriteitembitpacked.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include "laswriteitembitpacked.hpp"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+static inline U32 laszip_bitpacked_bits(U64 range)
+{
+  U32 bits = 0;
+  while (range)
+  {
+    bits++;
+    range >>= 1;
+  }
+  return bits;
+}
+
+LASwriteItemBitpacked::LASwriteItemBitpacked(ArithmeticEncoder* enc, const LASitem& item)
+{
+  /* not used as an encoder. just gives access to outstream */
+
+  assert(enc);
+  this->enc = enc;
+
+  /* which fields the item has */
+
+  fields = new LASbitpackedField[item.size];
+  num_fields = laszip_bitpacked_fields(item, fields);
+  record_size = laszip_bitpacked_record_size(fields, num_fields);
+
+  if (IS_LITTLE_ENDIAN())
+  {
+    outstream_packed = new ByteStreamOutArrayLE();
+  }
+  else
+  {
+    outstream_packed = new ByteStreamOutArrayBE();
+  }
+
+  items = 0;
+  num_items = 0;
+  num_items_allocated = 0;
+}
+
+LASwriteItemBitpacked::~LASwriteItemBitpacked()
+{
+  delete [] fields;
+  delete outstream_packed;
+  if (items) free(items);
+}
+
+inline BOOL LASwriteItemBitpacked::add(const U8* item)
+{
+  if (num_items == num_items_allocated)
+  {
+    U32 num_items_new = (num_items_allocated ? 2*num_items_allocated : 1024);
+    U8* items_new = (U8*)realloc(items, (size_t)num_items_new*record_size);
+    if (items_new == 0)
+    {
+      return FALSE;
+    }
+    items = items_new;
+    num_items_allocated = num_items_new;
+  }
+  memcpy(items + (size_t)num_items*record_size, item, record_size);
+  num_items++;
+  return TRUE;
+}
+
+BOOL LASwriteItemBitpacked::init(const U8* item, U32& context)
+{
+  /* start packing a new chunk */
+
+  outstream_packed->seek(0);
+
+  /* the first item of the chunk is stored raw and is what the differences start from */
+
+  num_items = 0;
+  return add(item);
+}
+
+inline BOOL LASwriteItemBitpacked::write(const U8* item, U32& context)
+{
+  return add(item);
+}
+
+void LASwriteItemBitpacked::pack_block(const U64* values, const U32 number, const U64 base, const U32 bits, const U32 width, const U8 flags)
+{
+  U8 bytes[LASZIP_BITPACKED_BLOCK_SIZE*8+8];
+  U32 i, num_bytes;
+
+  // header byte and base
+
+  outstream_packed->putByte((U8)(bits | flags));
+  for (i = 0; i < width; i++)
+  {
+    outstream_packed->putByte((U8)(base >> (8*i)));
+  }
+
+  // little-endian bit stream of (value - base)
+
+  if (bits)
+  {
+    U64 acc = 0;
+    U32 fill = 0;
+    num_bytes = 0;
+    for (i = 0; i < number; i++)
+    {
+      U64 value = values[i] - base;
+      acc |= (value << fill);
+      if ((fill + bits) >= 64)
+      {
+        laszip_bitpacked_store64(bytes + num_bytes, acc);
+        num_bytes += 8;
+        acc = (fill ? (value >> (64 - fill)) : 0);
+        fill = fill + bits - 64;
+      }
+      else
+      {
+        fill += bits;
+      }
+    }
+    laszip_bitpacked_store64(bytes + num_bytes, acc);
+    num_bytes += (fill + 7) / 8;
+    outstream_packed->putBytes(bytes, num_bytes);
+  }
+}
+
+void LASwriteItemBitpacked::pack_field(const LASbitpackedField* field)
+{
+  U64 raw[LASZIP_BITPACKED_BLOCK_SIZE];
+  U64 delta[LASZIP_BITPACKED_BLOCK_SIZE];
+  const U32 width = field->width;
+  const U32 shift = 64 - 8*width;
+  const U64 mask = laszip_bitpacked_mask(width);
+  const U8* item = items + field->offset;
+  const U64 keep = field->keep;
+  U64 last = laszip_bitpacked_get(item, width) & keep;
+  U32 i, start, number;
+
+  for (start = 1; start < num_items; start += LASZIP_BITPACKED_BLOCK_SIZE)
+  {
+    number = num_items - start;
+    if (number > LASZIP_BITPACKED_BLOCK_SIZE) number = LASZIP_BITPACKED_BLOCK_SIZE;
+
+    U64 raw_min = (U64)-1, raw_max = 0;
+    U64 delta_min = (U64)-1, delta_max = 0;
+    for (i = 0; i < number; i++)
+    {
+      U64 value = laszip_bitpacked_get(item + (size_t)(start+i)*record_size, width) & keep;
+      // difference in the width of the field, sign-extended and zigzagged
+      I64 diff = ((I64)(((value - last) & mask) << shift)) >> shift;
+      U64 zigzag = ((((U64)diff) << 1) ^ ((U64)(diff >> 63))) & mask;
+      raw[i] = value;
+      delta[i] = zigzag;
+      if (value < raw_min) raw_min = value;
+      if (value > raw_max) raw_max = value;
+      if (zigzag < delta_min) delta_min = zigzag;
+      if (zigzag > delta_max) delta_max = zigzag;
+      last = value;
+    }
+
+    // use the differences only if they need fewer bits
+
+    U32 raw_bits = laszip_bitpacked_bits(raw_max - raw_min);
+    U32 delta_bits = laszip_bitpacked_bits(delta_max - delta_min);
+    if (delta_bits < raw_bits)
+    {
+      pack_block(delta, number, delta_min, delta_bits, width, LASZIP_BITPACKED_DELTA);
+    }
+    else
+    {
+      pack_block(raw, number, raw_min, raw_bits, width, 0);
+    }
+  }
+}
+
+BOOL LASwriteItemBitpacked::chunk_sizes()
+{
+  U32 i;
+  ByteStreamOut* outstream = enc->getByteStreamOut();
+
+  // pack all fields of the chunk one after the other
+
+  for (i = 0; i < num_fields; i++)
+  {
+    pack_field(&fields[i]);
+  }
+
+  // output the number of packed bytes
+
+  U32 num_bytes = (U32)outstream_packed->getCurr();
+  outstream->put32bitsLE(((U8*)&num_bytes));
+
+  return TRUE;
+}
+
+BOOL LASwriteItemBitpacked::chunk_bytes()
+{
+  ByteStreamOut* outstream = enc->getByteStreamOut();
+
+  // output the packed bytes
+
+  U32 num_bytes = (U32)outstream_packed->getCurr();
+  outstream->putBytes(outstream_packed->getData(), num_bytes);
+
+  return TRUE;
+}
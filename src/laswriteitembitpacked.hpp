@@ -0,0 +1,79 @@
+/*
+===============================================================================
+
+  FILE:  laswriteitembitpacked.hpp
+
+  CONTENTS:
+
+    Writes any item as per-field blocks of frame-of-reference bit-packed values
+    that decode close to the speed of memcpy (see laszip_common_bitpacked.hpp)
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- stores only the bits of a field that the reader cannot derive
+    16 October 2026 -- created for the bit-packed compressor of the hot storage tier
+
+===============================================================================
+*/
+#ifndef LAS_WRITE_ITEM_BITPACKED_HPP
+#define LAS_WRITE_ITEM_BITPACKED_HPP
+
+#include "laswriteitem.hpp"
+#include "arithmeticencoder.hpp"
+#include "bytestreamout_array.hpp"
+
+#include "laszip_common_bitpacked.hpp"
+
+class LASwriteItemBitpacked : public LASwriteItemCompressed
+{
+public:
+
+  LASwriteItemBitpacked(ArithmeticEncoder* enc, const LASitem& item);
+
+  BOOL init(const U8* item, U32& context);
+  BOOL write(const U8* item, U32& context);
+
+  BOOL chunk_sizes();
+  BOOL chunk_bytes();
+
+  ~LASwriteItemBitpacked();
+
+private:
+
+  BOOL add(const U8* item);
+  void pack_field(const LASbitpackedField* field);
+  void pack_block(const U64* values, const U32 number, const U64 base, const U32 bits, const U32 width, const U8 flags);
+
+  /* not used as an encoder. just gives access to outstream */
+
+  ArithmeticEncoder* enc;
+
+  ByteStreamOutArray* outstream_packed;
+
+  U32 num_fields;
+  LASbitpackedField* fields;
+  U32 record_size;
+
+  // the items of the current chunk (the first one came with init())
+
+  U8* items;
+  U32 num_items;
+  U32 num_items_allocated;
+};
+
+#endif
@@ -30,6 +30,8 @@
 */
 
 #include "laswriteitemcompressed_v2.hpp"
+#include "laswriteitemsfused.hpp"
+#include "laszip.hpp"
 
 #include <cassert>
 #include <string.h>
@@ -66,19 +68,19 @@ LASwriteItemCompressed_POINT10_v2::LASwriteItemCompressed_POINT10_v2(ArithmeticE
 
   /* create models and integer compressors */
   m_changed_values = enc->createSymbolModel(64);
-  ic_intensity = new IntegerCompressor(enc, 16, 4);
+  ic_intensity = new IntegerCompressorFixed<16>(enc, 4);
   m_scan_angle_rank[0] = enc->createSymbolModel(256);
   m_scan_angle_rank[1] = enc->createSymbolModel(256);
-  ic_point_source_ID = new IntegerCompressor(enc, 16);
+  ic_point_source_ID = new IntegerCompressorFixed<16>(enc);
   for (i = 0; i < 256; i++)
   {
     m_bit_byte[i] = 0;
     m_classification[i] = 0;
     m_user_data[i] = 0;
   }
-  ic_dx = new IntegerCompressor(enc, 32, 2);  // 32 bits, 2 context
-  ic_dy = new IntegerCompressor(enc, 32, 22); // 32 bits, 22 contexts
-  ic_z = new IntegerCompressor(enc, 32, 20);  // 32 bits, 20 contexts
+  ic_dx = new IntegerCompressorFixed<32>(enc, 2);  // 32 bits, 2 context
+  ic_dy = new IntegerCompressorFixed<32>(enc, 22); // 32 bits, 22 contexts
+  ic_z = new IntegerCompressorFixed<32>(enc, 20);  // 32 bits, 20 contexts
 }
 
 LASwriteItemCompressed_POINT10_v2::~LASwriteItemCompressed_POINT10_v2()
@@ -251,7 +253,7 @@ LASwriteItemCompressed_GPSTIME11_v2::LASwriteItemCompressed_GPSTIME11_v2(Arithme
   /* create entropy models and integer compressors */
   m_gpstime_multi = enc->createSymbolModel(LASZIP_GPSTIME_MULTI_TOTAL);
   m_gpstime_0diff = enc->createSymbolModel(6);
-  ic_gpstime = new IntegerCompressor(enc, 32, 9); // 32 bits, 9 contexts
+  ic_gpstime = new IntegerCompressorFixed<32>(enc, 9); // 32 bits, 9 contexts
 
   last = 0;
 }
@@ -621,3 +623,50 @@ inline BOOL LASwriteItemCompressed_BYTE_v2::write(const U8* item, U32& context)
   return TRUE;
 }
 
+// the standard point types 0 to 3 (with or without extra bytes)
+
+typedef LASwriteItemsFusedList<LASwriteItemCompressed_BYTE_v2, LASwriteItemsFusedEnd> LASwriteItemsFused_BYTE_v2;
+
+template <class TAIL>
+static LASwriteItemsFused* laszip_fuse_writers_v2(const U32 num_items, const LASitem* items, LASwriteItem** writers)
+{
+  typedef LASwriteItemsFusedList<LASwriteItemCompressed_RGB12_v2, TAIL> RGB12_TAIL;
+  typedef LASwriteItemsFusedList<LASwriteItemCompressed_GPSTIME11_v2, TAIL> GPSTIME11_TAIL;
+  typedef LASwriteItemsFusedList<LASwriteItemCompressed_GPSTIME11_v2, RGB12_TAIL> GPSTIME11_RGB12_TAIL;
+
+  if (num_items == 1)
+  {
+    return new LASwriteItemsFusedTemplate< LASwriteItemsFusedList<LASwriteItemCompressed_POINT10_v2, TAIL> >(writers);
+  }
+  else if ((num_items == 2) && (items[1].type == LASitem::GPSTIME11))
+  {
+    return new LASwriteItemsFusedTemplate< LASwriteItemsFusedList<LASwriteItemCompressed_POINT10_v2, GPSTIME11_TAIL> >(writers);
+  }
+  else if ((num_items == 2) && (items[1].type == LASitem::RGB12))
+  {
+    return new LASwriteItemsFusedTemplate< LASwriteItemsFusedList<LASwriteItemCompressed_POINT10_v2, RGB12_TAIL> >(writers);
+  }
+  else if ((num_items == 3) && (items[1].type == LASitem::GPSTIME11) && (items[2].type == LASitem::RGB12))
+  {
+    return new LASwriteItemsFusedTemplate< LASwriteItemsFusedList<LASwriteItemCompressed_POINT10_v2, GPSTIME11_RGB12_TAIL> >(writers);
+  }
+  return 0;
+}
+
+LASwriteItemsFused* laszip_fuse_writers_v2(const U32 num_items, const LASitem* items, LASwriteItem** writers)
+{
+  U32 i;
+  for (i = 0; i < num_items; i++)
+  {
+    if (items[i].version != 2) return 0;
+  }
+  if ((num_items == 0) || (items[0].type != LASitem::POINT10))
+  {
+    return 0;
+  }
+  if ((num_items > 1) && (items[num_items-1].type == LASitem::BYTE))
+  {
+    return laszip_fuse_writers_v2<LASwriteItemsFused_BYTE_v2>(num_items-1, items, writers);
+  }
+  return laszip_fuse_writers_v2<LASwriteItemsFusedEnd>(num_items, items, writers);
+}
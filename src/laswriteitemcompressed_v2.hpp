@@ -24,6 +24,8 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- fused writing of the items of the point types 0 to 3
+    16 October 2026 -- integer compressors with the number of bits fixed at compile time
     28 August 2017 -- moving 'context' from global development hack to interface  
     6 September 2014 -- removed inheritance of EntropyEncoder and EntropyDecoder
     5 March 2011 -- created first night in ibiza to improve the RGB compressor
@@ -39,6 +41,9 @@
 
 #include "laszip_common_v2.hpp"
 
+class LASitem;
+class LASwriteItemsFused;
+
 class LASwriteItemCompressed_POINT10_v2 : public LASwriteItemCompressed
 {
 public:
@@ -59,15 +64,15 @@ private:
   I32 last_height[8] = {0};
 
   ArithmeticModel* m_changed_values;
-  IntegerCompressor* ic_intensity;
+  IntegerCompressorFixed<16>* ic_intensity;
   ArithmeticModel* m_scan_angle_rank[2];
-  IntegerCompressor* ic_point_source_ID;
+  IntegerCompressorFixed<16>* ic_point_source_ID;
   ArithmeticModel* m_bit_byte[256];
   ArithmeticModel* m_classification[256];
   ArithmeticModel* m_user_data[256];
-  IntegerCompressor* ic_dx;
-  IntegerCompressor* ic_dy;
-  IntegerCompressor* ic_z;
+  IntegerCompressorFixed<32>* ic_dx;
+  IntegerCompressorFixed<32>* ic_dy;
+  IntegerCompressorFixed<32>* ic_z;
 };
 
 class LASwriteItemCompressed_GPSTIME11_v2 : public LASwriteItemCompressed
@@ -90,7 +95,7 @@ private:
 
   ArithmeticModel* m_gpstime_multi;
   ArithmeticModel* m_gpstime_0diff;
-  IntegerCompressor* ic_gpstime;
+  IntegerCompressorFixed<32>* ic_gpstime;
 };
 
 class LASwriteItemCompressed_RGB12_v2 : public LASwriteItemCompressed
@@ -136,4 +141,9 @@ private:
   ArithmeticModel** m_byte;
 };
 
+// one writer for all items of the point types 0 to 3 (with or without extra
+// bytes) that were created as version 2 writers or 0 for any other items
+
+LASwriteItemsFused* laszip_fuse_writers_v2(const U32 num_items, const LASitem* items, LASwriteItem** writers);
+
 #endif
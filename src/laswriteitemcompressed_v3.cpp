@@ -30,6 +30,8 @@
 */
 
 #include "laswriteitemcompressed_v3.hpp"
+#include "laswriteitemsfused.hpp"
+#include "laszip.hpp"
 #include "lasmessage.hpp"
 
 #include <cassert>
@@ -247,12 +249,12 @@ inline BOOL LASwriteItemCompressed_POINT14_v3::createAndInitModelsAndCompressors
     }
     contexts[context].m_return_number_gps_same = enc_channel_returns_XY->createSymbolModel(13);
 
-    contexts[context].ic_dX = new IntegerCompressor(enc_channel_returns_XY, 32, 2);  // 32 bits, 2 context
-    contexts[context].ic_dY = new IntegerCompressor(enc_channel_returns_XY, 32, 22); // 32 bits, 22 contexts
+    contexts[context].ic_dX = new IntegerCompressorFixed<32>(enc_channel_returns_XY, 2);  // 32 bits, 2 context
+    contexts[context].ic_dY = new IntegerCompressorFixed<32>(enc_channel_returns_XY, 22); // 32 bits, 22 contexts
 
     /* for the Z layer */
 
-    contexts[context].ic_Z = new IntegerCompressor(enc_Z, 32, 20);  // 32 bits, 20 contexts
+    contexts[context].ic_Z = new IntegerCompressorFixed<32>(enc_Z, 20);  // 32 bits, 20 contexts
 
     /* for the classification layer */
     /* for the flags layer */
@@ -267,21 +269,21 @@ inline BOOL LASwriteItemCompressed_POINT14_v3::createAndInitModelsAndCompressors
 
     /* for the intensity layer */
 
-    contexts[context].ic_intensity = new IntegerCompressor(enc_intensity, 16, 4);
+    contexts[context].ic_intensity = new IntegerCompressorFixed<16>(enc_intensity, 4);
 
     /* for the scan_angle layer */
 
-    contexts[context].ic_scan_angle = new IntegerCompressor(enc_scan_angle, 16, 2);
+    contexts[context].ic_scan_angle = new IntegerCompressorFixed<16>(enc_scan_angle, 2);
 
     /* for the point_source_ID layer */
 
-    contexts[context].ic_point_source_ID = new IntegerCompressor(enc_point_source, 16);
+    contexts[context].ic_point_source_ID = new IntegerCompressorFixed<16>(enc_point_source);
 
     /* for the gps_time layer */
 
     contexts[context].m_gpstime_multi = enc_gps_time->createSymbolModel(LASZIP_GPSTIME_MULTI_TOTAL);
     contexts[context].m_gpstime_0diff = enc_gps_time->createSymbolModel(5);
-    contexts[context].ic_gpstime = new IntegerCompressor(enc_gps_time, 32, 9); // 32 bits, 9 contexts
+    contexts[context].ic_gpstime = new IntegerCompressorFixed<32>(enc_gps_time, 9); // 32 bits, 9 contexts
   }
 
   /* then init entropy models and integer compressors */
@@ -408,15 +410,15 @@ BOOL LASwriteItemCompressed_POINT14_v3::init(const U8* item, U32& context)
 
     /* create layer encoders */
 
-    enc_channel_returns_XY = new ArithmeticEncoder();
-    enc_Z = new ArithmeticEncoder();
-    enc_classification = new ArithmeticEncoder();
-    enc_flags = new ArithmeticEncoder();
-    enc_intensity = new ArithmeticEncoder();
-    enc_scan_angle = new ArithmeticEncoder();
-    enc_user_data = new ArithmeticEncoder();
-    enc_point_source = new ArithmeticEncoder();
-    enc_gps_time = new ArithmeticEncoder();
+    enc_channel_returns_XY = new ArithmeticEncoder(enc->getCoder());
+    enc_Z = new ArithmeticEncoder(enc->getCoder());
+    enc_classification = new ArithmeticEncoder(enc->getCoder());
+    enc_flags = new ArithmeticEncoder(enc->getCoder());
+    enc_intensity = new ArithmeticEncoder(enc->getCoder());
+    enc_scan_angle = new ArithmeticEncoder(enc->getCoder());
+    enc_user_data = new ArithmeticEncoder(enc->getCoder());
+    enc_point_source = new ArithmeticEncoder(enc->getCoder());
+    enc_gps_time = new ArithmeticEncoder(enc->getCoder());
   }
   else
   {
@@ -1238,7 +1240,7 @@ BOOL LASwriteItemCompressed_RGB14_v3::init(const U8* item, U32& context)
 
     /* create layer encoders */
 
-    enc_RGB = new ArithmeticEncoder();
+    enc_RGB = new ArithmeticEncoder(enc->getCoder());
   }
   else
   {
@@ -1531,8 +1533,8 @@ BOOL LASwriteItemCompressed_RGBNIR14_v3::init(const U8* item, U32& context)
 
     /* create layer encoders */
 
-    enc_RGB = new ArithmeticEncoder();
-    enc_NIR = new ArithmeticEncoder();
+    enc_RGB = new ArithmeticEncoder(enc->getCoder());
+    enc_NIR = new ArithmeticEncoder(enc->getCoder());
   }
   else
   {
@@ -1860,7 +1862,7 @@ BOOL LASwriteItemCompressed_WAVEPACKET14_v3::init(const U8* item, U32& context)
 
     /* create layer encoders */
 
-    enc_wavepacket = new ArithmeticEncoder();
+    enc_wavepacket = new ArithmeticEncoder(enc->getCoder());
   }
   else
   {
@@ -2176,7 +2178,7 @@ BOOL LASwriteItemCompressed_BYTE14_v3::init(const U8* item, U32& context)
 
     for (i = 0; i < number; i++)
     {
-      enc_Bytes[i] = new ArithmeticEncoder();
+      enc_Bytes[i] = new ArithmeticEncoder(enc->getCoder());
     }
   }
   else
@@ -2308,3 +2310,46 @@ inline BOOL LASwriteItemCompressed_BYTE14_v3::chunk_bytes()
 
   return TRUE;
 }
+
+// the standard point types 6 to 8 (with or without extra bytes)
+
+typedef LASwriteItemsFusedList<LASwriteItemCompressed_BYTE14_v3, LASwriteItemsFusedEnd> LASwriteItemsFused_BYTE14_v3;
+
+template <class TAIL>
+static LASwriteItemsFused* laszip_fuse_writers_v3(const U32 num_items, const LASitem* items, LASwriteItem** writers)
+{
+  typedef LASwriteItemsFusedList<LASwriteItemCompressed_RGB14_v3, TAIL> RGB14_TAIL;
+  typedef LASwriteItemsFusedList<LASwriteItemCompressed_RGBNIR14_v3, TAIL> RGBNIR14_TAIL;
+
+  if (num_items == 1)
+  {
+    return new LASwriteItemsFusedTemplate< LASwriteItemsFusedList<LASwriteItemCompressed_POINT14_v3, TAIL> >(writers);
+  }
+  else if ((num_items == 2) && (items[1].type == LASitem::RGB14))
+  {
+    return new LASwriteItemsFusedTemplate< LASwriteItemsFusedList<LASwriteItemCompressed_POINT14_v3, RGB14_TAIL> >(writers);
+  }
+  else if ((num_items == 2) && (items[1].type == LASitem::RGBNIR14))
+  {
+    return new LASwriteItemsFusedTemplate< LASwriteItemsFusedList<LASwriteItemCompressed_POINT14_v3, RGBNIR14_TAIL> >(writers);
+  }
+  return 0;
+}
+
+LASwriteItemsFused* laszip_fuse_writers_v3(const U32 num_items, const LASitem* items, LASwriteItem** writers)
+{
+  U32 i;
+  for (i = 0; i < num_items; i++)
+  {
+    if (items[i].version != 3) return 0;
+  }
+  if ((num_items == 0) || (items[0].type != LASitem::POINT14))
+  {
+    return 0;
+  }
+  if ((num_items > 1) && (items[num_items-1].type == LASitem::BYTE14))
+  {
+    return laszip_fuse_writers_v3<LASwriteItemsFused_BYTE14_v3>(num_items-1, items, writers);
+  }
+  return laszip_fuse_writers_v3<LASwriteItemsFusedEnd>(num_items, items, writers);
+}
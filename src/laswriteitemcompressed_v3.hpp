@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- fused writing of the items of the point types 6 to 8
     28 August 2017 -- moving 'context' from global development hack to interface  
     22 August 2016 -- finalizing at Basecamp in Bonn during FOSS4g hackfest
     23 February 2016 -- created at OSGeo Code Sprint in Paris to prototype
@@ -40,6 +41,9 @@
 
 #include "laszip_common_v3.hpp"
 
+class LASitem;
+class LASwriteItemsFused;
+
 class LASwriteItemCompressed_POINT14_v3 : public LASwriteItemCompressed
 {
 public:
@@ -241,4 +245,9 @@ private:
   BOOL createAndInitModelsAndCompressors(U32 context, const U8* item);
 };
 
+// one writer for all items of the point types 6 to 8 (with or without extra
+// bytes) that were created as version 3 writers or 0 for any other items
+
+LASwriteItemsFused* laszip_fuse_writers_v3(const U32 num_items, const LASitem* items, LASwriteItem** writers);
+
 #endif
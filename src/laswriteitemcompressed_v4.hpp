@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- fused writing of the items of the point types 6 to 8
     28 December 2017 -- fix incorrect 'context switch' reported by Wanwannodao 
     28 August 2017 -- moving 'context' from global development hack to interface  
     22 August 2016 -- finalizing at Basecamp in Bonn during FOSS4g hackfest
@@ -41,6 +42,9 @@
 
 #include "laszip_common_v3.hpp"
 
+class LASitem;
+class LASwriteItemsFused;
+
 class LASwriteItemCompressed_POINT14_v4 : public LASwriteItemCompressed
 {
 public:
@@ -242,4 +246,9 @@ private:
   BOOL createAndInitModelsAndCompressors(U32 context, const U8* item);
 };
 
+// one writer for all items of the point types 6 to 8 (with or without extra
+// bytes) that were created as version 4 writers or 0 for any other items
+
+LASwriteItemsFused* laszip_fuse_writers_v4(const U32 num_items, const LASitem* items, LASwriteItem** writers);
+
 #endif
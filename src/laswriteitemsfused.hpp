@@ -0,0 +1,114 @@
+/*
+===============================================================================
+
+  FILE:  laswriteitemsfused.hpp
+
+  CONTENTS:
+
+    Writes all items of the points of a standard point type in one call. The
+    item writers are chained at compile time into a list whose write() calls
+    the write() of each item non-virtually, so that the compiler may inline
+    them into one loop body. There is one virtual call per point (or per
+    chunk) instead of one per item. The list must be instantiated where the
+    write() functions of its items are defined (they are 'inline' there),
+    which is why each laswriteitemcompressed_v*.cpp has its own factory. It
+    is the counterpart of lasreaditemsfused.hpp.
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- created to write standard point types without a virtual call per item
+
+===============================================================================
+*/
+#ifndef LAS_WRITE_ITEMS_FUSED_HPP
+#define LAS_WRITE_ITEMS_FUSED_HPP
+
+#include "laswriteitem.hpp"
+
+class LASwriteItemsFused
+{
+public:
+  // writes one point whose items are at 'point[0]', 'point[1]', ...
+  virtual BOOL write(const U8 * const * point, U32& context)=0;
+  // writes 'number' points of 'point_size' bytes each starting at 'points'
+  virtual BOOL write(const U8* points, const U32 number, const U32 point_size, const U32* item_offsets)=0;
+
+  virtual ~LASwriteItemsFused(){};
+};
+
+// the end of a list of item writers
+
+class LASwriteItemsFusedEnd
+{
+public:
+  LASwriteItemsFusedEnd(LASwriteItem** writers) {};
+  inline BOOL write(const U8 * const * point, U32& context) { return TRUE; };
+  inline BOOL write(const U8* point, const U32* item_offsets, U32& context) { return TRUE; };
+};
+
+// the writer of type W for the next item followed by the list for the remaining items
+
+template <class W, class NEXT>
+class LASwriteItemsFusedList
+{
+public:
+  LASwriteItemsFusedList(LASwriteItem** writers) : writer((W*)writers[0]), next(writers + 1) {};
+  inline BOOL write(const U8 * const * point, U32& context)
+  {
+    if (!writer->W::write(point[0], context)) return FALSE;
+    return next.write(point + 1, context);
+  };
+  inline BOOL write(const U8* point, const U32* item_offsets, U32& context)
+  {
+    if (!writer->W::write(point + item_offsets[0], context)) return FALSE;
+    return next.write(point, item_offsets + 1, context);
+  };
+private:
+  W* writer;
+  NEXT next;
+};
+
+template <class LIST>
+class LASwriteItemsFusedTemplate : public LASwriteItemsFused
+{
+public:
+  LASwriteItemsFusedTemplate(LASwriteItem** writers) : list(writers) {};
+
+  BOOL write(const U8 * const * point, U32& context)
+  {
+    return list.write(point, context);
+  };
+
+  BOOL write(const U8* points, const U32 number, const U32 point_size, const U32* item_offsets)
+  {
+    U32 j;
+    U32 context;
+    for (j = 0; j < number; j++)
+    {
+      context = 0;
+      if (!list.write(points, item_offsets, context)) return FALSE;
+      points += point_size;
+    }
+    return TRUE;
+  };
+
+private:
+  LIST list;
+};
+
+#endif
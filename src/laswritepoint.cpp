@@ -32,16 +32,23 @@
 #include "laswritepoint.hpp"
 
 #include "arithmeticencoder.hpp"
+#include "bytestreamout_array.hpp"
 #include "laswriteitemraw.hpp"
 #include "laswriteitemcompressed_v1.hpp"
 #include "laswriteitemcompressed_v2.hpp"
 #include "laswriteitemcompressed_v3.hpp"
 #include "laswriteitemcompressed_v4.hpp"
+#include "laswriteitembitpacked.hpp"
+#include "laswriteitemattributes.hpp"
+#include "laswriteitemsfused.hpp"
+#include "lasthreadpool.hpp"
 
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 
+#include <thread>
+
 LASwritePoint::LASwritePoint()
 {
   outstream = 0;
@@ -49,8 +56,11 @@ LASwritePoint::LASwritePoint()
   writers = 0;
   writers_raw = 0;
   writers_compressed = 0;
+  fused = 0;
   enc = 0;
   layered_las14_compression = FALSE;
+  num_attributes = 0;
+  attributes = 0;
   // used for chunking
   chunk_size = U32_MAX;
   chunk_count = 0;
@@ -60,6 +70,45 @@ LASwritePoint::LASwritePoint()
   chunk_bytes = 0;
   chunk_table_start_position = 0;
   chunk_start_position = 0;
+  // used for parallel compression of chunks
+  num_threads = 0;
+  workers = 0;
+  pool = 0;
+  item_offsets = 0;
+  item_footprints = 0;
+  buffered_point_size = 0;
+  batch_points = 0;
+  batch_points_allocated = 0;
+  batch_sizes = 0;
+  batch_valid = 0;
+  batch_count = 0;
+  chunk_stream = 0;
+  chunk_point = 0;
+}
+
+BOOL LASwritePoint::set_threads(const U32 num_threads)
+{
+  if (num_writers) return FALSE; // too late
+  // one thread per core but not more than 8 (as for the layers)
+  U32 max_threads = std::thread::hardware_concurrency();
+  if ((max_threads == 0) || (max_threads > 8)) max_threads = 8;
+  this->num_threads = (num_threads < max_threads ? num_threads : max_threads);
+  if (this->num_threads < 2) this->num_threads = 0;
+  return TRUE;
+}
+
+BOOL LASwritePoint::set_attributes(const U32 num_attributes, const LASattribute* attributes)
+{
+  if (num_writers) return FALSE; // too late
+  if (this->attributes) delete [] this->attributes;
+  this->attributes = 0;
+  this->num_attributes = 0;
+  if (num_attributes)
+  {
+    this->attributes = new LASattributeLayer[num_attributes];
+    this->num_attributes = laszip_attribute_layers(num_attributes, attributes, this->attributes);
+  }
+  return TRUE;
 }
 
 BOOL LASwritePoint::setup(const U32 num_items, const LASitem* items, const LASzip* laszip)
@@ -82,7 +131,8 @@ BOOL LASwritePoint::setup(const U32 num_items, const LASitem* items, const LASzi
     switch (laszip->coder)
     {
     case LASZIP_CODER_ARITHMETIC:
-      enc = new ArithmeticEncoder();
+    case LASZIP_CODER_ARITHMETIC_TWO_PASS:
+      enc = new ArithmeticEncoder(laszip->coder);
       break;
     default:
       // entropy decoder not supported
@@ -90,6 +140,8 @@ BOOL LASwritePoint::setup(const U32 num_items, const LASitem* items, const LASzi
     }
     // maybe layered compression for LAS 1.4 
     layered_las14_compression = (laszip->compressor == LASZIP_COMPRESSOR_LAYERED_CHUNKED);
+    // bit-packed compression writes its chunks the same way as layered compression
+    if (laszip->compressor == LASZIP_COMPRESSOR_BITPACKED_CHUNKED) layered_las14_compression = TRUE;
   }
 
   // initizalize the writers
@@ -160,7 +212,11 @@ BOOL LASwritePoint::setup(const U32 num_items, const LASitem* items, const LASzi
     memset(writers_compressed, 0, num_writers*sizeof(LASwriteItem*));
     for (i = 0; i < num_writers; i++)
     {
-      switch (items[i].type)
+      if (laszip->compressor == LASZIP_COMPRESSOR_BITPACKED_CHUNKED)
+      {
+        writers_compressed[i] = new LASwriteItemBitpacked(enc, items[i]);
+      }
+      else switch (items[i].type)
       {
       case LASitem::POINT10:
         if (items[i].version == 1)
@@ -223,6 +279,8 @@ BOOL LASwritePoint::setup(const U32 num_items, const LASitem* items, const LASzi
           writers_compressed[i] = new LASwriteItemCompressed_BYTE14_v3(enc, items[i].size);
         else if (items[i].version == 4)
           writers_compressed[i] = new LASwriteItemCompressed_BYTE14_v4(enc, items[i].size);
+        else if (items[i].version == LASZIP_BYTE14_VERSION_ATTRIBUTES)
+          writers_compressed[i] = new LASwriteItemAttributes(enc, items[i].size, num_attributes, attributes);
         else
           return FALSE;
         break;
@@ -244,11 +302,78 @@ BOOL LASwritePoint::setup(const U32 num_items, const LASitem* items, const LASzi
         return FALSE;
       }
     }
+    // the items of standard point types are written without a virtual call per item
+    if (fused)
+    {
+      delete fused;
+      fused = 0;
+    }
+    if (laszip->compressor != LASZIP_COMPRESSOR_BITPACKED_CHUNKED)
+    {
+      fused = laszip_fuse_writers_v2(num_writers, items, writers_compressed);
+      if (fused == 0) fused = laszip_fuse_writers_v3(num_writers, items, writers_compressed);
+      if (fused == 0) fused = laszip_fuse_writers_v4(num_writers, items, writers_compressed);
+    }
     if (laszip->compressor != LASZIP_COMPRESSOR_POINTWISE)
     {
       if (laszip->chunk_size) chunk_size = laszip->chunk_size;
       chunk_count = 0;
       number_chunks = U32_MAX;
+      // static models encode each chunk twice so it needs to be buffered by a
+      // worker (but workers themselves have a chunk_stream and no workers)
+      if (enc->hasStaticModels() && (num_threads == 0) && (chunk_stream == 0)) num_threads = 1;
+      // create one worker per thread that compresses entire chunks into memory
+      if (num_threads)
+      {
+        // where each item is placed in a buffered point (same as in LASreadPoint)
+        item_offsets = new U32[num_writers];
+        item_footprints = new U32[num_writers];
+        buffered_point_size = 0;
+        for (i = 0; i < num_writers; i++)
+        {
+          item_offsets[i] = buffered_point_size;
+          item_footprints[i] = (items[i].type == LASitem::POINT14 ? LASZIP_POINT14_FOOTPRINT : items[i].size);
+          buffered_point_size += (layered_las14_compression ? 2*items[i].size : items[i].size);
+        }
+        workers = new LASwritePoint*[num_threads];
+        batch_points = new U8*[num_threads];
+        batch_points_allocated = new U32[num_threads];
+        batch_sizes = new U32[num_threads];
+        batch_valid = new BOOL[num_threads];
+        for (i = 0; i < num_threads; i++)
+        {
+          workers[i] = 0;
+          batch_points[i] = 0;
+          batch_points_allocated[i] = 0;
+          batch_sizes[i] = 0;
+          batch_valid[i] = FALSE;
+        }
+        for (i = 0; i < num_threads; i++)
+        {
+          workers[i] = new LASwritePoint();
+          if (IS_LITTLE_ENDIAN())
+            workers[i]->chunk_stream = new ByteStreamOutArrayLE();
+          else
+            workers[i]->chunk_stream = new ByteStreamOutArrayBE();
+          if (num_attributes)
+          {
+            workers[i]->num_attributes = num_attributes;
+            workers[i]->attributes = new LASattributeLayer[num_attributes];
+            memcpy(workers[i]->attributes, attributes, sizeof(LASattributeLayer)*num_attributes);
+          }
+          if (!workers[i]->setup(num_items, items, laszip))
+          {
+            return FALSE;
+          }
+          workers[i]->chunk_point = new const U8*[num_writers];
+          workers[i]->item_offsets = new U32[num_writers];
+          memcpy(workers[i]->item_offsets, item_offsets, sizeof(U32)*num_writers);
+          workers[i]->buffered_point_size = buffered_point_size;
+        }
+        // this thread compresses one chunk of each batch and the pool the others
+        pool = new LASthreadPool();
+        pool->start(num_threads - 1);
+      }
     }
   }
   return TRUE;
@@ -298,6 +423,36 @@ BOOL LASwritePoint::write(const U8 * const * point)
   U32 i;
   U32 context = 0;
 
+  if (workers)
+  {
+    if (chunk_count == chunk_size)
+    {
+      // this chunk is complete
+      batch_sizes[batch_count] = chunk_count;
+      batch_count++;
+      chunk_count = 0;
+      if (batch_count == num_threads)
+      {
+        if (!write_chunks()) return FALSE;
+      }
+    }
+    // buffer the point until its chunk gets compressed
+    if (batch_points_allocated[batch_count] == chunk_count)
+    {
+      U32 alloc = (chunk_size != U32_MAX ? chunk_size : (chunk_count ? 2*chunk_count : 1024));
+      batch_points[batch_count] = (U8*)realloc_las(batch_points[batch_count], (size_t)alloc*buffered_point_size);
+      if (batch_points[batch_count] == 0) return FALSE;
+      batch_points_allocated[batch_count] = alloc;
+    }
+    U8* buffered_point = batch_points[batch_count] + (size_t)chunk_count*buffered_point_size;
+    for (i = 0; i < num_writers; i++)
+    {
+      memcpy(buffered_point + item_offsets[i], point[i], item_footprints[i]);
+    }
+    chunk_count++;
+    return TRUE;
+  }
+
   if (chunk_count == chunk_size)
   {
     if (enc)
@@ -334,13 +489,23 @@ BOOL LASwritePoint::write(const U8 * const * point)
 
   if (writers)
   {
-    for (i = 0; i < num_writers; i++)
+    if (fused && (writers == writers_compressed))
     {
-      if (!writers[i]->write(point[i], context))
+      if (!fused->write(point, context))
       {
         return FALSE;
       }
     }
+    else
+    {
+      for (i = 0; i < num_writers; i++)
+      {
+        if (!writers[i]->write(point[i], context))
+        {
+          return FALSE;
+        }
+      }
+    }
   }
   else
   {
@@ -364,6 +529,20 @@ BOOL LASwritePoint::chunk()
   {
     return FALSE;
   }
+  if (workers)
+  {
+    if (chunk_count)
+    {
+      batch_sizes[batch_count] = chunk_count;
+      batch_count++;
+      chunk_count = 0;
+      if (batch_count == num_threads)
+      {
+        return write_chunks();
+      }
+    }
+    return TRUE;
+  }
   if (layered_las14_compression)
   {
     U32 i;
@@ -391,6 +570,21 @@ BOOL LASwritePoint::chunk()
 
 BOOL LASwritePoint::done()
 {
+  if (workers)
+  {
+    // compress and write what is still buffered
+    if (chunk_count)
+    {
+      batch_sizes[batch_count] = chunk_count;
+      batch_count++;
+      chunk_count = 0;
+    }
+    if (batch_count)
+    {
+      if (!write_chunks()) return FALSE;
+    }
+  }
+
   if (writers == writers_compressed)
   {
     if (layered_las14_compression)
@@ -486,15 +680,19 @@ BOOL LASwritePoint::write_chunk_table()
   }
   if (number_chunks > 0)
   {
-    enc->init(outstream);
-    IntegerCompressor ic(enc, 32, 2);
+    // the chunk table is written in one pass and never with static models. it
+    // has an encoder of its own so that its models are not kept in the arena of
+    // the encoder for the points
+    ArithmeticEncoder table_enc(LASZIP_CODER_ARITHMETIC);
+    table_enc.init(outstream);
+    IntegerCompressorFixed<32> ic(&table_enc, 2);
     ic.initCompressor();
     for (i = 0; i < number_chunks; i++)
     {
       if (chunk_size == U32_MAX) ic.compress((i ? chunk_sizes[i-1] : 0), chunk_sizes[i], 0);
       ic.compress((i ? chunk_bytes[i-1] : 0), chunk_bytes[i], 1);
     }
-    enc->done();
+    table_enc.done();
   }
   if (chunk_table_start_position == -1) // stream is not-seekable
   {
@@ -506,10 +704,131 @@ BOOL LASwritePoint::write_chunk_table()
   return TRUE;
 }
 
+BOOL LASwritePoint::write_chunks()
+{
+  U32 i;
+
+  // compress the chunks of the batch on the threads of the pool (and this one)
+  pool->run(batch_count, [this](U32 i) {
+    batch_valid[i] = workers[i]->compress_chunk(batch_points[i], batch_sizes[i]);
+  });
+
+  // write the compressed chunks in order
+  BOOL success = TRUE;
+  for (i = 0; i < batch_count; i++)
+  {
+    if (!batch_valid[i])
+    {
+      success = FALSE;
+      break;
+    }
+    if (!outstream->putBytes(workers[i]->chunk_stream->getData(), (U32)(workers[i]->chunk_stream->tell())))
+    {
+      success = FALSE;
+      break;
+    }
+    chunk_count = batch_sizes[i];
+    add_chunk_to_table();
+  }
+  chunk_count = 0;
+  batch_count = 0;
+  return success;
+}
+
+BOOL LASwritePoint::compress_chunk(const U8* points, const U32 num_points)
+{
+  U32 i, j, pass;
+  U32 context = 0;
+
+  // static models need a first pass that only counts (and gets overwritten)
+  for (pass = (enc->hasStaticModels() ? 0 : 1); pass < 2; pass++)
+  {
+    context = 0;
+    chunk_stream->seek(0);
+    for (i = 0; i < num_writers; i++)
+    {
+      chunk_point[i] = points + item_offsets[i];
+      ((LASwriteItemRaw*)(writers_raw[i]))->init(chunk_stream);
+    }
+    for (i = 0; i < num_writers; i++)
+    {
+      if (!writers_raw[i]->write(chunk_point[i], context))
+      {
+        return FALSE;
+      }
+      ((LASwriteItemCompressed*)(writers_compressed[i]))->init(chunk_point[i], context);
+    }
+    enc->init(chunk_stream);
+    if (fused)
+    {
+      if ((num_points > 1) && !fused->write(points + buffered_point_size, num_points - 1, buffered_point_size, item_offsets))
+      {
+        return FALSE;
+      }
+    }
+    else
+    {
+      for (j = 1; j < num_points; j++)
+      {
+        context = 0;
+        for (i = 0; i < num_writers; i++)
+        {
+          chunk_point[i] += buffered_point_size;
+          if (!writers_compressed[i]->write(chunk_point[i], context))
+          {
+            return FALSE;
+          }
+        }
+      }
+    }
+    if (layered_las14_compression)
+    {
+      // write how many points are in the chunk
+      U32 count = num_points;
+      chunk_stream->put32bitsLE((U8*)&count);
+      // write all layers 
+      for (i = 0; i < num_writers; i++)
+      {
+        ((LASwriteItemCompressed*)writers_compressed[i])->chunk_sizes();
+      }
+      for (i = 0; i < num_writers; i++)
+      {
+        ((LASwriteItemCompressed*)writers_compressed[i])->chunk_bytes();
+      }
+    }
+    else
+    {
+      enc->done();
+    }
+  }
+  return TRUE;
+}
+
 LASwritePoint::~LASwritePoint()
 {
   U32 i;
 
+  if (pool) delete pool;
+
+  if (workers)
+  {
+    for (i = 0; i < num_threads; i++)
+    {
+      if (workers[i]) delete workers[i];
+      if (batch_points[i]) free(batch_points[i]);
+    }
+    delete [] workers;
+    delete [] batch_points;
+    delete [] batch_points_allocated;
+    delete [] batch_sizes;
+    delete [] batch_valid;
+  }
+
+  if (item_offsets) delete [] item_offsets;
+  if (item_footprints) delete [] item_footprints;
+  if (chunk_stream) delete chunk_stream;
+  if (chunk_point) delete [] chunk_point;
+
   if (writers_raw)
   {
     for (i = 0; i < num_writers; i++)
@@ -526,6 +845,8 @@ LASwritePoint::~LASwritePoint()
     }
     delete [] writers_compressed;
   }
+  if (fused) delete fused;
+  if (attributes) delete [] attributes;
   if (enc)
   {
     delete enc;
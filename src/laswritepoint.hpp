@@ -24,6 +24,13 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- caps the threads at one per core and at most 8
+    16 October 2026 -- the threads that compress chunks are reused from one batch to the next
+    16 October 2026 -- optional descriptors of the extra bytes to code them attribute by attribute
+    16 October 2026 -- standard point types are written without a virtual call per item
+    16 October 2026 -- encodes each chunk twice (in a worker) for static models
+    16 October 2026 -- writes chunks with the bit-packed compressor for the hot storage tier
+    16 October 2026 -- optional compression of whole chunks with multiple threads
     21 February 2019 -- fix for writing 4294967295+ points uncompressed to LAS
     28 August 2017 -- moving 'context' from global development hack to interface  
     23 August 2016 -- layering of items for selective decompression in LAS 1.4 
@@ -47,7 +54,12 @@
 #include "bytestreamout.hpp"
 
 class LASwriteItem;
+class LASwriteItemsFused;
+class LASattribute;
+class LASattributeLayer;
 class ArithmeticEncoder;
+class ByteStreamOutArray;
+class LASthreadPool;
 
 class LASwritePoint
 {
@@ -55,6 +67,12 @@ public:
   LASwritePoint();
   ~LASwritePoint();
 
+  // optional: compress up to this many chunks in parallel (call *before* setup)
+  BOOL set_threads(const U32 num_threads);
+
+  // optional: the "extra bytes" descriptors for BYTE14 items of version LASZIP_BYTE14_VERSION_ATTRIBUTES (call *before* setup)
+  BOOL set_attributes(const U32 num_attributes, const LASattribute* attributes);
+
   // should only be called *once*
   BOOL setup(const U32 num_items, const LASitem* items, const LASzip* laszip=0);
 
@@ -69,8 +87,11 @@ private:
   LASwriteItem** writers;
   LASwriteItem** writers_raw;
   LASwriteItem** writers_compressed;
+  LASwriteItemsFused* fused;
   ArithmeticEncoder* enc;
   BOOL layered_las14_compression;
+  U32 num_attributes;
+  LASattributeLayer* attributes;
   // used for chunking
   U32 chunk_size;
   U32 chunk_count;
@@ -82,6 +103,22 @@ private:
   I64 chunk_table_start_position;
   BOOL add_chunk_to_table();
   BOOL write_chunk_table();
+  // used for parallel compression of chunks
+  U32 num_threads;
+  LASwritePoint** workers;
+  LASthreadPool* pool;
+  U32* item_offsets;
+  U32* item_footprints;
+  U32 buffered_point_size;
+  U8** batch_points;
+  U32* batch_points_allocated;
+  U32* batch_sizes;
+  BOOL* batch_valid;
+  U32 batch_count;
+  ByteStreamOutArray* chunk_stream;
+  const U8** chunk_point;
+  BOOL write_chunks();
+  BOOL compress_chunk(const U8* points, const U32 num_points);
 };
 
 #endif
@@ -253,7 +253,7 @@ bool LASzip::check_item(const LASitem* item)
     break;
   case LASitem::BYTE14:
     if (item->size < 1) return return_error("BYTE14 has size < 1");
-    if ((item->version != 0) && (item->version != 2) && (item->version != 3) && (item->version != 4)) return return_error("BYTE14 has version != 0 and != 2 and != 3 and != 4"); // version == 2 from lasproto, version == 4 fixes context-switch
+    if ((item->version != 0) && (item->version != 2) && (item->version != 3) && (item->version != 4) && (item->version != LASZIP_BYTE14_VERSION_ATTRIBUTES)) return return_error("BYTE14 has version != 0 and != 2 and != 3 and != 4 and != 5"); // version == 2 from lasproto, version == 4 fixes context-switch, version == 5 codes attributes
     break;
   case LASitem::WAVEPACKET13:
     if (item->size != 29) return return_error("WAVEPACKET13 has size != 29");
@@ -331,11 +331,11 @@ bool LASzip::setup(const U8 point_type, const U16 point_size, const U16 compress
   {
     if (items[0].type == LASitem::POINT14)
     {
-      if (compressor != LASZIP_COMPRESSOR_LAYERED_CHUNKED)
+      if ((compressor != LASZIP_COMPRESSOR_LAYERED_CHUNKED) && (compressor != LASZIP_COMPRESSOR_BITPACKED_CHUNKED))
       {
         return false;
       }
-      this->compressor = LASZIP_COMPRESSOR_LAYERED_CHUNKED;
+      this->compressor = compressor;
     }
     else
     {
@@ -371,11 +371,11 @@ bool LASzip::setup(const U16 num_items, const LASitem* items, const U16 compress
   {
     if (items[0].type == LASitem::POINT14)
     {
-      if (compressor != LASZIP_COMPRESSOR_LAYERED_CHUNKED)
+      if ((compressor != LASZIP_COMPRESSOR_LAYERED_CHUNKED) && (compressor != LASZIP_COMPRESSOR_BITPACKED_CHUNKED))
       {
         return false;
       }
-      this->compressor = LASZIP_COMPRESSOR_LAYERED_CHUNKED;
+      this->compressor = compressor;
     }
     else
     {
@@ -658,6 +658,22 @@ bool LASzip::request_version(const U16 requested_version)
   return true;
 }
 
+bool LASzip::request_coder(const U16 requested_coder)
+{
+  if (num_items == 0) return return_error("call setup() before requesting coder");
+  if (!check_coder(requested_coder)) return false;
+  if ((compressor == LASZIP_COMPRESSOR_NONE) && (requested_coder != LASZIP_CODER_ARITHMETIC))
+  {
+    return return_error("without compression coder is always arithmetic");
+  }
+  if ((compressor == LASZIP_COMPRESSOR_POINTWISE) && (requested_coder != LASZIP_CODER_ARITHMETIC))
+  {
+    return return_error("two-pass coder needs chunked compression");
+  }
+  coder = requested_coder;
+  return true;
+}
+
 bool LASzip::is_standard(U8* point_type, U16* record_length)
 {
   return is_standard(num_items, items, point_type, record_length);
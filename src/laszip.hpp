@@ -24,6 +24,13 @@
     implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
   CHANGE HISTORY:
+    16 October 2026 -- LASZIP_CODER_ARITHMETIC_STATIC is the size-only LASZIP_CODER_ARITHMETIC_TWO_PASS
+    16 October 2026 -- dropped LASZIP_CODER_RANS and LASZIP_CODER_RANS_STATIC that decoded no faster
+    16 October 2026 -- rANS coders only with chunks of a fixed size
+    16 October 2026 -- LASZIP_BYTE14_VERSION_ATTRIBUTES codes extra bytes attribute by attribute
+    16 October 2026 -- LASZIP_CODER_ARITHMETIC_STATIC and LASZIP_CODER_RANS_STATIC for archival
+    16 October 2026 -- LASZIP_COMPRESSOR_BITPACKED_CHUNKED that decodes near memcpy speed
+    16 October 2026 -- LASZIP_CODER_RANS and request_coder() for faster decoding
     20 October 2023 -- Fix int overflow of number_of_point_records when using laszip_update_inventory
     20 March 2019 -- upped to 3.3 r1 for consistent legacy and extended class check
     21 February 2019 -- bug fix when writing 4294967295+ points uncompressed to LAS
@@ -80,7 +87,8 @@ typedef long long SIGNED_INT64;
 #define LASZIP_COMPRESSOR_POINTWISE         1
 #define LASZIP_COMPRESSOR_POINTWISE_CHUNKED 2
 #define LASZIP_COMPRESSOR_LAYERED_CHUNKED   3
-#define LASZIP_COMPRESSOR_TOTAL_NUMBER_OF   4
+#define LASZIP_COMPRESSOR_BITPACKED_CHUNKED 4
+#define LASZIP_COMPRESSOR_TOTAL_NUMBER_OF   5
 
 #define LASZIP_COMPRESSOR_CHUNKED LASZIP_COMPRESSOR_POINTWISE_CHUNKED
 #define LASZIP_COMPRESSOR_NOT_CHUNKED LASZIP_COMPRESSOR_POINTWISE
@@ -88,10 +96,19 @@ typedef long long SIGNED_INT64;
 #define LASZIP_COMPRESSOR_DEFAULT LASZIP_COMPRESSOR_CHUNKED
 
 #define LASZIP_CODER_ARITHMETIC             0
-#define LASZIP_CODER_TOTAL_NUMBER_OF        1
+// the two-pass coder encodes each chunk twice. the models start from the
+// distributions counted in the first pass (or stay adaptive where that is
+// cheaper). this only makes files smaller: writing takes twice as long and
+// reading is not faster
+#define LASZIP_CODER_ARITHMETIC_TWO_PASS    1
+#define LASZIP_CODER_TOTAL_NUMBER_OF        2
 
 #define LASZIP_CHUNK_SIZE_DEFAULT           50000
 
+// BYTE14 items of this version code the extra bytes attribute by attribute
+
+#define LASZIP_BYTE14_VERSION_ATTRIBUTES    5
+
 #include "mydefs.hpp"
 
 class LASLIB_DLL LASitem
@@ -131,6 +148,7 @@ public:
   bool setup(const unsigned short num_items, const LASitem* items, const unsigned short compressor);
   bool set_chunk_size(const unsigned int chunk_size);             /* for compressor only */
   bool request_version(const unsigned short requested_version);   /* for compressor only */
+  bool request_coder(const unsigned short requested_coder);       /* for compressor only */
 
   // in case a function returns false this string describes the problem
   const char* get_error() const;
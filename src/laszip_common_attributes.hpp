@@ -0,0 +1,238 @@
+/*
+===============================================================================
+
+  FILE:  laszip_common_attributes.hpp
+
+  CONTENTS:
+
+    Common defines and functionalities for LASreadItemAttributes and
+    LASwriteItemAttributes that compress the extra bytes of LAS 1.4 points
+    attribute by attribute as described by the "extra bytes" VLR.
+
+    every attribute is one layer. 8-bit and untyped attributes are coded like
+    BYTE14 with one difference model per byte. 16-bit and 32-bit integers are
+    coded with an IntegerCompressor over whole values. floats are mapped to
+    integers that have the same order as the floats (the sign bit is flipped
+    for positive and all bits for negative values). the difference of these
+    and of 64-bit integers to the last value is zigzag mapped and coded as its
+    number of significant bytes followed by these bytes with one model per
+    byte position (another one for the top byte). unlike an IntegerCompressor this also models the low bits of large
+    differences, which repeat for regularly spaced floats (i.e. GPS times).
+    values equal to the "no_data" value of an attribute are flagged with one
+    bit and do not become the prediction for the next value.
+
+    bytes that are not described by an attribute are one layer per byte. the
+    layout of the layers is stored in every chunk so that the reader does not
+    need the VLR:
+
+      U32 number of layers
+      per layer:
+        U8  kind (LASZIP_ATTRIBUTE_*)
+        U8  number of values
+        U8  whether there is a no_data value
+        U8  zero
+        U64 no_data value (only if there is one)
+        U32 number of compressed bytes of the layer
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- created to code typed extra bytes with whole values
+
+===============================================================================
+*/
+#ifndef LASZIP_COMMON_ATTRIBUTES_HPP
+#define LASZIP_COMMON_ATTRIBUTES_HPP
+
+#include "mydefs.hpp"
+
+class ArithmeticModel;
+class ArithmeticBitModel;
+class IntegerCompressor;
+
+#define LASZIP_ATTRIBUTE_BYTE     0
+#define LASZIP_ATTRIBUTE_INT16    1
+#define LASZIP_ATTRIBUTE_INT32    2
+#define LASZIP_ATTRIBUTE_INT64    3
+#define LASZIP_ATTRIBUTE_FLOAT32  4
+#define LASZIP_ATTRIBUTE_FLOAT64  5
+#define LASZIP_ATTRIBUTE_NUMBER_OF 6
+
+// one attribute that has 'count' values of one kind (or 'count' bytes)
+
+class LASattributeLayer
+{
+public:
+  U8 kind;
+  U8 count;
+  BOOL has_no_data;
+  U64 no_data;
+};
+
+// one value of a layer in the item
+
+class LASattributeValue
+{
+public:
+  U32 layer;
+  U32 offset;
+  U8 kind;
+  BOOL has_no_data;
+  U64 no_data;
+};
+
+inline U32 laszip_attribute_kind_size(const U32 kind)
+{
+  static const U32 sizes[LASZIP_ATTRIBUTE_NUMBER_OF] = { 1, 2, 4, 8, 4, 8 };
+  return sizes[kind];
+}
+
+// returns the number of values of the layers or 0 if they do not add up to 'number' bytes
+
+inline U32 laszip_attribute_values(const U32 num_layers, const LASattributeLayer* layers, const U32 number, LASattributeValue* values)
+{
+  U32 l, j, offset = 0, num_values = 0;
+  for (l = 0; l < num_layers; l++)
+  {
+    if ((layers[l].kind >= LASZIP_ATTRIBUTE_NUMBER_OF) || (layers[l].count == 0)) return 0;
+    for (j = 0; j < layers[l].count; j++)
+    {
+      if ((offset + laszip_attribute_kind_size(layers[l].kind)) > number) return 0;
+      if (values)
+      {
+        values[num_values].layer = l;
+        values[num_values].offset = offset;
+        values[num_values].kind = layers[l].kind;
+        values[num_values].has_no_data = layers[l].has_no_data;
+        values[num_values].no_data = layers[l].no_data;
+      }
+      num_values++;
+      offset += laszip_attribute_kind_size(layers[l].kind);
+    }
+  }
+  return (offset == number ? num_values : 0);
+}
+
+// the values are little-endian in the item (as in the LAS file)
+
+inline U64 laszip_attribute_get(const U8* bytes, const U32 size)
+{
+  U64 value = 0;
+  U32 i;
+  for (i = 0; i < size; i++)
+  {
+    value |= ((U64)bytes[i]) << (8*i);
+  }
+  return value;
+}
+
+inline void laszip_attribute_set(U8* bytes, const U32 size, U64 value)
+{
+  U32 i;
+  for (i = 0; i < size; i++)
+  {
+    bytes[i] = (U8)(value >> (8*i));
+  }
+}
+
+// maps the bits of a float to an integer of the same order and back
+
+inline U32 laszip_attribute_order32(const U32 bits)
+{
+  return ((bits & 0x80000000) ? ~bits : (bits | 0x80000000));
+}
+
+inline U32 laszip_attribute_unorder32(const U32 ordered)
+{
+  return ((ordered & 0x80000000) ? (ordered & 0x7FFFFFFF) : ~ordered);
+}
+
+inline U64 laszip_attribute_order64(const U64 bits)
+{
+  return ((bits & 0x8000000000000000ULL) ? ~bits : (bits | 0x8000000000000000ULL));
+}
+
+inline U64 laszip_attribute_unorder64(const U64 ordered)
+{
+  return ((ordered & 0x8000000000000000ULL) ? (ordered & 0x7FFFFFFFFFFFFFFFULL) : ~ordered);
+}
+
+// maps the bits of an integer or float attribute to an integer of the same
+// order and back
+
+inline U64 laszip_attribute_order(const U32 kind, const U64 bits)
+{
+  if (kind == LASZIP_ATTRIBUTE_FLOAT32) return laszip_attribute_order32((U32)bits);
+  if (kind == LASZIP_ATTRIBUTE_FLOAT64) return laszip_attribute_order64(bits);
+  return bits;
+}
+
+inline U64 laszip_attribute_unorder(const U32 kind, const U64 ordered)
+{
+  if (kind == LASZIP_ATTRIBUTE_FLOAT32) return laszip_attribute_unorder32((U32)ordered);
+  if (kind == LASZIP_ATTRIBUTE_FLOAT64) return laszip_attribute_unorder64(ordered);
+  return ordered;
+}
+
+// maps the difference of two values with 'size' bytes to an unsigned number
+// that is small when the difference is small (0, -1, 1, -2, 2, ...) and back
+
+inline U64 laszip_attribute_zigzag(const U32 size, U64 diff)
+{
+  if (size == 2) diff = (U64)(I64)(I16)(U16)diff;
+  else if (size == 4) diff = (U64)(I64)(I32)(U32)diff;
+  return (diff << 1) ^ (U64)(-(I64)(diff >> 63));
+}
+
+inline U64 laszip_attribute_unzigzag(const U64 zigzag)
+{
+  return (zigzag >> 1) ^ (U64)(-(I64)(zigzag & 1));
+}
+
+// the number of significant bytes of a zigzag mapped difference
+
+inline U32 laszip_attribute_significant_bytes(U64 zigzag)
+{
+  U32 n = 0;
+  while (zigzag)
+  {
+    zigzag = zigzag >> 8;
+    n++;
+  }
+  return n;
+}
+
+// the models of one scanner channel. each value has either a symbol model
+// (bytes), an integer compressor (16-bit and 32-bit integers) or a symbol
+// model for the number of significant bytes of the difference plus one per
+// byte (floats and 64-bit integers). optionally there is a bit model for
+// whether it is no_data
+
+class LAScontextATTRIBUTES
+{
+public:
+  BOOL unused;
+
+  U8* last_item;
+
+  ArithmeticModel** m_bytes;
+  ArithmeticModel** m_diff_bytes; // 2 per byte of a value
+  IntegerCompressor** ic_values;
+  ArithmeticBitModel** m_no_data;
+};
+
+#endif
@@ -0,0 +1,192 @@
+/*
+===============================================================================
+
+  FILE:  laszip_common_bitpacked.hpp
+
+  CONTENTS:
+
+    Common defines and functionalities for LASreadItemBitpacked and
+    LASwriteItemBitpacked that store each field of an item per chunk as
+    blocks of frame-of-reference bit-packed values (raw or as differences).
+
+    every block of a field starts with one byte that holds the number of bits
+    per value and whether the values are zigzagged differences to the previous
+    value (LASZIP_BITPACKED_DELTA), followed by the base that is added to all
+    values (stored with as many bytes as the field is wide) and the values as
+    a little-endian bit stream. the first item of a chunk is stored raw.
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- no legacy bytes of POINT14 items as the reader derives them
+    16 October 2026 -- created for the bit-packed compressor of the hot storage tier
+
+===============================================================================
+*/
+#ifndef LASZIP_COMMON_BITPACKED_HPP
+#define LASZIP_COMMON_BITPACKED_HPP
+
+#include "mydefs.hpp"
+#include "laszip.hpp"
+
+#include <string.h>
+
+#define LASZIP_BITPACKED_BLOCK_SIZE 128
+#define LASZIP_BITPACKED_DELTA 0x80
+#define LASZIP_BITPACKED_BITS 0x7F
+
+// the reader may load 8 bytes (plus one) at the last value of the last block
+#define LASZIP_BITPACKED_PADDING 16
+
+// where a field sits in the (in-memory) item, how many bytes it has and which
+// of their bits are stored (the others are read back as zero)
+
+class LASbitpackedField
+{
+public:
+  U16 offset;
+  U16 width;
+  U64 keep;
+};
+
+inline U64 laszip_bitpacked_mask(const U32 width)
+{
+  return (width >= 8 ? (U64)-1 : (((U64)1) << (8*width)) - 1);
+}
+
+// fills in the fields of an item (at most item.size many) and returns their number
+
+inline U32 laszip_bitpacked_fields(const LASitem& item, LASbitpackedField* fields)
+{
+  static const U16 point10[9][2] = { {0,4}, {4,4}, {8,4}, {12,2}, {14,1}, {15,1}, {16,1}, {17,1}, {18,2} };
+  // layout of the LASpoint14 struct up to and including the GPS time without
+  // the legacy return counts, classification, and scan angle rank (bytes 14
+  // to 16) that the reader derives from the extended fields. of byte 14 only
+  // the scan direction flag and the edge of flight line are stored
+  static const U16 point14[12][2] = { {0,4}, {4,4}, {8,4}, {12,2}, {14,1}, {17,1}, {18,2}, {20,2}, {22,1}, {23,1}, {24,1}, {32,8} };
+  static const U16 wavepacket[7][2] = { {0,1}, {1,8}, {9,4}, {13,4}, {17,4}, {21,4}, {25,4} };
+  const U16 (*table)[2] = 0;
+  U32 i, num_fields = 0;
+  switch (item.type)
+  {
+  case LASitem::POINT10:
+    table = point10;
+    num_fields = 9;
+    break;
+  case LASitem::POINT14:
+    table = point14;
+    num_fields = 12;
+    break;
+  case LASitem::GPSTIME11:
+    fields[0].offset = 0;
+    fields[0].width = 8;
+    fields[0].keep = laszip_bitpacked_mask(8);
+    return 1;
+  case LASitem::RGB12:
+  case LASitem::RGB14:
+  case LASitem::RGBNIR14:
+    num_fields = (item.type == LASitem::RGBNIR14 ? 4 : 3);
+    for (i = 0; i < num_fields; i++)
+    {
+      fields[i].offset = 2*i;
+      fields[i].width = 2;
+      fields[i].keep = laszip_bitpacked_mask(2);
+    }
+    return num_fields;
+  case LASitem::WAVEPACKET13:
+  case LASitem::WAVEPACKET14:
+    table = wavepacket;
+    num_fields = 7;
+    break;
+  default:
+    // every byte is a field of its own
+    for (i = 0; i < item.size; i++)
+    {
+      fields[i].offset = i;
+      fields[i].width = 1;
+      fields[i].keep = laszip_bitpacked_mask(1);
+    }
+    return item.size;
+  }
+  for (i = 0; i < num_fields; i++)
+  {
+    fields[i].offset = table[i][0];
+    fields[i].width = table[i][1];
+    fields[i].keep = laszip_bitpacked_mask(table[i][1]);
+  }
+  if (item.type == LASitem::POINT14)
+  {
+    fields[4].keep = 0xC0; // byte 14
+  }
+  return num_fields;
+}
+
+// how many bytes of the item the fields cover
+
+inline U32 laszip_bitpacked_record_size(const LASbitpackedField* fields, const U32 num_fields)
+{
+  U32 i, record_size = 0;
+  for (i = 0; i < num_fields; i++)
+  {
+    if (record_size < (U32)(fields[i].offset + fields[i].width)) record_size = fields[i].offset + fields[i].width;
+  }
+  return record_size;
+}
+
+// fields are loaded and stored in the native byte order of the item
+
+inline U64 laszip_bitpacked_get(const U8* field, const U32 width)
+{
+  switch (width)
+  {
+  case 1:
+    return field[0];
+  case 2:
+    {
+      U16 value;
+      memcpy(&value, field, 2);
+      return value;
+    }
+  case 4:
+    {
+      U32 value;
+      memcpy(&value, field, 4);
+      return value;
+    }
+  default:
+    {
+      U64 value;
+      memcpy(&value, field, 8);
+      return value;
+    }
+  }
+}
+
+// the bit stream and the bases are little-endian on all hosts
+
+inline U64 laszip_bitpacked_load64(const U8* bytes)
+{
+  return ((U64)bytes[0]) | (((U64)bytes[1]) << 8) | (((U64)bytes[2]) << 16) | (((U64)bytes[3]) << 24) | (((U64)bytes[4]) << 32) | (((U64)bytes[5]) << 40) | (((U64)bytes[6]) << 48) | (((U64)bytes[7]) << 56);
+}
+
+inline void laszip_bitpacked_store64(U8* bytes, const U64 value)
+{
+  U32 i;
+  for (i = 0; i < 8; i++) bytes[i] = (U8)(value >> (8*i));
+}
+
+#endif
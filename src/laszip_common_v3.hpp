@@ -25,6 +25,10 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- integer compressors with the number of bits fixed at compile time
+    16 October 2026 -- what the POINT14 layers carry over when decompressed in lockstep
+    16 October 2026 -- per-point record for decompressing POINT14 layers in parallel
+    16 October 2026 -- size of the LASpoint14 footprint for chunk-parallel processing
     27 June 2016 -- after Iceland forced England's BrExit with 2:1 at EURO2016
 
 ===============================================================================
@@ -36,6 +40,9 @@
 #include "laszip_common_v2.hpp"
 
 #define DEBUG_OUTPUT_NUM_BYTES_DETAILS 0
+
+// bytes of the LASpoint14 struct that POINT14 readers and writers copy from / to the item
+#define LASZIP_POINT14_FOOTPRINT 48
 #pragma warning(push)
 #pragma warning(disable : 26495)
 class LAScontextPOINT14
@@ -54,9 +61,9 @@ public:
   ArithmeticModel* m_number_of_returns[16];
   ArithmeticModel* m_return_number_gps_same;
   ArithmeticModel* m_return_number[16];
-  IntegerCompressor* ic_dX;
-  IntegerCompressor* ic_dY;
-  IntegerCompressor* ic_Z;
+  IntegerCompressorFixed<32>* ic_dX;
+  IntegerCompressorFixed<32>* ic_dY;
+  IntegerCompressorFixed<32>* ic_Z;
 
   ArithmeticModel* m_classification[64];
 
@@ -64,11 +71,11 @@ public:
 
   ArithmeticModel* m_user_data[64];
 
-  IntegerCompressor* ic_intensity;
+  IntegerCompressorFixed<16>* ic_intensity;
 
-  IntegerCompressor* ic_scan_angle;
+  IntegerCompressorFixed<16>* ic_scan_angle;
 
-  IntegerCompressor* ic_point_source_ID;
+  IntegerCompressorFixed<16>* ic_point_source_ID;
 
   // GPS time stuff
   U32 last, next;
@@ -78,7 +85,63 @@ public:
 
   ArithmeticModel* m_gpstime_multi;
   ArithmeticModel* m_gpstime_0diff;
-  IntegerCompressor* ic_gpstime;
+  IntegerCompressorFixed<32>* ic_gpstime;
+};
+
+// bits of LASlayeredPOINT14::changes
+#define LASZIP_LAYERED_NEW_CONTEXT          0x01
+#define LASZIP_LAYERED_SWITCHED_CONTEXT     0x02
+#define LASZIP_LAYERED_GPS_TIME_CHANGE      0x04
+#define LASZIP_LAYERED_SCAN_ANGLE_CHANGE    0x08
+#define LASZIP_LAYERED_POINT_SOURCE_CHANGE  0x10
+
+// one point of a chunk whose layers are decompressed one after the other.
+// the channel_returns_XY layer fills in the contexts and the item, then each
+// of the other layers writes only its own field(s), maybe from its own thread
+
+class LASlayeredPOINT14
+{
+public:
+  U8 context;
+  U8 changes;
+  U8 cpr;
+  U8 l;
+  U32 k_Z;
+
+  I32 Z;
+  U16 intensity;
+  U16 point_source_ID;
+  I16 scan_angle;
+  I8 legacy_scan_angle_rank;
+  U8 classification;
+  U8 flags;
+  U8 user_data;
+  F64 gps_time;
+
+  U8 item[LASZIP_POINT14_FOOTPRINT];
+};
+
+// what the other layers carry over from one point to the next (per context)
+
+class LASlayersPOINT14
+{
+public:
+  I32 Z;
+  U16 intensity;
+  U8 classification[4];
+  U8 previous_classification;
+  U8 flags[4];
+  U8 previous_flags;
+  I16 scan_angle[4];
+  I16 previous_scan_angle;
+  I8 scan_angle_rank[4];
+  I8 previous_scan_angle_rank;
+  U8 user_data[4];
+  U8 previous_user_data;
+  U16 point_source_ID[4];
+  U16 previous_point_source_ID;
+  F64 gps_time[4];
+  F64 previous_gps_time;
 };
 
 class LAScontextRGB14
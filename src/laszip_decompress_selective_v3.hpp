@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+   16 October 2026 -- note that LASreadPoint::set_selective_bytes() selects any extra bytes
    14 April 2017 -- created at Lo Que Hay where Gui was having birthday dinner
 
 ===============================================================================
@@ -55,4 +56,8 @@
 #define LASZIP_DECOMPRESS_SELECTIVE_BYTE7              0x00800000
 #define LASZIP_DECOMPRESS_SELECTIVE_EXTRA_BYTES        0xFFFF0000
 
+// the BYTE flags select among the first 16 extra bytes only (all others are
+// always decompressed). LASreadPoint::set_selective_bytes() selects any of the
+// extra bytes and is what laszip_decompress_selective_attribute() resolves to
+
 #endif // LASZIP_DECOMPRESS_SELECTIVE_V3_HPP
@@ -24,6 +24,22 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- 'laszip_read_columns()' picks the extended attributes per point
+    16 October 2026 -- 'laszip_decompress_selective_on_demand()' adds layers while reading a chunk
+    16 October 2026 -- 'laszip_decompress_selective_attribute[_by_name]()' for any extra bytes
+    16 October 2026 -- 'laszip_request_attribute_compression()' to code typed extra bytes by value
+    16 October 2026 -- 'laszip_request_bitpacked_compression()' to write for the hot storage tier
+    16 October 2026 -- 'laszip_set_coder()' no longer offers the rANS coder
+    16 October 2026 -- 'laszip_set_coder()' to write with the interleaved rANS coder
+    16 October 2026 -- 'laszip_set_chunk_cache()' and 'laszip_get_chunk_cache_stats()'
+    16 October 2026 -- 'laszip_read_columns()' writes points into caller-provided column arrays
+    16 October 2026 -- 'laszip_read_points()' and 'laszip_read_packed_points()' read many points per call
+    16 October 2026 -- 'laszip_get_chunk_count()' and 'laszip_get_chunk_info[s]()'
+    16 October 2026 -- 'laszip_set_seek_checkpoints()' to remember decoder states inside chunks
+    16 October 2026 -- 'laszip_request_memory_mapping()' to read files via mmap
+    16 October 2026 -- 'laszip_decompress_layers_in_parallel()' for new LAS 1.4 points
+    16 October 2026 -- 'laszip_set_number_of_threads()' also for parallel compression of chunks
+    16 October 2026 -- 'laszip_set_number_of_threads()' for parallel decompression of chunks
     24 March 2021 -- fix small memory leak
     15 October 2019 -- support reading from and writing to unicode file names under Windows
     20 March 2019 -- check consistent legacy and extended classification in laszip_write_point()
@@ -62,6 +78,7 @@
 #include "lasattributer.hpp"
 #include "bytestreamout_file.hpp"
 #include "bytestreamin_file.hpp"
+#include "bytestreamin_mmap.hpp"
 #include "bytestreamout_array.hpp"
 #include "bytestreamin_array.hpp"
 #include "bytestreamin_istream.hpp"
@@ -160,17 +177,29 @@ typedef struct laszip_dll
   BOOL lax_append;
   BOOL lax_exploit;
   U32 las14_decompress_selective;
+  std::vector<I32> selective_attribute_indices;
+  std::vector<CHAR*> selective_attribute_names;
   BOOL preserve_generating_software;
   BOOL request_native_extension;
   BOOL request_compatibility_mode;
   BOOL compatibility_mode;
   U32 set_chunk_size;
+  U16 set_coder;
+  BOOL request_bitpacked_compression;
+  BOOL request_attribute_compression;
+  U32 number_of_threads;
+  BOOL decompress_layers_in_parallel;
+  BOOL request_memory_mapping;
+  U32 seek_checkpoint_interval;
+  U64 chunk_cache_max_bytes;
   I32 start_scan_angle;
   I32 start_extended_returns;
   I32 start_classification;
   I32 start_flags_and_channel;
   I32 start_NIR_band;
   laszip_dll_inventory* inventory;
+  LASwritePoint* point_packer;
+  ByteStreamOutArray* packed_stream;
   std::vector<void *> buffers;
   laszip_message_callback_data_struct* message_callback_data;
 
@@ -205,11 +234,23 @@ typedef struct laszip_dll
     lax_append = FALSE;
     lax_exploit = FALSE;
     las14_decompress_selective = 0;
+    selective_attribute_indices.clear();
+    selective_attribute_names.clear();
     preserve_generating_software = FALSE;
     request_native_extension = FALSE;
     request_compatibility_mode = FALSE;
     compatibility_mode = FALSE;
     set_chunk_size = 0;
+    set_coder = LASZIP_CODER_ARITHMETIC;
+    request_bitpacked_compression = FALSE;
+    request_attribute_compression = FALSE;
+    number_of_threads = 0;
+    decompress_layers_in_parallel = FALSE;
+    request_memory_mapping = FALSE;
+    seek_checkpoint_interval = 0;
+    chunk_cache_max_bytes = 0;
+    point_packer = NULL;
+    packed_stream = NULL;
     start_scan_angle = 0;
     start_extended_returns = 0;
     start_classification = 0;
@@ -520,6 +561,20 @@ laszip_clean(
       laszip_dll->point_items = 0;
     }
 
+    // dealloc point packer although close_reader() call should have done this already
+
+    if (laszip_dll->point_packer)
+    {
+      delete laszip_dll->point_packer;
+      laszip_dll->point_packer = 0;
+    }
+
+    if (laszip_dll->packed_stream)
+    {
+      delete laszip_dll->packed_stream;
+      laszip_dll->packed_stream = 0;
+    }
+
     // close file although close_reader() / close_writer() call should have done this already
 
     if (laszip_dll->file)
@@ -587,6 +642,14 @@ laszip_clean(
       laszip_dll->buffers.clear();
     }
 
+    // dealloc the names of the attributes requested for selective decompression
+
+    for (size_t i = 0; i < laszip_dll->selective_attribute_names.size(); i++)
+    {
+      free(laszip_dll->selective_attribute_names[i]);
+    }
+    laszip_dll->selective_attribute_names.clear();
+
     // dealloc message callback data
 
     if (laszip_dll->message_callback_data)
@@ -1940,6 +2003,120 @@ laszip_set_chunk_size(
   return 0;
 }
 
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_set_coder(
+    laszip_POINTER                     pointer
+    , const laszip_U16                 coder
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (laszip_dll->reader)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is already open");
+      return 1;
+    }
+
+    if (laszip_dll->writer)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "writer is already open");
+      return 1;
+    }
+
+    if (coder >= LASZIP_CODER_TOTAL_NUMBER_OF)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "coder %d not supported", (I32)coder);
+      return 1;
+    }
+
+    laszip_dll->set_coder = coder;
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_set_coder");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_request_bitpacked_compression(
+    laszip_POINTER                     pointer
+    , const laszip_BOOL                request
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (laszip_dll->reader)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is already open");
+      return 1;
+    }
+
+    if (laszip_dll->writer)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "writer is already open");
+      return 1;
+    }
+
+    laszip_dll->request_bitpacked_compression = request;
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_request_bitpacked_compression");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_request_attribute_compression(
+    laszip_POINTER                     pointer
+    , const laszip_BOOL                request
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (laszip_dll->reader)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is already open");
+      return 1;
+    }
+
+    if (laszip_dll->writer)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "writer is already open");
+      return 1;
+    }
+
+    laszip_dll->request_attribute_compression = request;
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_request_attribute_compression");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
 /*---------------------------------------------------------------------------*/
 LASZIP_API laszip_I32
 laszip_create_spatial_index(
@@ -2915,6 +3092,15 @@ laszip_I32 create_point_writer
     return 1;
   }
 
+  laszip_dll->writer->set_threads(laszip_dll->number_of_threads);
+
+  // the typed extra bytes are coded by attribute if requested
+
+  if (laszip_dll->attributer)
+  {
+    laszip_dll->writer->set_attributes(laszip_dll->attributer->number_attributes, laszip_dll->attributer->attributes);
+  }
+
   if (!laszip_dll->writer->setup(laszip->num_items, laszip->items, laszip))
   {
     snprintf(laszip_dll->error, sizeof(laszip_dll->error), "setup of LASwritePoint failed");
@@ -3008,7 +3194,15 @@ setup_laszip_items(
 
   if (compress)
   {
-    if ((point_type > 5) && laszip_dll->request_native_extension)
+    if (laszip_dll->request_bitpacked_compression)
+    {
+      if (!laszip->setup(point_type, point_size, LASZIP_COMPRESSOR_BITPACKED_CHUNKED))
+      {
+        snprintf(laszip_dll->error, sizeof(laszip_dll->error), "cannot compress point_type %d with point_size %d using bit-packing", (I32)point_type, (I32)point_size);
+        return 1;
+      }
+    }
+    else if ((point_type > 5) && laszip_dll->request_native_extension)
     {
       if (!laszip->setup(point_type, point_size, LASZIP_COMPRESSOR_LAYERED_CHUNKED))
       {
@@ -3039,6 +3233,30 @@ setup_laszip_items(
         return 1;
       }
     }
+
+    // maybe we should change the entropy coder
+
+    if (laszip_dll->set_coder != LASZIP_CODER_ARITHMETIC)
+    {
+      if (!laszip->request_coder(laszip_dll->set_coder))
+      {
+        snprintf(laszip_dll->error, sizeof(laszip_dll->error), "requesting coder %d has failed", (I32)laszip_dll->set_coder);
+        return 1;
+      }
+    }
+
+    // maybe we should code the extra bytes by attribute (layered LAS 1.4 points only)
+
+    if (laszip_dll->request_attribute_compression && (laszip->compressor == LASZIP_COMPRESSOR_LAYERED_CHUNKED))
+    {
+      for (U32 i = 0; i < laszip->num_items; i++)
+      {
+        if (laszip->items[i].type == LASitem::BYTE14)
+        {
+          laszip->items[i].version = LASZIP_BYTE14_VERSION_ATTRIBUTES;
+        }
+      }
+    }
   }
   else
   {
@@ -3592,59 +3810,305 @@ laszip_decompress_selective(
 }
 
 /*---------------------------------------------------------------------------*/
-static I32
-laszip_read_header(
-    laszip_dll_struct*                 laszip_dll
-    , laszip_BOOL*                     is_compressed
+LASZIP_API laszip_I32
+laszip_decompress_selective_attribute(
+    laszip_POINTER                     pointer
+    , const laszip_I32                 index
 )
 {
-  U32 i;
-
-  // read the header variable after variable
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
 
-  CHAR file_signature[5];
-  try { laszip_dll->streamin->getBytes((U8*)file_signature, 4); } catch(...)
-  {
-    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading header.file_signature");
-    return 1;
-  }
-  if (strncmp(file_signature, "LASF", 4) != 0)
-  {
-    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "wrong file_signature. not a LAS/LAZ file.");
-    return 1;
-  }
-  try { laszip_dll->streamin->get16bitsLE((U8*)&(laszip_dll->header.file_source_ID)); } catch(...)
+  try
   {
-    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading header.file_source_ID");
-    return 1;
+    if (laszip_dll->reader)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is already open");
+      return 1;
+    }
+
+    if (laszip_dll->writer)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "writer is already open");
+      return 1;
+    }
+
+    if (index < 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "attribute index %d is negative", index);
+      return 1;
+    }
+
+    laszip_dll->selective_attribute_indices.push_back(index);
   }
-  try { laszip_dll->streamin->get16bitsLE((U8*)&(laszip_dll->header.global_encoding)); } catch(...)
+  catch (...)
   {
-    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading header.global_encoding");
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_decompress_selective_attribute");
     return 1;
   }
-  try { laszip_dll->streamin->get32bitsLE((U8*)&(laszip_dll->header.project_ID_GUID_data_1)); } catch(...)
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_decompress_selective_attribute_by_name(
+    laszip_POINTER                     pointer
+    , const laszip_CHAR*               name
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
   {
-    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading header.project_ID_GUID_data_1");
-    return 1;
+    if (laszip_dll->reader)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is already open");
+      return 1;
+    }
+
+    if (laszip_dll->writer)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "writer is already open");
+      return 1;
+    }
+
+    if (name == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_CHAR pointer 'name' is zero");
+      return 1;
+    }
+
+    laszip_dll->selective_attribute_names.push_back(LASCopyString(name));
   }
-  try { laszip_dll->streamin->get16bitsLE((U8*)&(laszip_dll->header.project_ID_GUID_data_2)); } catch(...)
+  catch (...)
   {
-    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading header.project_ID_GUID_data_2");
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_decompress_selective_attribute_by_name");
     return 1;
   }
-  try { laszip_dll->streamin->get16bitsLE((U8*)&(laszip_dll->header.project_ID_GUID_data_3)); } catch(...)
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_set_number_of_threads(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 number_of_threads
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
   {
-    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading header.project_ID_GUID_data_3");
-    return 1;
+    if (laszip_dll->reader)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is already open");
+      return 1;
+    }
+
+    if (laszip_dll->writer)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "writer is already open");
+      return 1;
+    }
+
+    laszip_dll->number_of_threads = number_of_threads;
   }
-  try { laszip_dll->streamin->getBytes((U8*)laszip_dll->header.project_ID_GUID_data_4, 8); } catch(...)
+  catch (...)
   {
-    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading header.project_ID_GUID_data_4");
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_set_number_of_threads");
     return 1;
   }
-  try { laszip_dll->streamin->getBytes((U8*)&(laszip_dll->header.version_major), 1); } catch(...)
-  {
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_decompress_layers_in_parallel(
+    laszip_POINTER                     pointer
+    , const laszip_BOOL                in_parallel
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (laszip_dll->reader)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is already open");
+      return 1;
+    }
+
+    if (laszip_dll->writer)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "writer is already open");
+      return 1;
+    }
+
+    laszip_dll->decompress_layers_in_parallel = in_parallel;
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_decompress_layers_in_parallel");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_request_memory_mapping(
+    laszip_POINTER                     pointer
+    , const laszip_BOOL                request
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (laszip_dll->reader)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is already open");
+      return 1;
+    }
+
+    laszip_dll->request_memory_mapping = request;
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_request_memory_mapping");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_set_seek_checkpoints(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 interval
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (laszip_dll->reader)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is already open");
+      return 1;
+    }
+
+    laszip_dll->seek_checkpoint_interval = interval;
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_set_seek_checkpoints");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_set_chunk_cache(
+    laszip_POINTER                     pointer
+    , const laszip_U64                 max_bytes
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (laszip_dll->reader)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is already open");
+      return 1;
+    }
+
+    laszip_dll->chunk_cache_max_bytes = max_bytes;
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_set_chunk_cache");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static I32
+laszip_read_header(
+    laszip_dll_struct*                 laszip_dll
+    , laszip_BOOL*                     is_compressed
+)
+{
+  U32 i;
+
+  // read the header variable after variable
+
+  CHAR file_signature[5];
+  try { laszip_dll->streamin->getBytes((U8*)file_signature, 4); } catch(...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading header.file_signature");
+    return 1;
+  }
+  if (strncmp(file_signature, "LASF", 4) != 0)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "wrong file_signature. not a LAS/LAZ file.");
+    return 1;
+  }
+  try { laszip_dll->streamin->get16bitsLE((U8*)&(laszip_dll->header.file_source_ID)); } catch(...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading header.file_source_ID");
+    return 1;
+  }
+  try { laszip_dll->streamin->get16bitsLE((U8*)&(laszip_dll->header.global_encoding)); } catch(...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading header.global_encoding");
+    return 1;
+  }
+  try { laszip_dll->streamin->get32bitsLE((U8*)&(laszip_dll->header.project_ID_GUID_data_1)); } catch(...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading header.project_ID_GUID_data_1");
+    return 1;
+  }
+  try { laszip_dll->streamin->get16bitsLE((U8*)&(laszip_dll->header.project_ID_GUID_data_2)); } catch(...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading header.project_ID_GUID_data_2");
+    return 1;
+  }
+  try { laszip_dll->streamin->get16bitsLE((U8*)&(laszip_dll->header.project_ID_GUID_data_3)); } catch(...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading header.project_ID_GUID_data_3");
+    return 1;
+  }
+  try { laszip_dll->streamin->getBytes((U8*)laszip_dll->header.project_ID_GUID_data_4, 8); } catch(...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading header.project_ID_GUID_data_4");
+    return 1;
+  }
+  try { laszip_dll->streamin->getBytes((U8*)&(laszip_dll->header.version_major), 1); } catch(...)
+  {
     snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading header.version_major");
     return 1;
   }
@@ -4395,6 +4859,62 @@ laszip_read_header(
     laszip_dll->point.extended_point_type = 1;
   }
 
+  // only decompress the extra bytes of the requested attributes
+
+  U32 num_selective_bytes = 0;
+  BOOL* selective_bytes = 0;
+
+  if (laszip_dll->selective_attribute_indices.size() || laszip_dll->selective_attribute_names.size())
+  {
+    LASattributer attributer;
+    for (i = 0; i < laszip_dll->header.number_of_variable_length_records; i++)
+    {
+      if ((strncmp(laszip_dll->header.vlrs[i].user_id, "LASF_Spec\0\0\0\0\0\0", 16) == 0) && (laszip_dll->header.vlrs[i].record_id == 4))
+      {
+        attributer.init_attributes(laszip_dll->header.vlrs[i].record_length_after_header/192, (LASattribute*)laszip_dll->header.vlrs[i].data);
+        break;
+      }
+    }
+
+    std::vector<I32> indices(laszip_dll->selective_attribute_indices);
+    for (size_t n = 0; n < laszip_dll->selective_attribute_names.size(); n++)
+    {
+      I32 index = attributer.get_attribute_index(laszip_dll->selective_attribute_names[n]);
+      if (index == -1)
+      {
+        snprintf(laszip_dll->error, sizeof(laszip_dll->error), "no extra bytes attribute named '%s'", laszip_dll->selective_attribute_names[n]);
+        delete laszip;
+        return 1;
+      }
+      indices.push_back(index);
+    }
+
+    num_selective_bytes = (attributer.number_attributes ? attributer.get_attribute_start(attributer.number_attributes-1) + attributer.get_attribute_size(attributer.number_attributes-1) : 0);
+    for (size_t n = 0; n < indices.size(); n++)
+    {
+      if (indices[n] >= attributer.number_attributes)
+      {
+        snprintf(laszip_dll->error, sizeof(laszip_dll->error), "no extra bytes attribute with index %d", indices[n]);
+        delete laszip;
+        return 1;
+      }
+    }
+    selective_bytes = new BOOL[num_selective_bytes + 1];
+    for (U32 b = 0; b < num_selective_bytes; b++)
+    {
+      selective_bytes[b] = FALSE;
+    }
+    for (size_t n = 0; n < indices.size(); n++)
+    {
+      I32 start = attributer.get_attribute_start(indices[n]);
+      I32 size = attributer.get_attribute_size(indices[n]);
+      for (I32 b = start; b < start + size; b++)
+      {
+        selective_bytes[b] = TRUE;
+      }
+    }
+  }
+
   // create the point reader
 
   laszip_dll->reader = new LASreadPoint(laszip_dll->las14_decompress_selective);
@@ -4404,6 +4924,17 @@ laszip_read_header(
     return 1;
   }
 
+  laszip_dll->reader->set_threads(laszip_dll->number_of_threads);
+  laszip_dll->reader->set_parallel_layers(laszip_dll->decompress_layers_in_parallel);
+  laszip_dll->reader->set_checkpoints(laszip_dll->seek_checkpoint_interval);
+  laszip_dll->reader->set_chunk_cache(laszip_dll->chunk_cache_max_bytes);
+
+  if (selective_bytes)
+  {
+    laszip_dll->reader->set_selective_bytes(num_selective_bytes, selective_bytes);
+    delete [] selective_bytes;
+  }
+
   if (!laszip_dll->reader->setup(laszip->num_items, laszip->items, laszip))
   {
     snprintf(laszip_dll->error, sizeof(laszip_dll->error), "setup of LASreadPoint failed");
@@ -4474,20 +5005,50 @@ laszip_open_reader(
       return 1;
     }
 
-    if (setvbuf(laszip_dll->file, NULL, _IOFBF, 262144) != 0)
+    // maybe map the file into memory
+
+    if (laszip_dll->request_memory_mapping)
     {
-      snprintf(laszip_dll->warning, sizeof(laszip_dll->warning), "setvbuf() failed with buffer size 262144\n");
-    }
+      ByteStreamInMmap* streaminmmap;
+      if (IS_LITTLE_ENDIAN())
+        streaminmmap = new ByteStreamInMmapLE(laszip_dll->file);
+      else
+        streaminmmap = new ByteStreamInMmapBE(laszip_dll->file);
 
-    if (IS_LITTLE_ENDIAN())
-      laszip_dll->streamin = new ByteStreamInFileLE(laszip_dll->file);
-    else
-      laszip_dll->streamin = new ByteStreamInFileBE(laszip_dll->file);
+      if (streaminmmap == 0)
+      {
+        snprintf(laszip_dll->error, sizeof(laszip_dll->error), "could not alloc ByteStreamInMmap");
+        return 1;
+      }
+
+      if (streaminmmap->isMapped())
+      {
+        laszip_dll->streamin = streaminmmap;
+      }
+      else
+      {
+        delete streaminmmap;
+        snprintf(laszip_dll->warning, sizeof(laszip_dll->warning), "cannot map file '%s' into memory. reading it with stdio instead.", file_name);
+      }
+    }
 
     if (laszip_dll->streamin == 0)
     {
-      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "could not alloc ByteStreamInFile");
-      return 1;
+      if (setvbuf(laszip_dll->file, NULL, _IOFBF, 262144) != 0)
+      {
+        snprintf(laszip_dll->warning, sizeof(laszip_dll->warning), "setvbuf() failed with buffer size 262144\n");
+      }
+
+      if (IS_LITTLE_ENDIAN())
+        laszip_dll->streamin = new ByteStreamInFileLE(laszip_dll->file);
+      else
+        laszip_dll->streamin = new ByteStreamInFileBE(laszip_dll->file);
+
+      if (laszip_dll->streamin == 0)
+      {
+        snprintf(laszip_dll->error, sizeof(laszip_dll->error), "could not alloc ByteStreamInFile");
+        return 1;
+      }
     }
 
     // read the header variable after variable
@@ -4697,6 +5258,49 @@ laszip_seek_point(
   return 0;
 }
 
+/*---------------------------------------------------------------------------*/
+static void
+laszip_instill_extended_attributes(
+    laszip_dll_struct*                 laszip_dll
+)
+{
+  I16 scan_angle_remainder;
+  U8 extended_returns;
+  U8 classification;
+  U8 flags_and_channel;
+  I32 return_number_increment;
+  I32 number_of_returns_increment;
+  I32 overlap_bit;
+  I32 scanner_channel;
+
+  // instill extended attributes
+  struct laszip_point* point = &laszip_dll->point;
+
+  // get extended attributes from extra bytes
+  scan_angle_remainder = *((I16*)(point->extra_bytes + laszip_dll->start_scan_angle));
+  extended_returns = point->extra_bytes[laszip_dll->start_extended_returns];
+  classification = point->extra_bytes[laszip_dll->start_classification];
+  flags_and_channel = point->extra_bytes[laszip_dll->start_flags_and_channel];
+  if (laszip_dll->start_NIR_band != -1)
+  {
+    point->rgb[3] = *((U16*)(point->extra_bytes + laszip_dll->start_NIR_band));
+  }
+
+  // decompose into individual attributes
+  return_number_increment = (extended_returns >> 4) & 0x0F;
+  number_of_returns_increment = extended_returns & 0x0F;
+  scanner_channel = (flags_and_channel >> 1) & 0x03;
+  overlap_bit = flags_and_channel & 0x01;
+
+  // instill into point
+  point->extended_scan_angle = scan_angle_remainder + I16_QUANTIZE(((F32)point->scan_angle_rank) / 0.006f);
+  point->extended_return_number = return_number_increment + point->return_number;
+  point->extended_number_of_returns = number_of_returns_increment + point->number_of_returns;
+  point->extended_classification = classification + point->classification;
+  point->extended_scanner_channel = scanner_channel;
+  point->extended_classification_flags = (overlap_bit << 3) | ((point->withheld_flag) << 2) | ((point->keypoint_flag) << 1) | (point->synthetic_flag);
+}
+
 /*---------------------------------------------------------------------------*/
 LASZIP_API laszip_I32
 laszip_read_point(
@@ -4719,41 +5323,7 @@ laszip_read_point(
 
     if (laszip_dll->compatibility_mode)
     {
-      I16 scan_angle_remainder;
-      U8 extended_returns;
-      U8 classification;
-      U8 flags_and_channel;
-      I32 return_number_increment;
-      I32 number_of_returns_increment;
-      I32 overlap_bit;
-      I32 scanner_channel;
-
-      // instill extended attributes
-      struct laszip_point* point = &laszip_dll->point;
-
-      // get extended attributes from extra bytes
-      scan_angle_remainder = *((I16*)(point->extra_bytes + laszip_dll->start_scan_angle));
-      extended_returns = point->extra_bytes[laszip_dll->start_extended_returns];
-      classification = point->extra_bytes[laszip_dll->start_classification];
-      flags_and_channel = point->extra_bytes[laszip_dll->start_flags_and_channel];
-      if (laszip_dll->start_NIR_band != -1)
-      {
-        point->rgb[3] = *((U16*)(point->extra_bytes + laszip_dll->start_NIR_band));
-      }
-
-      // decompose into individual attributes
-      return_number_increment = (extended_returns >> 4) & 0x0F;
-      number_of_returns_increment = extended_returns & 0x0F;
-      scanner_channel = (flags_and_channel >> 1) & 0x03;
-      overlap_bit = flags_and_channel & 0x01;
-
-      // instill into point
-      point->extended_scan_angle = scan_angle_remainder + I16_QUANTIZE(((F32)point->scan_angle_rank) / 0.006f);
-      point->extended_return_number = return_number_increment + point->return_number;
-      point->extended_number_of_returns = number_of_returns_increment + point->number_of_returns;
-      point->extended_classification = classification + point->classification;
-      point->extended_scanner_channel = scanner_channel;
-      point->extended_classification_flags = (overlap_bit << 3) | ((point->withheld_flag) << 2) | ((point->keypoint_flag) << 1) | (point->synthetic_flag);
+      laszip_instill_extended_attributes(laszip_dll);
     }
 
     laszip_dll->p_count++;
@@ -4770,9 +5340,9 @@ laszip_read_point(
 
 /*---------------------------------------------------------------------------*/
 LASZIP_API laszip_I32
-laszip_read_inside_point(
+laszip_decompress_selective_on_demand(
     laszip_POINTER                     pointer
-    , laszip_BOOL*                     is_done
+    , const laszip_U32                 decompress_selective
 )
 {
   if (pointer == 0) return 1;
@@ -4780,9 +5350,559 @@ laszip_read_inside_point(
 
   try
   {
-    laszip_F64 xy;
-
-    *is_done = 1;
+    if (laszip_dll->reader == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "decompressing on demand before reader was opened");
+      return 1;
+    }
+
+    if (laszip_dll->p_count == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "decompressing on demand before a point was read");
+      return 1;
+    }
+
+    if (!laszip_dll->reader->request_layers(decompress_selective, laszip_dll->point_items))
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "decompressing on demand at point %lld of %lld total points (not with threads, a chunk cache or an unseekable stream)", laszip_dll->p_count, laszip_dll->npoints);
+      return 1;
+    }
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_decompress_selective_on_demand");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_read_points(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 count
+    , laszip_point_struct*             points
+    , laszip_U32*                      read
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (read == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_U32 pointer 'read' is zero");
+      return 1;
+    }
+
+    *read = 0;
+
+    if ((points == 0) && count)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_point_struct pointer 'points' is zero");
+      return 1;
+    }
+
+    if (laszip_dll->reader == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading points before reader was opened");
+      return 1;
+    }
+
+    // do not read beyond the last point
+
+    U32 i, n = count;
+    if (laszip_dll->p_count >= laszip_dll->npoints)
+    {
+      n = 0;
+    }
+    else if ((laszip_dll->npoints - laszip_dll->p_count) < n)
+    {
+      n = (U32)(laszip_dll->npoints - laszip_dll->p_count);
+    }
+
+    const laszip_point_struct* point = &laszip_dll->point;
+
+    for (i = 0; i < n; i++)
+    {
+      // read the point
+      if (!laszip_dll->reader->read(laszip_dll->point_items))
+      {
+        snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading point %lld of %lld total points", laszip_dll->p_count, laszip_dll->npoints);
+        return 1;
+      }
+
+      // special recoding of points (in compatibility mode only)
+
+      if (laszip_dll->compatibility_mode)
+      {
+        laszip_instill_extended_attributes(laszip_dll);
+      }
+
+      laszip_dll->p_count++;
+
+      // copy the point but keep the extra bytes array of the caller (if any)
+
+      U8* extra_bytes = points[i].extra_bytes;
+      points[i] = *point;
+      points[i].extra_bytes = extra_bytes;
+      if (extra_bytes && point->num_extra_bytes)
+      {
+        memcpy(extra_bytes, point->extra_bytes, point->num_extra_bytes);
+      }
+
+      (*read)++;
+    }
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_read_points");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_read_packed_points(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 count
+    , laszip_U8*                       records
+    , laszip_U32*                      read
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (read == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_U32 pointer 'read' is zero");
+      return 1;
+    }
+
+    *read = 0;
+
+    if ((records == 0) && count)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_U8 pointer 'records' is zero");
+      return 1;
+    }
+
+    if (laszip_dll->reader == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading points before reader was opened");
+      return 1;
+    }
+
+    if (laszip_dll->compatibility_mode)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "packed point records are not supported in compatibility mode");
+      return 1;
+    }
+
+    // on first use create the raw writer that packs points into records
+
+    if (laszip_dll->point_packer == 0)
+    {
+      LASzip laszip;
+      if (!laszip.setup(laszip_dll->header.point_data_format, laszip_dll->header.point_data_record_length, LASZIP_COMPRESSOR_NONE))
+      {
+        snprintf(laszip_dll->error, sizeof(laszip_dll->error), "invalid combination of point_type %d and point_size %d", (I32)laszip_dll->header.point_data_format, (I32)laszip_dll->header.point_data_record_length);
+        return 1;
+      }
+
+      if (IS_LITTLE_ENDIAN())
+        laszip_dll->packed_stream = new ByteStreamOutArrayLE(laszip_dll->header.point_data_record_length);
+      else
+        laszip_dll->packed_stream = new ByteStreamOutArrayBE(laszip_dll->header.point_data_record_length);
+
+      laszip_dll->point_packer = new LASwritePoint();
+
+      if (!laszip_dll->point_packer->setup(laszip.num_items, laszip.items, &laszip) || !laszip_dll->point_packer->init(laszip_dll->packed_stream))
+      {
+        delete laszip_dll->point_packer;
+        laszip_dll->point_packer = 0;
+        snprintf(laszip_dll->error, sizeof(laszip_dll->error), "setup of point packer failed");
+        return 1;
+      }
+    }
+
+    // do not read beyond the last point
+
+    U32 i, n = count;
+    if (laszip_dll->p_count >= laszip_dll->npoints)
+    {
+      n = 0;
+    }
+    else if ((laszip_dll->npoints - laszip_dll->p_count) < n)
+    {
+      n = (U32)(laszip_dll->npoints - laszip_dll->p_count);
+    }
+
+    U32 record_length = laszip_dll->header.point_data_record_length;
+
+    for (i = 0; i < n; i++)
+    {
+      // read the point
+      if (!laszip_dll->reader->read(laszip_dll->point_items))
+      {
+        snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading point %lld of %lld total points", laszip_dll->p_count, laszip_dll->npoints);
+        return 1;
+      }
+
+      laszip_dll->p_count++;
+
+      // pack the point into a record
+
+      laszip_dll->packed_stream->seek(0);
+      if (!laszip_dll->point_packer->write(laszip_dll->point_items))
+      {
+        snprintf(laszip_dll->error, sizeof(laszip_dll->error), "packing point %lld of %lld total points", laszip_dll->p_count - 1, laszip_dll->npoints);
+        return 1;
+      }
+      memcpy(records + (size_t)i*record_length, laszip_dll->packed_stream->getData(), record_length);
+
+      (*read)++;
+    }
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_read_packed_points");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_read_columns(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 count
+    , const laszip_columns_struct*     columns
+    , laszip_U32*                      read
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (read == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_U32 pointer 'read' is zero");
+      return 1;
+    }
+
+    *read = 0;
+
+    if (columns == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_columns_struct pointer 'columns' is zero");
+      return 1;
+    }
+
+    if (laszip_dll->reader == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading points before reader was opened");
+      return 1;
+    }
+
+    // do not read beyond the last point
+
+    U32 i, n = count;
+    if (laszip_dll->p_count >= laszip_dll->npoints)
+    {
+      n = 0;
+    }
+    else if ((laszip_dll->npoints - laszip_dll->p_count) < n)
+    {
+      n = (U32)(laszip_dll->npoints - laszip_dll->p_count);
+    }
+
+    const laszip_point_struct* point = &laszip_dll->point;
+    const laszip_header_struct* header = &laszip_dll->header;
+    U32 num_extra_bytes = (point->num_extra_bytes > 0 ? (U32)point->num_extra_bytes : 0);
+
+    for (i = 0; i < n; i++)
+    {
+      // read the point
+      if (!laszip_dll->reader->read(laszip_dll->point_items))
+      {
+        snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading point %lld of %lld total points", laszip_dll->p_count, laszip_dll->npoints);
+        return 1;
+      }
+
+      // special recoding of points (in compatibility mode only)
+
+      if (laszip_dll->compatibility_mode)
+      {
+        laszip_instill_extended_attributes(laszip_dll);
+      }
+
+      laszip_dll->p_count++;
+
+      // scatter the attributes into the requested columns
+
+      if (columns->X) columns->X[i] = point->X;
+      if (columns->Y) columns->Y[i] = point->Y;
+      if (columns->Z) columns->Z[i] = point->Z;
+      if (columns->x) columns->x[i] = header->x_scale_factor*point->X+header->x_offset;
+      if (columns->y) columns->y[i] = header->y_scale_factor*point->Y+header->y_offset;
+      if (columns->z) columns->z[i] = header->z_scale_factor*point->Z+header->z_offset;
+      if (columns->intensity) columns->intensity[i] = point->intensity;
+      if (point->extended_point_type) // also set for points instilled in compatibility mode
+      {
+        if (columns->return_number) columns->return_number[i] = point->extended_return_number;
+        if (columns->number_of_returns) columns->number_of_returns[i] = point->extended_number_of_returns;
+        if (columns->classification) columns->classification[i] = point->extended_classification;
+        if (columns->scan_angle) columns->scan_angle[i] = point->extended_scan_angle;
+      }
+      else
+      {
+        if (columns->return_number) columns->return_number[i] = point->return_number;
+        if (columns->number_of_returns) columns->number_of_returns[i] = point->number_of_returns;
+        if (columns->classification) columns->classification[i] = point->classification;
+        if (columns->scan_angle) columns->scan_angle[i] = point->scan_angle_rank;
+      }
+      if (columns->user_data) columns->user_data[i] = point->user_data;
+      if (columns->point_source_ID) columns->point_source_ID[i] = point->point_source_ID;
+      if (columns->gps_time) columns->gps_time[i] = point->gps_time;
+      if (columns->R) columns->R[i] = point->rgb[0];
+      if (columns->G) columns->G[i] = point->rgb[1];
+      if (columns->B) columns->B[i] = point->rgb[2];
+      if (columns->NIR) columns->NIR[i] = point->rgb[3];
+      if (columns->extra_bytes && num_extra_bytes) memcpy(columns->extra_bytes + (size_t)i*num_extra_bytes, point->extra_bytes, num_extra_bytes);
+
+      (*read)++;
+    }
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_read_columns");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_get_chunk_count(
+    laszip_POINTER                     pointer
+    , laszip_U32*                      count
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (count == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_U32 pointer 'count' is zero");
+      return 1;
+    }
+
+    if (laszip_dll->reader == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is not open");
+      return 1;
+    }
+
+    if (!laszip_dll->reader->get_chunk_count(*count))
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "points are not compressed into chunks with a (complete) chunk table");
+      return 1;
+    }
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_get_chunk_count");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static BOOL
+laszip_get_chunk(
+    laszip_dll_struct*                 laszip_dll
+    , const U32                        index
+    , laszip_chunk_struct*             chunk
+)
+{
+  I64 first_point, byte_offset, byte_size;
+  U32 num_points;
+  if (!laszip_dll->reader->get_chunk_info(index, first_point, num_points, byte_offset, byte_size))
+  {
+    return FALSE;
+  }
+  chunk->first_point = first_point;
+  chunk->num_points = num_points;
+  chunk->byte_offset = byte_offset;
+  chunk->byte_size = byte_size;
+  // only the header knows how many points are in the last chunk
+  if ((chunk->first_point + chunk->num_points) > laszip_dll->npoints)
+  {
+    chunk->num_points = (U32)(laszip_dll->npoints > chunk->first_point ? laszip_dll->npoints - chunk->first_point : 0);
+  }
+  return TRUE;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_get_chunk_info(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 index
+    , laszip_I64*                      first_point
+    , laszip_U32*                      num_points
+    , laszip_I64*                      byte_offset
+    , laszip_I64*                      byte_size
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (laszip_dll->reader == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is not open");
+      return 1;
+    }
+
+    laszip_chunk_struct chunk;
+
+    if (!laszip_get_chunk(laszip_dll, index, &chunk))
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "no chunk with index %u in chunk table", index);
+      return 1;
+    }
+
+    if (first_point) *first_point = chunk.first_point;
+    if (num_points) *num_points = chunk.num_points;
+    if (byte_offset) *byte_offset = chunk.byte_offset;
+    if (byte_size) *byte_size = chunk.byte_size;
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_get_chunk_info");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_get_chunk_infos(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 index
+    , const laszip_U32                 count
+    , laszip_chunk_struct*             chunks
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (chunks == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_chunk_struct pointer 'chunks' is zero");
+      return 1;
+    }
+
+    if (laszip_dll->reader == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is not open");
+      return 1;
+    }
+
+    U32 i;
+    for (i = 0; i < count; i++)
+    {
+      if (!laszip_get_chunk(laszip_dll, index + i, &chunks[i]))
+      {
+        snprintf(laszip_dll->error, sizeof(laszip_dll->error), "no chunk with index %u in chunk table", index + i);
+        return 1;
+      }
+    }
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_get_chunk_infos");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_get_chunk_cache_stats(
+    laszip_POINTER                     pointer
+    , laszip_U64*                      hits
+    , laszip_U64*                      misses
+    , laszip_U64*                      bytes
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (laszip_dll->reader == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is not open");
+      return 1;
+    }
+
+    U64 cache_hits, cache_misses, cache_bytes;
+    laszip_dll->reader->get_chunk_cache_stats(cache_hits, cache_misses, cache_bytes);
+    if (hits) *hits = cache_hits;
+    if (misses) *misses = cache_misses;
+    if (bytes) *bytes = cache_bytes;
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_get_chunk_cache_stats");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_read_inside_point(
+    laszip_POINTER                     pointer
+    , laszip_BOOL*                     is_done
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    laszip_F64 xy;
+
+    *is_done = 1;
 
     if (laszip_dll->lax_index)
     {
@@ -4861,6 +5981,18 @@ laszip_close_reader(
     delete [] laszip_dll->point_items;
     laszip_dll->point_items = 0;
 
+    if (laszip_dll->point_packer)
+    {
+      delete laszip_dll->point_packer;
+      laszip_dll->point_packer = 0;
+    }
+
+    if (laszip_dll->packed_stream)
+    {
+      delete laszip_dll->packed_stream;
+      laszip_dll->packed_stream = 0;
+    }
+
     delete laszip_dll->streamin;
     laszip_dll->streamin = 0;
 
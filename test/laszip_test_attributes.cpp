@@ -0,0 +1,268 @@
+/*
+===============================================================================
+
+  FILE:  laszip_test_attributes.cpp
+
+  CONTENTS:
+
+    Regression test for compressing the extra bytes of LAS 1.4 points
+    attribute by attribute. It writes the point types 6 and 8 with 36 extra
+    bytes, of which 33 are described by attributes of every type from U8 to
+    F64 and 3 are not, once byte by byte and once with
+    'laszip_request_attribute_compression()'. Both files are read from
+    start to end and, with seek checkpoints, after seeks. Every point must
+    be identical, byte for byte, to the point read from the file compressed
+    byte by byte, and its extra bytes must be those that were written,
+    also for floats that are NaN, infinite, or negative zero.
+
+    usage:
+
+      laszip_test_attributes [file.laz]
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- created to round-trip extra bytes that are coded by attribute
+
+===============================================================================
+*/
+
+#include "laszip_api.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#include <vector>
+
+static const laszip_U32 NUM_POINTS = 20000;
+static const laszip_U32 CHUNK_SIZE = 3000;
+static const laszip_U32 NUM_EXTRA_BYTES = 36;
+
+static void make_point(laszip_point_struct* point, const laszip_U32 i)
+{
+  point->X = (laszip_I32)(i*3 + (i*7919)%50);
+  point->Y = (laszip_I32)(i*2 - (i*104729)%70);
+  point->Z = (laszip_I32)((i*31)%1000 + i/10);
+  point->intensity = (laszip_U16)((i*13)%4000);
+  point->user_data = (laszip_U8)((i/100)%7);
+  point->point_source_ID = (laszip_U16)(i/5000);
+  point->gps_time = 1000.0 + i*0.00001*(1 + (i/777)%3);
+  point->extended_point_type = 1;
+  point->extended_scanner_channel = (i/300)%4;
+  point->extended_number_of_returns = 1 + (i%5);
+  point->extended_return_number = 1 + (i/5)%point->extended_number_of_returns;
+  point->extended_classification = (laszip_U8)((i/50)%3 == 0 ? 40 + (i%10) : (i%12));
+  point->extended_classification_flags = (i%8);
+  point->synthetic_flag = (i%8) & 1;
+  point->keypoint_flag = ((i%8) >> 1) & 1;
+  point->withheld_flag = ((i%8) >> 2) & 1;
+  point->extended_scan_angle = (laszip_I16)((laszip_I32)((i*17)%6000) - 3000);
+  point->scan_direction_flag = (i/40)%2;
+  point->edge_of_flight_line = (i%40) == 0;
+  point->rgb[0] = (laszip_U16)((i*257)%65536);
+  point->rgb[1] = (laszip_U16)(point->rgb[0]/3);
+  point->rgb[2] = (laszip_U16)(i%256);
+  point->rgb[3] = (laszip_U16)(i%1000);
+}
+
+// the attributes at offsets 0, 1, 3, 5, 9, 13, 17, and 25 followed by three
+// bytes without a descriptor
+
+static void make_extra_bytes(laszip_U8* extra_bytes, const laszip_U32 i)
+{
+  laszip_U8 u8 = (laszip_U8)(i/100);
+  laszip_I16 i16 = (laszip_I16)((laszip_I32)((i*7919)%400) - 200);
+  laszip_U16 u16 = (laszip_U16)(i/3);
+  laszip_I32 i32 = (laszip_I32)(i*17) - 100000 + (laszip_I32)((i*104729)%100);
+  laszip_U32 u32 = (i*2654435761u)%100000;
+  laszip_F32 f32 = 100.0f + ((i*7919)%10000)*0.01f;
+  laszip_F64 f64 = 1e5 + i*0.001;
+  laszip_I64 i64 = (laszip_I64)i*1000 - 5000000 + (laszip_I64)(i%10);
+  if (i%997 == 1)
+  {
+    f32 = -0.0f;
+    f64 = -0.0;
+  }
+  else if (i%997 == 2)
+  {
+    u32 = 0xFFFFFFFF;
+    memset(&f32, 0xFF, 4); // a NaN
+    memset(&f64, 0xFF, 8);
+  }
+  else if (i%997 == 3)
+  {
+    f32 = 1e30f*1e30f; // infinite
+    f64 = -1e300*1e300;
+  }
+  memcpy(extra_bytes + 0, &u8, 1);
+  memcpy(extra_bytes + 1, &i16, 2);
+  memcpy(extra_bytes + 3, &u16, 2);
+  memcpy(extra_bytes + 5, &i32, 4);
+  memcpy(extra_bytes + 9, &u32, 4);
+  memcpy(extra_bytes + 13, &f32, 4);
+  memcpy(extra_bytes + 17, &f64, 8);
+  memcpy(extra_bytes + 25, &i64, 8);
+  extra_bytes[33] = (laszip_U8)(i%4);
+  extra_bytes[34] = 7;
+  extra_bytes[35] = (laszip_U8)i;
+}
+
+static int fail(laszip_POINTER laszip, const char* what)
+{
+  laszip_CHAR* error;
+  laszip_get_error(laszip, &error);
+  fprintf(stderr, "%s: %s\n", what, (error ? error : "no error message"));
+  return 1;
+}
+
+static int write_file(const char* file_name, const laszip_U8 point_type, const laszip_BOOL by_attribute)
+{
+  laszip_POINTER laszip;
+  if (laszip_create(&laszip)) return 1;
+  laszip_header_struct* header;
+  laszip_get_header_pointer(laszip, &header);
+  header->version_major = 1;
+  header->version_minor = 4;
+  header->header_size = 375;
+  header->offset_to_point_data = 375;
+  header->point_data_format = point_type;
+  header->point_data_record_length = (point_type == 6 ? 30 : 38) + NUM_EXTRA_BYTES;
+  header->extended_number_of_point_records = NUM_POINTS;
+  header->x_scale_factor = header->y_scale_factor = header->z_scale_factor = 0.01;
+  // the LAS data types minus one: U8, I16, U16, I32, U32, F32, F64, and I64
+  static const laszip_U32 types[] = { 0, 3, 2, 5, 4, 8, 9, 7 };
+  static const laszip_CHAR* names[] = { "u8", "i16", "u16", "i32", "u32", "f32", "f64", "i64" };
+  laszip_U32 a;
+  for (a = 0; a < sizeof(types)/sizeof(types[0]); a++)
+  {
+    if (laszip_add_attribute(laszip, types[a], names[a], names[a], 1.0, 0.0)) return fail(laszip, "add_attribute");
+  }
+  if (laszip_request_native_extension(laszip, 1)) return fail(laszip, "request_native_extension");
+  if (laszip_set_chunk_size(laszip, CHUNK_SIZE)) return fail(laszip, "set_chunk_size");
+  if (by_attribute && laszip_request_attribute_compression(laszip, 1)) return fail(laszip, "request_attribute_compression");
+  if (laszip_open_writer(laszip, file_name, 1)) return fail(laszip, "open_writer");
+  laszip_point_struct* point;
+  laszip_get_point_pointer(laszip, &point);
+  if (point->num_extra_bytes != (laszip_I32)NUM_EXTRA_BYTES)
+  {
+    fprintf(stderr, "point has %d instead of %u extra bytes\n", point->num_extra_bytes, NUM_EXTRA_BYTES);
+    return 1;
+  }
+  laszip_U32 i;
+  for (i = 0; i < NUM_POINTS; i++)
+  {
+    make_point(point, i);
+    if (point_type == 6) memset(point->rgb, 0, sizeof(point->rgb));
+    make_extra_bytes(point->extra_bytes, i);
+    if (laszip_write_point(laszip)) return fail(laszip, "write_point");
+  }
+  if (laszip_close_writer(laszip)) return fail(laszip, "close_writer");
+  laszip_destroy(laszip);
+  return 0;
+}
+
+static int same_point(const laszip_point_struct* a, const laszip_point_struct* b)
+{
+  // every field up to the extra bytes, also those that the point type does not
+  // have, but not the 'dummy' bytes that the reader uses for itself
+  if (memcmp(a, b, offsetof(laszip_point_struct, dummy))) return 0;
+  return (memcmp(&a->gps_time, &b->gps_time, offsetof(laszip_point_struct, num_extra_bytes) - offsetof(laszip_point_struct, gps_time)) == 0);
+}
+
+// compares the point (without its extra bytes) to 'reference' if there is one
+// and its extra bytes to those written for point 'i'
+
+static int check_point(const laszip_point_struct* point, const laszip_point_struct* reference, const laszip_U32 i)
+{
+  laszip_U8 extra_bytes[NUM_EXTRA_BYTES];
+  make_extra_bytes(extra_bytes, i);
+  if (point->num_extra_bytes != (laszip_I32)NUM_EXTRA_BYTES) return 0;
+  if (memcmp(point->extra_bytes, extra_bytes, NUM_EXTRA_BYTES)) return 0;
+  return (reference ? same_point(point, reference) : 1);
+}
+
+static int test_file(const char* file_name, const laszip_U8 point_type, const laszip_BOOL by_attribute, std::vector<laszip_point_struct>& reference)
+{
+  const char* coding = (by_attribute ? "attribute" : "byte");
+  if (write_file(file_name, point_type, by_attribute)) return 1;
+
+  laszip_POINTER laszip;
+  if (laszip_create(&laszip)) return 1;
+  if (laszip_set_seek_checkpoints(laszip, 500)) return fail(laszip, "set_seek_checkpoints");
+  laszip_BOOL is_compressed;
+  if (laszip_open_reader(laszip, file_name, &is_compressed)) return fail(laszip, "open_reader");
+  laszip_point_struct* point;
+  laszip_get_point_pointer(laszip, &point);
+
+  // the points read from the file compressed byte by byte are the reference
+
+  int errors = 0;
+  laszip_U32 i;
+  if (!by_attribute) reference.resize(NUM_POINTS);
+  for (i = 0; i < NUM_POINTS; i++)
+  {
+    if (laszip_read_point(laszip)) return fail(laszip, "read_point");
+    if (!check_point(point, (by_attribute ? &reference[i] : 0), i))
+    {
+      if (errors++ < 5) fprintf(stderr, "point type %d: point %u coded by %s differs\n", point_type, i, coding);
+    }
+    if (!by_attribute) reference[i] = *point;
+  }
+
+  static const laszip_U32 targets[] = { 1, CHUNK_SIZE - 1, CHUNK_SIZE + 501, 5*CHUNK_SIZE + 123, 2*CHUNK_SIZE, NUM_POINTS - 1, 7 };
+  laszip_U32 t;
+  for (t = 0; t < sizeof(targets)/sizeof(targets[0]); t++)
+  {
+    if (laszip_seek_point(laszip, targets[t])) return fail(laszip, "seek_point");
+    for (i = targets[t]; (i < targets[t] + 200) && (i < NUM_POINTS); i++)
+    {
+      if (laszip_read_point(laszip)) return fail(laszip, "read_point after seek");
+      if (!check_point(point, &reference[i], i))
+      {
+        if (errors++ < 5) fprintf(stderr, "point type %d: point %u coded by %s read after a seek to %u differs\n", point_type, i, coding, targets[t]);
+      }
+    }
+  }
+
+  laszip_close_reader(laszip);
+  laszip_destroy(laszip);
+  return (errors ? 1 : 0);
+}
+
+int main(int argc, char* argv[])
+{
+  const char* file_name = (argc > 1 ? argv[1] : "laszip_test_attributes.laz");
+  static const laszip_U8 point_types[] = { 6, 8 };
+  int errors = 0;
+  laszip_U32 t;
+  for (t = 0; t < sizeof(point_types)/sizeof(point_types[0]); t++)
+  {
+    std::vector<laszip_point_struct> reference;
+    if (test_file(file_name, point_types[t], 0, reference)) return 1;
+    errors += test_file(file_name, point_types[t], 1, reference);
+  }
+  remove(file_name);
+  if (errors)
+  {
+    fprintf(stderr, "FAILED for %d point type(s)\n", errors);
+    return 1;
+  }
+  fprintf(stderr, "extra bytes coded by attribute are identical to those coded by byte\n");
+  return 0;
+}
@@ -0,0 +1,210 @@
+/*
+===============================================================================
+
+  FILE:  laszip_test_bitpacked.cpp
+
+  CONTENTS:
+
+    Regression test for the bit-packed compressor with LAS 1.4 points. It
+    writes the point types 6, 7, and 8 once with the default (arithmetic)
+    compressor and once bit-packed, with legacy fields that the writer is
+    handed stale, and reads both back. Every point read from the bit-packed
+    file must be identical, byte for byte and including the legacy return
+    counts, classification, and scan angle rank that a reader derives from
+    the extended fields, to the point read from the arithmetic file. The
+    bit-packed compressor used to store the stale legacy bytes instead.
+
+    usage:
+
+      laszip_test_bitpacked [file.laz]
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- created to catch stale legacy fields in bit-packed points
+
+===============================================================================
+*/
+
+#include "laszip_api.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#include <vector>
+
+static const laszip_U32 NUM_POINTS = 20000;
+static const laszip_U32 CHUNK_SIZE = 3000;
+
+static void make_point(laszip_point_struct* point, const laszip_U32 i)
+{
+  point->X = (laszip_I32)(i*3 + (i*7919)%50);
+  point->Y = (laszip_I32)(i*2 - (i*104729)%70);
+  point->Z = (laszip_I32)((i*31)%1000 + i/10);
+  point->intensity = (laszip_U16)((i*13)%4000);
+  point->user_data = (laszip_U8)((i/100)%7);
+  point->point_source_ID = (laszip_U16)(i/5000);
+  point->gps_time = 1000.0 + i*0.00001*(1 + (i/777)%3);
+  point->extended_point_type = 1;
+  point->extended_scanner_channel = (i/300)%4;
+  // also more than the 7 returns that the legacy fields can hold
+  point->extended_number_of_returns = 1 + (i%11);
+  point->extended_return_number = 1 + (i/11)%point->extended_number_of_returns;
+  point->extended_classification = (laszip_U8)((i/50)%3 == 0 ? 40 + (i%10) : (i%12));
+  point->extended_classification_flags = (i%8);
+  point->synthetic_flag = (i%8) & 1;
+  point->keypoint_flag = ((i%8) >> 1) & 1;
+  point->withheld_flag = ((i%8) >> 2) & 1;
+  point->extended_scan_angle = (laszip_I16)((laszip_I32)((i*17)%6000) - 3000);
+  point->scan_direction_flag = (i/40)%2;
+  point->edge_of_flight_line = (i%40) == 0;
+  // stale legacy fields that the writer is not expected to store
+  point->return_number = (i%3);
+  point->number_of_returns = 0;
+  point->classification = 0;
+  point->scan_angle_rank = 0;
+  point->rgb[0] = (laszip_U16)((i*257)%65536);
+  point->rgb[1] = (laszip_U16)(point->rgb[0]/3);
+  point->rgb[2] = (laszip_U16)(i%256);
+  point->rgb[3] = (laszip_U16)(i%1000);
+}
+
+static int fail(laszip_POINTER laszip, const char* what)
+{
+  laszip_CHAR* error;
+  laszip_get_error(laszip, &error);
+  fprintf(stderr, "%s: %s\n", what, (error ? error : "no error message"));
+  return 1;
+}
+
+static int write_file(const char* file_name, const laszip_U8 point_type, const laszip_BOOL bitpacked)
+{
+  static const laszip_U16 record_lengths[] = { 30, 36, 38 };
+  laszip_POINTER laszip;
+  if (laszip_create(&laszip)) return 1;
+  laszip_header_struct* header;
+  laszip_get_header_pointer(laszip, &header);
+  header->version_major = 1;
+  header->version_minor = 4;
+  header->header_size = 375;
+  header->offset_to_point_data = 375;
+  header->point_data_format = point_type;
+  header->point_data_record_length = record_lengths[point_type - 6];
+  header->extended_number_of_point_records = NUM_POINTS;
+  header->x_scale_factor = header->y_scale_factor = header->z_scale_factor = 0.01;
+  if (laszip_request_native_extension(laszip, 1)) return fail(laszip, "request_native_extension");
+  if (laszip_set_chunk_size(laszip, CHUNK_SIZE)) return fail(laszip, "set_chunk_size");
+  if (bitpacked && laszip_request_bitpacked_compression(laszip, 1)) return fail(laszip, "request_bitpacked_compression");
+  if (laszip_open_writer(laszip, file_name, 1)) return fail(laszip, "open_writer");
+  laszip_point_struct* point;
+  laszip_get_point_pointer(laszip, &point);
+  laszip_U32 i;
+  for (i = 0; i < NUM_POINTS; i++)
+  {
+    make_point(point, i);
+    if (point_type == 6) memset(point->rgb, 0, sizeof(point->rgb));
+    else if (point_type == 7) point->rgb[3] = 0;
+    if (laszip_write_point(laszip)) return fail(laszip, "write_point");
+  }
+  if (laszip_close_writer(laszip)) return fail(laszip, "close_writer");
+  laszip_destroy(laszip);
+  return 0;
+}
+
+static int read_file(const char* file_name, std::vector<laszip_point_struct>& points)
+{
+  laszip_POINTER laszip;
+  if (laszip_create(&laszip)) return 1;
+  laszip_BOOL is_compressed;
+  if (laszip_open_reader(laszip, file_name, &is_compressed)) return fail(laszip, "open_reader");
+  laszip_point_struct* point;
+  laszip_get_point_pointer(laszip, &point);
+  points.resize(NUM_POINTS);
+  laszip_U32 i;
+  for (i = 0; i < NUM_POINTS; i++)
+  {
+    if (laszip_read_point(laszip)) return fail(laszip, "read_point");
+    points[i] = *point;
+  }
+  laszip_close_reader(laszip);
+  laszip_destroy(laszip);
+  return 0;
+}
+
+static int same_point(const laszip_point_struct* a, const laszip_point_struct* b)
+{
+  // every field up to the extra bytes, also those that the point type does not
+  // have, but not the 'dummy' bytes that the reader uses for itself
+  if (memcmp(a, b, offsetof(laszip_point_struct, dummy))) return 0;
+  return (memcmp(&a->gps_time, &b->gps_time, offsetof(laszip_point_struct, num_extra_bytes) - offsetof(laszip_point_struct, gps_time)) == 0);
+}
+
+static int test_bitpacked(const char* file_name, const laszip_U8 point_type)
+{
+  std::vector<laszip_point_struct> arithmetic;
+  std::vector<laszip_point_struct> bitpacked;
+  if (write_file(file_name, point_type, 0)) return 1;
+  if (read_file(file_name, arithmetic)) return 1;
+  if (write_file(file_name, point_type, 1)) return 1;
+  if (read_file(file_name, bitpacked)) return 1;
+
+  int errors = 0;
+  laszip_U32 i;
+  for (i = 0; i < NUM_POINTS; i++)
+  {
+    const laszip_point_struct* a = &arithmetic[i];
+    const laszip_point_struct* b = &bitpacked[i];
+    if (a->scan_angle_rank != b->scan_angle_rank)
+    {
+      if (errors++ < 5) fprintf(stderr, "point type %d: point %u has scan angle rank %d instead of %d\n", point_type, i, b->scan_angle_rank, a->scan_angle_rank);
+    }
+    else if (a->classification != b->classification)
+    {
+      if (errors++ < 5) fprintf(stderr, "point type %d: point %u has legacy classification %d instead of %d\n", point_type, i, b->classification, a->classification);
+    }
+    else if ((a->return_number != b->return_number) || (a->number_of_returns != b->number_of_returns))
+    {
+      if (errors++ < 5) fprintf(stderr, "point type %d: point %u has legacy return %d of %d instead of %d of %d\n", point_type, i, b->return_number, b->number_of_returns, a->return_number, a->number_of_returns);
+    }
+    else if (!same_point(a, b))
+    {
+      if (errors++ < 5) fprintf(stderr, "point type %d: point %u differs\n", point_type, i);
+    }
+  }
+  return (errors ? 1 : 0);
+}
+
+int main(int argc, char* argv[])
+{
+  const char* file_name = (argc > 1 ? argv[1] : "laszip_test_bitpacked.laz");
+  int errors = 0;
+  laszip_U8 point_type;
+  for (point_type = 6; point_type <= 8; point_type++)
+  {
+    errors += test_bitpacked(file_name, point_type);
+  }
+  remove(file_name);
+  if (errors)
+  {
+    fprintf(stderr, "FAILED for %d point type(s)\n", errors);
+    return 1;
+  }
+  fprintf(stderr, "bit-packed points are identical to arithmetic ones\n");
+  return 0;
+}
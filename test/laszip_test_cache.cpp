@@ -0,0 +1,244 @@
+/*
+===============================================================================
+
+  FILE:  laszip_test_cache.cpp
+
+  CONTENTS:
+
+    Regression test for random access with the chunk cache and the seek
+    checkpoints. It writes the point types 1, 6, and 8 and reads each file
+    from start to end. It then reads it again with the chunk cache, with
+    the seek checkpoints, and with both, seeking back and forth so that
+    chunks are revisited and seeks land between checkpoints. Every point
+    read after a seek must be identical, byte for byte, to the point read
+    from start to end, and the cache must have been hit.
+
+    usage:
+
+      laszip_test_cache [file.laz]
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- created to check cached and checkpointed seeks against a full read
+
+===============================================================================
+*/
+
+#include "laszip_api.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#include <vector>
+
+static const laszip_U32 NUM_POINTS = 20000;
+static const laszip_U32 CHUNK_SIZE = 3000;
+
+static void make_point(laszip_point_struct* point, const laszip_U8 point_type, const laszip_U32 i)
+{
+  point->X = (laszip_I32)(i*3 + (i*7919)%50);
+  point->Y = (laszip_I32)(i*2 - (i*104729)%70);
+  point->Z = (laszip_I32)((i*31)%1000 + i/10);
+  point->intensity = (laszip_U16)((i*13)%4000);
+  point->user_data = (laszip_U8)((i/100)%7);
+  point->point_source_ID = (laszip_U16)(i/5000);
+  point->gps_time = 1000.0 + i*0.00001*(1 + (i/777)%3);
+  point->scan_direction_flag = (i/40)%2;
+  point->edge_of_flight_line = (i%40) == 0;
+  point->synthetic_flag = (i%8) & 1;
+  point->keypoint_flag = ((i%8) >> 1) & 1;
+  point->withheld_flag = ((i%8) >> 2) & 1;
+  if (point_type < 6)
+  {
+    point->number_of_returns = 1 + (i%5);
+    point->return_number = 1 + (i/5)%point->number_of_returns;
+    point->classification = (laszip_U8)(i%12);
+    point->scan_angle_rank = (laszip_I8)((laszip_I32)((i*17)%180) - 90);
+  }
+  else
+  {
+    point->extended_point_type = 1;
+    point->extended_scanner_channel = (i/300)%4;
+    point->extended_number_of_returns = 1 + (i%5);
+    point->extended_return_number = 1 + (i/5)%point->extended_number_of_returns;
+    point->extended_classification = (laszip_U8)((i/50)%3 == 0 ? 40 + (i%10) : (i%12));
+    point->extended_classification_flags = (i%8);
+    point->extended_scan_angle = (laszip_I16)((laszip_I32)((i*17)%6000) - 3000);
+  }
+  if ((point_type == 3) || (point_type == 7) || (point_type == 8))
+  {
+    point->rgb[0] = (laszip_U16)((i*257)%65536);
+    point->rgb[1] = (laszip_U16)(point->rgb[0]/3);
+    point->rgb[2] = (laszip_U16)(i%256);
+  }
+  if (point_type == 8)
+  {
+    point->rgb[3] = (laszip_U16)(i%1000);
+  }
+}
+
+static int fail(laszip_POINTER laszip, const char* what)
+{
+  laszip_CHAR* error;
+  laszip_get_error(laszip, &error);
+  fprintf(stderr, "%s: %s\n", what, (error ? error : "no error message"));
+  return 1;
+}
+
+static int write_file(const char* file_name, const laszip_U8 point_type)
+{
+  laszip_POINTER laszip;
+  if (laszip_create(&laszip)) return 1;
+  laszip_header_struct* header;
+  laszip_get_header_pointer(laszip, &header);
+  header->version_major = 1;
+  header->point_data_format = point_type;
+  if (point_type < 6)
+  {
+    header->version_minor = 2;
+    header->header_size = 227;
+    header->offset_to_point_data = 227;
+    header->point_data_record_length = (point_type == 1 ? 28 : 34);
+    header->number_of_point_records = NUM_POINTS;
+  }
+  else
+  {
+    header->version_minor = 4;
+    header->header_size = 375;
+    header->offset_to_point_data = 375;
+    header->point_data_record_length = (point_type == 6 ? 30 : (point_type == 7 ? 36 : 38));
+    header->extended_number_of_point_records = NUM_POINTS;
+  }
+  header->x_scale_factor = header->y_scale_factor = header->z_scale_factor = 0.01;
+  if ((point_type >= 6) && laszip_request_native_extension(laszip, 1)) return fail(laszip, "request_native_extension");
+  if (laszip_set_chunk_size(laszip, CHUNK_SIZE)) return fail(laszip, "set_chunk_size");
+  if (laszip_open_writer(laszip, file_name, 1)) return fail(laszip, "open_writer");
+  laszip_point_struct* point;
+  laszip_get_point_pointer(laszip, &point);
+  laszip_U32 i;
+  for (i = 0; i < NUM_POINTS; i++)
+  {
+    make_point(point, point_type, i);
+    if (laszip_write_point(laszip)) return fail(laszip, "write_point");
+  }
+  if (laszip_close_writer(laszip)) return fail(laszip, "close_writer");
+  laszip_destroy(laszip);
+  return 0;
+}
+
+static int read_file(const char* file_name, std::vector<laszip_point_struct>& points)
+{
+  laszip_POINTER laszip;
+  if (laszip_create(&laszip)) return 1;
+  laszip_BOOL is_compressed;
+  if (laszip_open_reader(laszip, file_name, &is_compressed)) return fail(laszip, "open_reader");
+  laszip_point_struct* point;
+  laszip_get_point_pointer(laszip, &point);
+  points.resize(NUM_POINTS);
+  laszip_U32 i;
+  for (i = 0; i < NUM_POINTS; i++)
+  {
+    if (laszip_read_point(laszip)) return fail(laszip, "read_point");
+    points[i] = *point;
+  }
+  laszip_close_reader(laszip);
+  laszip_destroy(laszip);
+  return 0;
+}
+
+static int same_point(const laszip_point_struct* a, const laszip_point_struct* b)
+{
+  // every field up to the extra bytes, also those that the point type does not
+  // have, but not the 'dummy' bytes that the reader uses for itself
+  if (memcmp(a, b, offsetof(laszip_point_struct, dummy))) return 0;
+  return (memcmp(&a->gps_time, &b->gps_time, offsetof(laszip_point_struct, num_extra_bytes) - offsetof(laszip_point_struct, gps_time)) == 0);
+}
+
+static int test_seeks(const char* file_name, const laszip_U8 point_type, const std::vector<laszip_point_struct>& points, const laszip_U64 cache_bytes, const laszip_U32 checkpoint_interval)
+{
+  laszip_POINTER laszip;
+  if (laszip_create(&laszip)) return 1;
+  if (cache_bytes && laszip_set_chunk_cache(laszip, cache_bytes)) return fail(laszip, "set_chunk_cache");
+  if (checkpoint_interval && laszip_set_seek_checkpoints(laszip, checkpoint_interval)) return fail(laszip, "set_seek_checkpoints");
+  laszip_BOOL is_compressed;
+  if (laszip_open_reader(laszip, file_name, &is_compressed)) return fail(laszip, "open_reader");
+  laszip_point_struct* point;
+  laszip_get_point_pointer(laszip, &point);
+
+  // back and forth over six chunks to the points at, right after, and right
+  // before a checkpoint (if there are any every 500 points) and to the last
+
+  static const laszip_U32 offsets[] = { 0, 1, 499 };
+  int errors = 0;
+  laszip_U32 i, t;
+  for (t = 0; t < 60; t++)
+  {
+    laszip_U32 target = (t == 59 ? NUM_POINTS - 1 : ((t*7)%6)*CHUNK_SIZE + ((t*5)%6)*500 + offsets[t%3]);
+    if (laszip_seek_point(laszip, target)) return fail(laszip, "seek_point");
+    for (i = target; (i < target + 100) && (i < NUM_POINTS); i++)
+    {
+      if (laszip_read_point(laszip)) return fail(laszip, "read_point after seek");
+      if (!same_point(point, &points[i]))
+      {
+        if (errors++ < 5) fprintf(stderr, "point type %d: point %u read after a seek to %u differs (cache %u bytes, checkpoints every %u points)\n", point_type, i, target, (laszip_U32)cache_bytes, checkpoint_interval);
+      }
+    }
+  }
+
+  if (cache_bytes)
+  {
+    laszip_U64 hits, misses, bytes;
+    if (laszip_get_chunk_cache_stats(laszip, &hits, &misses, &bytes)) return fail(laszip, "get_chunk_cache_stats");
+    if (hits == 0)
+    {
+      fprintf(stderr, "point type %d: the chunk cache was never hit (%u misses)\n", point_type, (laszip_U32)misses);
+      errors++;
+    }
+  }
+
+  laszip_close_reader(laszip);
+  laszip_destroy(laszip);
+  return (errors ? 1 : 0);
+}
+
+int main(int argc, char* argv[])
+{
+  const char* file_name = (argc > 1 ? argv[1] : "laszip_test_cache.laz");
+  static const laszip_U8 point_types[] = { 1, 6, 8 };
+  int errors = 0;
+  laszip_U32 t;
+  for (t = 0; t < sizeof(point_types)/sizeof(point_types[0]); t++)
+  {
+    std::vector<laszip_point_struct> points;
+    if (write_file(file_name, point_types[t])) return 1;
+    if (read_file(file_name, points)) return 1;
+    errors += test_seeks(file_name, point_types[t], points, 4*1024*1024, 0);
+    errors += test_seeks(file_name, point_types[t], points, 0, 500);
+    errors += test_seeks(file_name, point_types[t], points, 4*1024*1024, 500);
+  }
+  remove(file_name);
+  if (errors)
+  {
+    fprintf(stderr, "FAILED for %d combination(s)\n", errors);
+    return 1;
+  }
+  fprintf(stderr, "all points read with cache and checkpoints are identical\n");
+  return 0;
+}
@@ -0,0 +1,289 @@
+/*
+===============================================================================
+
+  FILE:  laszip_test_read_columns.cpp
+
+  CONTENTS:
+
+    Regression test for reading points into columns. It writes the point
+    types 1, 3, 6, and 8 with two extra bytes, and the point type 6 also in
+    compatibility mode, and reads each file point by point with
+    'laszip_read_point()' and in batches with 'laszip_read_columns()'. Every
+    column must hold the field of the point read alone, the extended return
+    numbers, classification, and scan angle for the point types 6 and
+    higher (also in compatibility mode) and the legacy ones otherwise.
+
+    usage:
+
+      laszip_test_read_columns [file.laz]
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- created to compare columns with reading point by point
+
+===============================================================================
+*/
+
+#include "laszip_api.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#include <vector>
+
+static const laszip_U32 NUM_POINTS = 20000;
+static const laszip_U32 CHUNK_SIZE = 3000;
+static const laszip_U32 BATCH_SIZE = 777;
+static const laszip_U32 NUM_EXTRA_BYTES = 2;
+
+static void make_point(laszip_point_struct* point, const laszip_U8 point_type, const laszip_U32 i)
+{
+  point->X = (laszip_I32)(i*3 + (i*7919)%50);
+  point->Y = (laszip_I32)(i*2 - (i*104729)%70);
+  point->Z = (laszip_I32)((i*31)%1000 + i/10);
+  point->intensity = (laszip_U16)((i*13)%4000);
+  point->user_data = (laszip_U8)((i/100)%7);
+  point->point_source_ID = (laszip_U16)(i/5000);
+  point->gps_time = 1000.0 + i*0.00001*(1 + (i/777)%3);
+  point->scan_direction_flag = (i/40)%2;
+  point->edge_of_flight_line = (i%40) == 0;
+  point->synthetic_flag = (i%8) & 1;
+  point->keypoint_flag = ((i%8) >> 1) & 1;
+  point->withheld_flag = ((i%8) >> 2) & 1;
+  if (point_type < 6)
+  {
+    point->number_of_returns = 1 + (i%5);
+    point->return_number = 1 + (i/5)%point->number_of_returns;
+    point->classification = (laszip_U8)(i%12);
+    point->scan_angle_rank = (laszip_I8)((laszip_I32)((i*17)%180) - 90);
+  }
+  else
+  {
+    point->extended_point_type = 1;
+    point->extended_scanner_channel = (i/300)%4;
+    point->extended_number_of_returns = 1 + (i%5);
+    point->extended_return_number = 1 + (i/5)%point->extended_number_of_returns;
+    point->extended_classification = (laszip_U8)((i/50)%3 == 0 ? 40 + (i%10) : (i%12));
+    point->extended_classification_flags = (i%8);
+    point->extended_scan_angle = (laszip_I16)((laszip_I32)((i*17)%6000) - 3000);
+  }
+  if ((point_type == 3) || (point_type == 7) || (point_type == 8))
+  {
+    point->rgb[0] = (laszip_U16)((i*257)%65536);
+    point->rgb[1] = (laszip_U16)(point->rgb[0]/3);
+    point->rgb[2] = (laszip_U16)(i%256);
+  }
+  if (point_type == 8)
+  {
+    point->rgb[3] = (laszip_U16)(i%1000);
+  }
+}
+
+static int fail(laszip_POINTER laszip, const char* what)
+{
+  laszip_CHAR* error;
+  laszip_get_error(laszip, &error);
+  fprintf(stderr, "%s: %s\n", what, (error ? error : "no error message"));
+  return 1;
+}
+
+static int write_file(const char* file_name, const laszip_U8 point_type, const laszip_BOOL compatible)
+{
+  laszip_POINTER laszip;
+  if (laszip_create(&laszip)) return 1;
+  laszip_header_struct* header;
+  laszip_get_header_pointer(laszip, &header);
+  header->version_major = 1;
+  header->point_data_format = point_type;
+  if (point_type < 6)
+  {
+    header->version_minor = 2;
+    header->header_size = 227;
+    header->offset_to_point_data = 227;
+    header->point_data_record_length = (point_type == 1 ? 28 : 34) + NUM_EXTRA_BYTES;
+    header->number_of_point_records = NUM_POINTS;
+  }
+  else
+  {
+    header->version_minor = 4;
+    header->header_size = 375;
+    header->offset_to_point_data = 375;
+    header->point_data_record_length = (point_type == 6 ? 30 : 38) + NUM_EXTRA_BYTES;
+    header->extended_number_of_point_records = NUM_POINTS;
+  }
+  header->x_scale_factor = header->y_scale_factor = header->z_scale_factor = 0.01;
+  if (laszip_add_attribute(laszip, 2, "u16", "u16", 1.0, 0.0)) return fail(laszip, "add_attribute");
+  if (compatible)
+  {
+    if (laszip_request_compatibility_mode(laszip, 1)) return fail(laszip, "request_compatibility_mode");
+  }
+  else if ((point_type >= 6) && laszip_request_native_extension(laszip, 1)) return fail(laszip, "request_native_extension");
+  if (laszip_set_chunk_size(laszip, CHUNK_SIZE)) return fail(laszip, "set_chunk_size");
+  if (laszip_open_writer(laszip, file_name, 1)) return fail(laszip, "open_writer");
+  laszip_point_struct* point;
+  laszip_get_point_pointer(laszip, &point);
+  laszip_U32 i;
+  for (i = 0; i < NUM_POINTS; i++)
+  {
+    make_point(point, point_type, i);
+    point->extra_bytes[0] = (laszip_U8)(i%251);
+    point->extra_bytes[1] = (laszip_U8)(i/251);
+    if (laszip_write_point(laszip)) return fail(laszip, "write_point");
+  }
+  if (laszip_close_writer(laszip)) return fail(laszip, "close_writer");
+  laszip_destroy(laszip);
+  return 0;
+}
+
+static int test_read_columns(const char* file_name, const laszip_U8 point_type, const laszip_BOOL compatible)
+{
+  if (write_file(file_name, point_type, compatible)) return 1;
+
+  // point by point
+
+  laszip_POINTER laszip;
+  if (laszip_create(&laszip)) return 1;
+  if (compatible && laszip_request_compatibility_mode(laszip, 1)) return fail(laszip, "request_compatibility_mode");
+  laszip_BOOL is_compressed;
+  if (laszip_open_reader(laszip, file_name, &is_compressed)) return fail(laszip, "open_reader");
+  laszip_header_struct* header;
+  laszip_get_header_pointer(laszip, &header);
+  if (header->point_data_format != point_type)
+  {
+    fprintf(stderr, "point type %d: file is read as point type %d\n", point_type, header->point_data_format);
+    return 1;
+  }
+  laszip_point_struct* point;
+  laszip_get_point_pointer(laszip, &point);
+  // in compatibility mode the extra bytes also hold those of the extended fields
+  const laszip_U32 num_extra_bytes = (laszip_U32)point->num_extra_bytes;
+  if (num_extra_bytes < NUM_EXTRA_BYTES)
+  {
+    fprintf(stderr, "point type %d: point has %u instead of %u extra bytes\n", point_type, num_extra_bytes, NUM_EXTRA_BYTES);
+    return 1;
+  }
+  std::vector<laszip_point_struct> points(NUM_POINTS);
+  std::vector<laszip_U8> extra_bytes(NUM_POINTS*num_extra_bytes);
+  laszip_U32 i;
+  for (i = 0; i < NUM_POINTS; i++)
+  {
+    if (laszip_read_point(laszip)) return fail(laszip, "read_point");
+    points[i] = *point;
+    memcpy(&extra_bytes[i*num_extra_bytes], point->extra_bytes, num_extra_bytes);
+  }
+  laszip_close_reader(laszip);
+  laszip_destroy(laszip);
+
+  // in batches of columns
+
+  std::vector<laszip_I32> X(NUM_POINTS), Y(NUM_POINTS), Z(NUM_POINTS);
+  std::vector<laszip_F64> x(NUM_POINTS), y(NUM_POINTS), z(NUM_POINTS), gps_time(NUM_POINTS);
+  std::vector<laszip_U16> intensity(NUM_POINTS), point_source_ID(NUM_POINTS), R(NUM_POINTS), G(NUM_POINTS), B(NUM_POINTS), NIR(NUM_POINTS);
+  std::vector<laszip_U8> return_number(NUM_POINTS), number_of_returns(NUM_POINTS), classification(NUM_POINTS), user_data(NUM_POINTS);
+  std::vector<laszip_I16> scan_angle(NUM_POINTS);
+  std::vector<laszip_U8> column_extra_bytes(NUM_POINTS*num_extra_bytes);
+
+  if (laszip_create(&laszip)) return 1;
+  if (compatible && laszip_request_compatibility_mode(laszip, 1)) return fail(laszip, "request_compatibility_mode");
+  if (laszip_open_reader(laszip, file_name, &is_compressed)) return fail(laszip, "open_reader");
+  laszip_get_header_pointer(laszip, &header);
+  laszip_U32 read, total = 0;
+  do
+  {
+    laszip_columns_struct columns;
+    memset(&columns, 0, sizeof(columns));
+    if (total < NUM_POINTS)
+    {
+      columns.X = &X[total];
+      columns.Y = &Y[total];
+      columns.Z = &Z[total];
+      columns.x = &x[total];
+      columns.y = &y[total];
+      columns.z = &z[total];
+      columns.intensity = &intensity[total];
+      columns.return_number = &return_number[total];
+      columns.number_of_returns = &number_of_returns[total];
+      columns.classification = &classification[total];
+      columns.scan_angle = &scan_angle[total];
+      columns.user_data = &user_data[total];
+      columns.point_source_ID = &point_source_ID[total];
+      columns.gps_time = &gps_time[total];
+      columns.R = &R[total];
+      columns.G = &G[total];
+      columns.B = &B[total];
+      columns.NIR = &NIR[total];
+      columns.extra_bytes = &column_extra_bytes[total*num_extra_bytes];
+    }
+    if (laszip_read_columns(laszip, (NUM_POINTS - total < BATCH_SIZE ? NUM_POINTS - total : BATCH_SIZE), &columns, &read)) return fail(laszip, "read_columns");
+    total += read;
+  } while (read);
+  if (total != NUM_POINTS)
+  {
+    fprintf(stderr, "point type %d: columns have %u instead of %u points\n", point_type, total, NUM_POINTS);
+    return 1;
+  }
+
+  int errors = 0;
+  for (i = 0; i < NUM_POINTS; i++)
+  {
+    const laszip_point_struct* p = &points[i];
+    int same = ((X[i] == p->X) && (Y[i] == p->Y) && (Z[i] == p->Z));
+    same = same && (x[i] == header->x_scale_factor*p->X+header->x_offset) && (y[i] == header->y_scale_factor*p->Y+header->y_offset) && (z[i] == header->z_scale_factor*p->Z+header->z_offset);
+    same = same && (intensity[i] == p->intensity) && (user_data[i] == p->user_data) && (point_source_ID[i] == p->point_source_ID) && (gps_time[i] == p->gps_time);
+    same = same && (R[i] == p->rgb[0]) && (G[i] == p->rgb[1]) && (B[i] == p->rgb[2]) && (NIR[i] == p->rgb[3]);
+    if (point_type >= 6)
+    {
+      same = same && (return_number[i] == p->extended_return_number) && (number_of_returns[i] == p->extended_number_of_returns) && (classification[i] == p->extended_classification) && (scan_angle[i] == p->extended_scan_angle);
+    }
+    else
+    {
+      same = same && (return_number[i] == p->return_number) && (number_of_returns[i] == p->number_of_returns) && (classification[i] == p->classification) && (scan_angle[i] == p->scan_angle_rank);
+    }
+    same = same && (memcmp(&column_extra_bytes[i*num_extra_bytes], &extra_bytes[i*num_extra_bytes], num_extra_bytes) == 0);
+    if (!same)
+    {
+      if (errors++ < 5) fprintf(stderr, "point type %d%s: point %u differs in the columns\n", point_type, (compatible ? " (compatibility mode)" : ""), i);
+    }
+  }
+  laszip_close_reader(laszip);
+  laszip_destroy(laszip);
+  return (errors ? 1 : 0);
+}
+
+int main(int argc, char* argv[])
+{
+  const char* file_name = (argc > 1 ? argv[1] : "laszip_test_read_columns.laz");
+  static const laszip_U8 point_types[] = { 1, 3, 6, 8 };
+  int errors = 0;
+  laszip_U32 t;
+  for (t = 0; t < sizeof(point_types)/sizeof(point_types[0]); t++)
+  {
+    errors += test_read_columns(file_name, point_types[t], 0);
+  }
+  errors += test_read_columns(file_name, 6, 1);
+  remove(file_name);
+  if (errors)
+  {
+    fprintf(stderr, "FAILED for %d point type(s)\n", errors);
+    return 1;
+  }
+  fprintf(stderr, "all columns are identical to single points\n");
+  return 0;
+}
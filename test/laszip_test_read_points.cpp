@@ -0,0 +1,302 @@
+/*
+===============================================================================
+
+  FILE:  laszip_test_read_points.cpp
+
+  CONTENTS:
+
+    Regression test for reading many points with one call. It writes the
+    point types 1, 3, 6, and 8 with two extra bytes compressed and
+    uncompressed, and reads the compressed file point by point with
+    'laszip_read_point()' and in batches (that do not add up to a chunk)
+    with 'laszip_read_points()' and 'laszip_read_packed_points()'. Every
+    point of a batch must be identical, byte for byte, to the point read
+    alone, its extra bytes must be copied where the caller asked for them,
+    and every packed record must be identical to the record stored in the
+    uncompressed file. Reading past the last point must read nothing.
+
+    usage:
+
+      laszip_test_read_points [file.laz]
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- created to compare batch reads with reading point by point
+
+===============================================================================
+*/
+
+#include "laszip_api.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#include <vector>
+
+static const laszip_U32 NUM_POINTS = 20000;
+static const laszip_U32 CHUNK_SIZE = 3000;
+static const laszip_U32 BATCH_SIZE = 777;
+static const laszip_U32 NUM_EXTRA_BYTES = 2;
+
+static void make_point(laszip_point_struct* point, const laszip_U8 point_type, const laszip_U32 i)
+{
+  point->X = (laszip_I32)(i*3 + (i*7919)%50);
+  point->Y = (laszip_I32)(i*2 - (i*104729)%70);
+  point->Z = (laszip_I32)((i*31)%1000 + i/10);
+  point->intensity = (laszip_U16)((i*13)%4000);
+  point->user_data = (laszip_U8)((i/100)%7);
+  point->point_source_ID = (laszip_U16)(i/5000);
+  point->gps_time = 1000.0 + i*0.00001*(1 + (i/777)%3);
+  point->scan_direction_flag = (i/40)%2;
+  point->edge_of_flight_line = (i%40) == 0;
+  point->synthetic_flag = (i%8) & 1;
+  point->keypoint_flag = ((i%8) >> 1) & 1;
+  point->withheld_flag = ((i%8) >> 2) & 1;
+  if (point_type < 6)
+  {
+    point->number_of_returns = 1 + (i%5);
+    point->return_number = 1 + (i/5)%point->number_of_returns;
+    point->classification = (laszip_U8)(i%12);
+    point->scan_angle_rank = (laszip_I8)((laszip_I32)((i*17)%180) - 90);
+  }
+  else
+  {
+    point->extended_point_type = 1;
+    point->extended_scanner_channel = (i/300)%4;
+    point->extended_number_of_returns = 1 + (i%5);
+    point->extended_return_number = 1 + (i/5)%point->extended_number_of_returns;
+    point->extended_classification = (laszip_U8)((i/50)%3 == 0 ? 40 + (i%10) : (i%12));
+    point->extended_classification_flags = (i%8);
+    point->extended_scan_angle = (laszip_I16)((laszip_I32)((i*17)%6000) - 3000);
+  }
+  if ((point_type == 3) || (point_type == 7) || (point_type == 8))
+  {
+    point->rgb[0] = (laszip_U16)((i*257)%65536);
+    point->rgb[1] = (laszip_U16)(point->rgb[0]/3);
+    point->rgb[2] = (laszip_U16)(i%256);
+  }
+  if (point_type == 8)
+  {
+    point->rgb[3] = (laszip_U16)(i%1000);
+  }
+}
+
+static int fail(laszip_POINTER laszip, const char* what)
+{
+  laszip_CHAR* error;
+  laszip_get_error(laszip, &error);
+  fprintf(stderr, "%s: %s\n", what, (error ? error : "no error message"));
+  return 1;
+}
+
+static int write_file(const char* file_name, const laszip_U8 point_type, const laszip_BOOL compress)
+{
+  laszip_POINTER laszip;
+  if (laszip_create(&laszip)) return 1;
+  laszip_header_struct* header;
+  laszip_get_header_pointer(laszip, &header);
+  header->version_major = 1;
+  header->point_data_format = point_type;
+  if (point_type < 6)
+  {
+    header->version_minor = 2;
+    header->header_size = 227;
+    header->offset_to_point_data = 227;
+    header->point_data_record_length = (point_type == 1 ? 28 : 34) + NUM_EXTRA_BYTES;
+    header->number_of_point_records = NUM_POINTS;
+  }
+  else
+  {
+    header->version_minor = 4;
+    header->header_size = 375;
+    header->offset_to_point_data = 375;
+    header->point_data_record_length = (point_type == 6 ? 30 : 38) + NUM_EXTRA_BYTES;
+    header->extended_number_of_point_records = NUM_POINTS;
+  }
+  header->x_scale_factor = header->y_scale_factor = header->z_scale_factor = 0.01;
+  if (laszip_add_attribute(laszip, 2, "u16", "u16", 1.0, 0.0)) return fail(laszip, "add_attribute");
+  if ((point_type >= 6) && laszip_request_native_extension(laszip, 1)) return fail(laszip, "request_native_extension");
+  if (laszip_set_chunk_size(laszip, CHUNK_SIZE)) return fail(laszip, "set_chunk_size");
+  if (laszip_open_writer(laszip, file_name, compress)) return fail(laszip, "open_writer");
+  laszip_point_struct* point;
+  laszip_get_point_pointer(laszip, &point);
+  laszip_U32 i;
+  for (i = 0; i < NUM_POINTS; i++)
+  {
+    make_point(point, point_type, i);
+    point->extra_bytes[0] = (laszip_U8)(i%251);
+    point->extra_bytes[1] = (laszip_U8)(i/251);
+    if (laszip_write_point(laszip)) return fail(laszip, "write_point");
+  }
+  if (laszip_close_writer(laszip)) return fail(laszip, "close_writer");
+  laszip_destroy(laszip);
+  return 0;
+}
+
+// the point records as stored in an uncompressed file
+
+static int load_records(const char* file_name, std::vector<laszip_U8>& records)
+{
+  laszip_POINTER laszip;
+  if (laszip_create(&laszip)) return 1;
+  laszip_BOOL is_compressed;
+  if (laszip_open_reader(laszip, file_name, &is_compressed)) return fail(laszip, "open_reader");
+  laszip_header_struct* header;
+  laszip_get_header_pointer(laszip, &header);
+  laszip_U32 offset = header->offset_to_point_data;
+  records.resize((size_t)NUM_POINTS*header->point_data_record_length);
+  laszip_close_reader(laszip);
+  laszip_destroy(laszip);
+
+  FILE* file = fopen(file_name, "rb");
+  if (file == 0)
+  {
+    fprintf(stderr, "cannot open '%s'\n", file_name);
+    return 1;
+  }
+  if ((fseek(file, offset, SEEK_SET) != 0) || (fread(&records[0], 1, records.size(), file) != records.size()))
+  {
+    fprintf(stderr, "cannot read %u point records from '%s'\n", NUM_POINTS, file_name);
+    fclose(file);
+    return 1;
+  }
+  fclose(file);
+  return 0;
+}
+
+static int same_point(const laszip_point_struct* a, const laszip_point_struct* b)
+{
+  // every field up to the extra bytes, also those that the point type does not
+  // have, but not the 'dummy' bytes that the reader uses for itself
+  if (memcmp(a, b, offsetof(laszip_point_struct, dummy))) return 0;
+  return (memcmp(&a->gps_time, &b->gps_time, offsetof(laszip_point_struct, num_extra_bytes) - offsetof(laszip_point_struct, gps_time)) == 0);
+}
+
+static int test_read_points(const char* file_name, const laszip_U8 point_type)
+{
+  std::vector<laszip_U8> records;
+  if (write_file(file_name, point_type, 0)) return 1;
+  if (load_records(file_name, records)) return 1;
+  if (write_file(file_name, point_type, 1)) return 1;
+
+  // point by point
+
+  laszip_POINTER laszip;
+  if (laszip_create(&laszip)) return 1;
+  laszip_BOOL is_compressed;
+  if (laszip_open_reader(laszip, file_name, &is_compressed)) return fail(laszip, "open_reader");
+  laszip_point_struct* point;
+  laszip_get_point_pointer(laszip, &point);
+  std::vector<laszip_point_struct> points(NUM_POINTS);
+  std::vector<laszip_U8> extra_bytes(NUM_POINTS*NUM_EXTRA_BYTES);
+  laszip_U32 i;
+  for (i = 0; i < NUM_POINTS; i++)
+  {
+    if (laszip_read_point(laszip)) return fail(laszip, "read_point");
+    points[i] = *point;
+    memcpy(&extra_bytes[i*NUM_EXTRA_BYTES], point->extra_bytes, NUM_EXTRA_BYTES);
+  }
+  laszip_close_reader(laszip);
+  laszip_destroy(laszip);
+
+  // in batches of points. only every other point gets its extra bytes
+
+  int errors = 0;
+  std::vector<laszip_point_struct> batch(BATCH_SIZE);
+  std::vector<laszip_U8> batch_extra_bytes(BATCH_SIZE*NUM_EXTRA_BYTES);
+  laszip_U32 read, total = 0;
+  if (laszip_create(&laszip)) return 1;
+  if (laszip_open_reader(laszip, file_name, &is_compressed)) return fail(laszip, "open_reader");
+  do
+  {
+    memset(&batch[0], 0, BATCH_SIZE*sizeof(laszip_point_struct));
+    memset(&batch_extra_bytes[0], 0xFF, BATCH_SIZE*NUM_EXTRA_BYTES);
+    for (i = 0; i < BATCH_SIZE; i += 2)
+    {
+      batch[i].extra_bytes = &batch_extra_bytes[i*NUM_EXTRA_BYTES];
+    }
+    if (laszip_read_points(laszip, BATCH_SIZE, &batch[0], &read)) return fail(laszip, "read_points");
+    for (i = 0; (i < read) && (total + i < NUM_POINTS); i++)
+    {
+      const laszip_U8* expected = ((i%2) == 0 ? &extra_bytes[(total+i)*NUM_EXTRA_BYTES] : 0);
+      if (!same_point(&batch[i], &points[total+i]) || (batch[i].extra_bytes != ((i%2) == 0 ? &batch_extra_bytes[i*NUM_EXTRA_BYTES] : 0)) || (expected && memcmp(batch[i].extra_bytes, expected, NUM_EXTRA_BYTES)))
+      {
+        if (errors++ < 5) fprintf(stderr, "point type %d: point %u of a batch differs\n", point_type, total+i);
+      }
+    }
+    total += read;
+  } while (read);
+  laszip_close_reader(laszip);
+  laszip_destroy(laszip);
+  if (total != NUM_POINTS)
+  {
+    fprintf(stderr, "point type %d: batches read %u instead of %u points\n", point_type, total, NUM_POINTS);
+    errors++;
+  }
+
+  // in batches of packed records
+
+  const laszip_U32 record_length = (laszip_U32)(records.size()/NUM_POINTS);
+  std::vector<laszip_U8> packed(BATCH_SIZE*record_length);
+  total = 0;
+  if (laszip_create(&laszip)) return 1;
+  if (laszip_open_reader(laszip, file_name, &is_compressed)) return fail(laszip, "open_reader");
+  do
+  {
+    if (laszip_read_packed_points(laszip, BATCH_SIZE, &packed[0], &read)) return fail(laszip, "read_packed_points");
+    for (i = 0; (i < read) && (total + i < NUM_POINTS); i++)
+    {
+      if (memcmp(&packed[i*record_length], &records[(size_t)(total+i)*record_length], record_length))
+      {
+        if (errors++ < 5) fprintf(stderr, "point type %d: packed record %u differs\n", point_type, total+i);
+      }
+    }
+    total += read;
+  } while (read);
+  laszip_close_reader(laszip);
+  laszip_destroy(laszip);
+  if (total != NUM_POINTS)
+  {
+    fprintf(stderr, "point type %d: batches read %u instead of %u packed records\n", point_type, total, NUM_POINTS);
+    errors++;
+  }
+
+  return (errors ? 1 : 0);
+}
+
+int main(int argc, char* argv[])
+{
+  const char* file_name = (argc > 1 ? argv[1] : "laszip_test_read_points.laz");
+  static const laszip_U8 point_types[] = { 1, 3, 6, 8 };
+  int errors = 0;
+  laszip_U32 t;
+  for (t = 0; t < sizeof(point_types)/sizeof(point_types[0]); t++)
+  {
+    errors += test_read_points(file_name, point_types[t]);
+  }
+  remove(file_name);
+  if (errors)
+  {
+    fprintf(stderr, "FAILED for %d point type(s)\n", errors);
+    return 1;
+  }
+  fprintf(stderr, "batches of points and records are identical to single points\n");
+  return 0;
+}
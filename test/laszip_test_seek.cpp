@@ -0,0 +1,187 @@
+/*
+===============================================================================
+
+  FILE:  laszip_test_seek.cpp
+
+  CONTENTS:
+
+    Regression test for seeking in compressed LAS 1.4 points. It writes the
+    point types 6, 7, and 8, reads each file from start to end, and then
+    seeks to points at the start, inside, and at the end of chunks. Every
+    point read after a seek must be identical, byte for byte and including
+    the fields that its point type does not have, to the point read from
+    start to end. A seek used to start from a point that was not zeroed,
+    which put heap garbage into the RGB and NIR fields of the points of
+    the chunk that the seek went into.
+
+    usage:
+
+      laszip_test_seek [file.laz]
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- created to catch garbage in points read after a seek
+
+===============================================================================
+*/
+
+#include "laszip_api.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#include <vector>
+
+static const laszip_U32 NUM_POINTS = 20000;
+static const laszip_U32 CHUNK_SIZE = 3000;
+
+static void make_point(laszip_point_struct* point, const laszip_U32 i)
+{
+  point->X = (laszip_I32)(i*3 + (i*7919)%50);
+  point->Y = (laszip_I32)(i*2 - (i*104729)%70);
+  point->Z = (laszip_I32)((i*31)%1000 + i/10);
+  point->intensity = (laszip_U16)((i*13)%4000);
+  point->user_data = (laszip_U8)((i/100)%7);
+  point->point_source_ID = (laszip_U16)(i/5000);
+  point->gps_time = 1000.0 + i*0.00001*(1 + (i/777)%3);
+  point->extended_point_type = 1;
+  point->extended_scanner_channel = (i/300)%4;
+  point->extended_number_of_returns = 1 + (i%5);
+  point->extended_return_number = 1 + (i/5)%point->extended_number_of_returns;
+  point->extended_classification = (laszip_U8)((i/50)%3 == 0 ? 40 + (i%10) : (i%12));
+  point->extended_classification_flags = (i%8);
+  point->synthetic_flag = (i%8) & 1;
+  point->keypoint_flag = ((i%8) >> 1) & 1;
+  point->withheld_flag = ((i%8) >> 2) & 1;
+  point->extended_scan_angle = (laszip_I16)((laszip_I32)((i*17)%6000) - 3000);
+  point->scan_direction_flag = (i/40)%2;
+  point->edge_of_flight_line = (i%40) == 0;
+  point->rgb[0] = (laszip_U16)((i*257)%65536);
+  point->rgb[1] = (laszip_U16)(point->rgb[0]/3);
+  point->rgb[2] = (laszip_U16)(i%256);
+  point->rgb[3] = (laszip_U16)(i%1000);
+}
+
+static int fail(laszip_POINTER laszip, const char* what)
+{
+  laszip_CHAR* error;
+  laszip_get_error(laszip, &error);
+  fprintf(stderr, "%s: %s\n", what, (error ? error : "no error message"));
+  return 1;
+}
+
+static int write_file(const char* file_name, const laszip_U8 point_type)
+{
+  static const laszip_U16 record_lengths[] = { 30, 36, 38 };
+  laszip_POINTER laszip;
+  if (laszip_create(&laszip)) return 1;
+  laszip_header_struct* header;
+  laszip_get_header_pointer(laszip, &header);
+  header->version_major = 1;
+  header->version_minor = 4;
+  header->header_size = 375;
+  header->offset_to_point_data = 375;
+  header->point_data_format = point_type;
+  header->point_data_record_length = record_lengths[point_type - 6];
+  header->extended_number_of_point_records = NUM_POINTS;
+  header->x_scale_factor = header->y_scale_factor = header->z_scale_factor = 0.01;
+  if (laszip_request_native_extension(laszip, 1)) return fail(laszip, "request_native_extension");
+  if (laszip_set_chunk_size(laszip, CHUNK_SIZE)) return fail(laszip, "set_chunk_size");
+  if (laszip_open_writer(laszip, file_name, 1)) return fail(laszip, "open_writer");
+  laszip_point_struct* point;
+  laszip_get_point_pointer(laszip, &point);
+  laszip_U32 i;
+  for (i = 0; i < NUM_POINTS; i++)
+  {
+    make_point(point, i);
+    if (point_type == 6) memset(point->rgb, 0, sizeof(point->rgb));
+    else if (point_type == 7) point->rgb[3] = 0;
+    if (laszip_write_point(laszip)) return fail(laszip, "write_point");
+  }
+  if (laszip_close_writer(laszip)) return fail(laszip, "close_writer");
+  laszip_destroy(laszip);
+  return 0;
+}
+
+static int same_point(const laszip_point_struct* a, const laszip_point_struct* b)
+{
+  // every field up to the extra bytes, also those that the point type does not
+  // have, but not the 'dummy' bytes that the reader uses for itself
+  if (memcmp(a, b, offsetof(laszip_point_struct, dummy))) return 0;
+  return (memcmp(&a->gps_time, &b->gps_time, offsetof(laszip_point_struct, num_extra_bytes) - offsetof(laszip_point_struct, gps_time)) == 0);
+}
+
+static int test_seeks(const char* file_name, const laszip_U8 point_type)
+{
+  laszip_POINTER laszip;
+  if (laszip_create(&laszip)) return 1;
+  laszip_BOOL is_compressed;
+  if (laszip_open_reader(laszip, file_name, &is_compressed)) return fail(laszip, "open_reader");
+  laszip_point_struct* point;
+  laszip_get_point_pointer(laszip, &point);
+
+  std::vector<laszip_point_struct> points(NUM_POINTS);
+  laszip_U32 i;
+  for (i = 0; i < NUM_POINTS; i++)
+  {
+    if (laszip_read_point(laszip)) return fail(laszip, "read_point");
+    points[i] = *point;
+  }
+
+  static const laszip_U32 targets[] = { 0, 1, CHUNK_SIZE - 1, CHUNK_SIZE, CHUNK_SIZE + 1, 5*CHUNK_SIZE + 123, 2*CHUNK_SIZE, NUM_POINTS - 300, NUM_POINTS - 1, 7 };
+  int errors = 0;
+  laszip_U32 t;
+  for (t = 0; t < sizeof(targets)/sizeof(targets[0]); t++)
+  {
+    if (laszip_seek_point(laszip, targets[t])) return fail(laszip, "seek_point");
+    for (i = targets[t]; (i < targets[t] + 200) && (i < NUM_POINTS); i++)
+    {
+      if (laszip_read_point(laszip)) return fail(laszip, "read_point after seek");
+      if (!same_point(point, &points[i]))
+      {
+        if (errors++ < 5) fprintf(stderr, "point type %d: point %u read after a seek to %u differs\n", point_type, i, targets[t]);
+      }
+    }
+  }
+
+  laszip_close_reader(laszip);
+  laszip_destroy(laszip);
+  return (errors ? 1 : 0);
+}
+
+int main(int argc, char* argv[])
+{
+  const char* file_name = (argc > 1 ? argv[1] : "laszip_test_seek.laz");
+  int errors = 0;
+  laszip_U8 point_type;
+  for (point_type = 6; point_type <= 8; point_type++)
+  {
+    if (write_file(file_name, point_type)) return 1;
+    errors += test_seeks(file_name, point_type);
+  }
+  remove(file_name);
+  if (errors)
+  {
+    fprintf(stderr, "FAILED for %d point type(s)\n", errors);
+    return 1;
+  }
+  fprintf(stderr, "all points read after seeks are identical\n");
+  return 0;
+}
@@ -0,0 +1,245 @@
+/*
+===============================================================================
+
+  FILE:  laszip_test_threads.cpp
+
+  CONTENTS:
+
+    Regression test for compressing and decompressing chunks in parallel.
+    It writes the point types 1, 3, 6, 7, and 8 once without threads and
+    once with 'laszip_set_number_of_threads()', and the two files must be
+    identical byte for byte. It then reads the file with and without
+    threads, and every point read with threads must be identical, byte for
+    byte, to the point read without. On a machine with fewer cores than the
+    requested threads fewer of them are used.
+
+    usage:
+
+      laszip_test_threads [file.laz]
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2022, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- created to check that threads do not change the output
+
+===============================================================================
+*/
+
+#include "laszip_api.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#include <vector>
+
+static const laszip_U32 NUM_POINTS = 20000;
+static const laszip_U32 CHUNK_SIZE = 3000;
+static const laszip_U32 NUM_THREADS = 4;
+
+static void make_point(laszip_point_struct* point, const laszip_U8 point_type, const laszip_U32 i)
+{
+  point->X = (laszip_I32)(i*3 + (i*7919)%50);
+  point->Y = (laszip_I32)(i*2 - (i*104729)%70);
+  point->Z = (laszip_I32)((i*31)%1000 + i/10);
+  point->intensity = (laszip_U16)((i*13)%4000);
+  point->user_data = (laszip_U8)((i/100)%7);
+  point->point_source_ID = (laszip_U16)(i/5000);
+  point->gps_time = 1000.0 + i*0.00001*(1 + (i/777)%3);
+  point->scan_direction_flag = (i/40)%2;
+  point->edge_of_flight_line = (i%40) == 0;
+  point->synthetic_flag = (i%8) & 1;
+  point->keypoint_flag = ((i%8) >> 1) & 1;
+  point->withheld_flag = ((i%8) >> 2) & 1;
+  if (point_type < 6)
+  {
+    point->number_of_returns = 1 + (i%5);
+    point->return_number = 1 + (i/5)%point->number_of_returns;
+    point->classification = (laszip_U8)(i%12);
+    point->scan_angle_rank = (laszip_I8)((laszip_I32)((i*17)%180) - 90);
+  }
+  else
+  {
+    point->extended_point_type = 1;
+    point->extended_scanner_channel = (i/300)%4;
+    point->extended_number_of_returns = 1 + (i%5);
+    point->extended_return_number = 1 + (i/5)%point->extended_number_of_returns;
+    point->extended_classification = (laszip_U8)((i/50)%3 == 0 ? 40 + (i%10) : (i%12));
+    point->extended_classification_flags = (i%8);
+    point->extended_scan_angle = (laszip_I16)((laszip_I32)((i*17)%6000) - 3000);
+  }
+  if ((point_type == 3) || (point_type == 7) || (point_type == 8))
+  {
+    point->rgb[0] = (laszip_U16)((i*257)%65536);
+    point->rgb[1] = (laszip_U16)(point->rgb[0]/3);
+    point->rgb[2] = (laszip_U16)(i%256);
+  }
+  if (point_type == 8)
+  {
+    point->rgb[3] = (laszip_U16)(i%1000);
+  }
+}
+
+static int fail(laszip_POINTER laszip, const char* what)
+{
+  laszip_CHAR* error;
+  laszip_get_error(laszip, &error);
+  fprintf(stderr, "%s: %s\n", what, (error ? error : "no error message"));
+  return 1;
+}
+
+static int write_file(const char* file_name, const laszip_U8 point_type, const laszip_U32 num_threads)
+{
+  laszip_POINTER laszip;
+  if (laszip_create(&laszip)) return 1;
+  laszip_header_struct* header;
+  laszip_get_header_pointer(laszip, &header);
+  header->version_major = 1;
+  header->point_data_format = point_type;
+  if (point_type < 6)
+  {
+    header->version_minor = 2;
+    header->header_size = 227;
+    header->offset_to_point_data = 227;
+    header->point_data_record_length = (point_type == 1 ? 28 : 34);
+    header->number_of_point_records = NUM_POINTS;
+  }
+  else
+  {
+    header->version_minor = 4;
+    header->header_size = 375;
+    header->offset_to_point_data = 375;
+    header->point_data_record_length = (point_type == 6 ? 30 : (point_type == 7 ? 36 : 38));
+    header->extended_number_of_point_records = NUM_POINTS;
+  }
+  header->x_scale_factor = header->y_scale_factor = header->z_scale_factor = 0.01;
+  if ((point_type >= 6) && laszip_request_native_extension(laszip, 1)) return fail(laszip, "request_native_extension");
+  if (laszip_set_chunk_size(laszip, CHUNK_SIZE)) return fail(laszip, "set_chunk_size");
+  if (laszip_set_number_of_threads(laszip, num_threads)) return fail(laszip, "set_number_of_threads");
+  if (laszip_open_writer(laszip, file_name, 1)) return fail(laszip, "open_writer");
+  laszip_point_struct* point;
+  laszip_get_point_pointer(laszip, &point);
+  laszip_U32 i;
+  for (i = 0; i < NUM_POINTS; i++)
+  {
+    make_point(point, point_type, i);
+    if (laszip_write_point(laszip)) return fail(laszip, "write_point");
+  }
+  if (laszip_close_writer(laszip)) return fail(laszip, "close_writer");
+  laszip_destroy(laszip);
+  return 0;
+}
+
+static int load_file(const char* file_name, std::vector<char>& bytes)
+{
+  FILE* file = fopen(file_name, "rb");
+  if (file == 0)
+  {
+    fprintf(stderr, "cannot open '%s'\n", file_name);
+    return 1;
+  }
+  bytes.clear();
+  char buffer[4096];
+  size_t size;
+  while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0)
+  {
+    bytes.insert(bytes.end(), buffer, buffer + size);
+  }
+  fclose(file);
+  return 0;
+}
+
+static int read_file(const char* file_name, const laszip_U32 num_threads, std::vector<laszip_point_struct>& points)
+{
+  laszip_POINTER laszip;
+  if (laszip_create(&laszip)) return 1;
+  if (laszip_set_number_of_threads(laszip, num_threads)) return fail(laszip, "set_number_of_threads");
+  laszip_BOOL is_compressed;
+  if (laszip_open_reader(laszip, file_name, &is_compressed)) return fail(laszip, "open_reader");
+  laszip_point_struct* point;
+  laszip_get_point_pointer(laszip, &point);
+  points.resize(NUM_POINTS);
+  laszip_U32 i;
+  for (i = 0; i < NUM_POINTS; i++)
+  {
+    if (laszip_read_point(laszip)) return fail(laszip, "read_point");
+    points[i] = *point;
+  }
+  laszip_close_reader(laszip);
+  laszip_destroy(laszip);
+  return 0;
+}
+
+static int same_point(const laszip_point_struct* a, const laszip_point_struct* b)
+{
+  // every field up to the extra bytes, also those that the point type does not
+  // have, but not the 'dummy' bytes that the reader uses for itself
+  if (memcmp(a, b, offsetof(laszip_point_struct, dummy))) return 0;
+  return (memcmp(&a->gps_time, &b->gps_time, offsetof(laszip_point_struct, num_extra_bytes) - offsetof(laszip_point_struct, gps_time)) == 0);
+}
+
+static int test_threads(const char* file_name, const laszip_U8 point_type)
+{
+  std::vector<char> sequential_bytes;
+  std::vector<char> threaded_bytes;
+  if (write_file(file_name, point_type, 0)) return 1;
+  if (load_file(file_name, sequential_bytes)) return 1;
+  if (write_file(file_name, point_type, NUM_THREADS)) return 1;
+  if (load_file(file_name, threaded_bytes)) return 1;
+  if (sequential_bytes != threaded_bytes)
+  {
+    fprintf(stderr, "point type %d: file written with %u threads differs (%u instead of %u bytes)\n", point_type, NUM_THREADS, (laszip_U32)threaded_bytes.size(), (laszip_U32)sequential_bytes.size());
+    return 1;
+  }
+
+  std::vector<laszip_point_struct> sequential;
+  std::vector<laszip_point_struct> threaded;
+  if (read_file(file_name, 0, sequential)) return 1;
+  if (read_file(file_name, NUM_THREADS, threaded)) return 1;
+
+  int errors = 0;
+  laszip_U32 i;
+  for (i = 0; i < NUM_POINTS; i++)
+  {
+    if (!same_point(&sequential[i], &threaded[i]))
+    {
+      if (errors++ < 5) fprintf(stderr, "point type %d: point %u read with %u threads differs\n", point_type, i, NUM_THREADS);
+    }
+  }
+  return (errors ? 1 : 0);
+}
+
+int main(int argc, char* argv[])
+{
+  const char* file_name = (argc > 1 ? argv[1] : "laszip_test_threads.laz");
+  static const laszip_U8 point_types[] = { 1, 3, 6, 7, 8 };
+  int errors = 0;
+  laszip_U32 t;
+  for (t = 0; t < sizeof(point_types)/sizeof(point_types[0]); t++)
+  {
+    errors += test_threads(file_name, point_types[t]);
+  }
+  remove(file_name);
+  if (errors)
+  {
+    fprintf(stderr, "FAILED for %d point type(s)\n", errors);
+    return 1;
+  }
+  fprintf(stderr, "threads write identical files and read identical points\n");
+  return 0;
+}